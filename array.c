@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "trace.h"
 
 #define MAX_CONTACTS 1000
 #define NAME_LEN 50
@@ -14,12 +15,36 @@ typedef struct {
     char email[EMAIL_LEN];
 } Contact;
 
-// Global array to store contacts
+// Global array to store contacts. Deleted contacts leave a tombstone
+// (dead[i] = 1) instead of shifting the rest down; every scan skips dead
+// slots, and once a quarter of the used slots are dead the array is
+// compacted in one order-preserving pass.
 Contact contacts[MAX_CONTACTS];
-int contactCount = 0;
+unsigned char dead[MAX_CONTACTS];
+int contactCount = 0;   // used slots, dead ones included
+int deadCount = 0;
+#define DEAD_RATIO 4    // compact when more than 1/DEAD_RATIO of the used slots are dead
+
+// Squeeze out the dead slots, keeping the order of the live ones
+void compactContacts() {
+    int j = 0;
+    for (int i = 0; i < contactCount; i++) {
+        if (dead[i]) continue;
+        if (i != j) contacts[j] = contacts[i];
+        dead[j++] = 0;
+    }
+    contactCount = j;
+    deadCount = 0;
+}
 
 // Function to insert a contact
 void insertContact(char *name, char *phone, char *email) {
+    if (contactCount == MAX_CONTACTS) compactContacts();
+    if (contactCount == MAX_CONTACTS) {
+        printf("Contact list is full.\n");
+        return;
+    }
+    dead[contactCount] = 0;
     strcpy(contacts[contactCount].name, name);
     strcpy(contacts[contactCount].phone, phone);
     strcpy(contacts[contactCount].email, email);
@@ -30,7 +55,7 @@ void insertContact(char *name, char *phone, char *email) {
 // Function to search for a contact by name
 int searchContact(char *name) {
     for (int i = 0; i < contactCount; i++) {
-        if (strcmp(contacts[i].name, name) == 0) {
+        if (!dead[i] && strcmp(contacts[i].name, name) == 0) {
             return i;
         }
     }
@@ -49,17 +74,49 @@ void updateContact(char *name, char *newPhone, char *newEmail) {
     printf("Contact updated: %s\n", name);
 }
 
-// Function to delete a contact
+// Function to find a contact or append it, in one scan; returns its index (-1 if full)
+int insertIfAbsent(char *name, char *phone, char *email) {
+    for (int i = 0; i < contactCount; i++) {
+        if (!dead[i] && strcmp(contacts[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (contactCount == MAX_CONTACTS) compactContacts();
+    if (contactCount == MAX_CONTACTS) {
+        printf("Contact list is full.\n");
+        return -1;
+    }
+    strcpy(contacts[contactCount].name, name);
+    strcpy(contacts[contactCount].phone, phone);
+    strcpy(contacts[contactCount].email, email);
+    dead[contactCount] = 0;
+    return contactCount++;
+}
+
+// Function to insert a contact or overwrite an existing one, in one scan
+int upsertContact(char *name, char *phone, char *email) {
+    int index = insertIfAbsent(name, phone, email);
+    if (index == -1) return -1;
+    strcpy(contacts[index].phone, phone);
+    strcpy(contacts[index].email, email);
+    printf("Contact saved: %s\n", name);
+    return index;
+}
+
+// Function to delete a contact: O(1) after the search, by tombstone
 void deleteContact(char *name) {
     int index = searchContact(name);
     if (index == -1) {
         printf("Contact not found.\n");
         return;
     }
-    for (int i = index; i < contactCount - 1; i++) {
-        contacts[i] = contacts[i + 1];
+    dead[index] = 1;
+    deadCount++;
+    while (contactCount > 0 && dead[contactCount - 1]) {   // trailing tombstones are just dropped
+        contactCount--;
+        deadCount--;
     }
-    contactCount--;
+    if (deadCount * DEAD_RATIO > contactCount) compactContacts();
     printf("Contact deleted: %s\n", name);
 }
 
@@ -67,10 +124,11 @@ void deleteContact(char *name) {
 void displayContacts() {
     printf("\n--- Contact List ---\n");
     for (int i = 0; i < contactCount; i++) {
+        if (dead[i]) continue;
         printf("Name: %s | Phone: %s | Email: %s\n",
                contacts[i].name, contacts[i].phone, contacts[i].email);
     }
-    if (contactCount == 0) {
+    if (contactCount == deadCount) {
         printf("No contacts available.\n");
     }
     printf("---------------------\n");
@@ -79,6 +137,7 @@ void displayContacts() {
 int main() {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
 
     while (1) {
         printf("\nContact Management System (Array-based)\n");
@@ -88,6 +147,7 @@ int main() {
         printf("4. Delete Contact\n");
         printf("5. Display All Contacts\n");
         printf("6. Exit\n");
+        printf("7. Insert or Update Contact\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -100,12 +160,14 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
                 insertContact(name, phone, email);
                 break;
             case 2:
                 printf("Enter Name to Search: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
                 int idx;
+                traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
                 idx = searchContact(name);
                 if (idx != -1)
                     printf("Found: %s | Phone: %s | Email: %s\n",
@@ -120,11 +182,13 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter New Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
                 updateContact(name, phone, email);
                 break;
             case 4:
                 printf("Enter Name to Delete: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
                 deleteContact(name);
                 break;
             case 5:
@@ -132,7 +196,18 @@ int main() {
                 break;
             case 6:
                 printf("Exiting...\n");
+                traceClose();
                 exit(0);
+            case 7:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
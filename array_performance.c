@@ -14,20 +14,120 @@ typedef struct {
     char email[EMAIL_LEN];
 } Contact;
 
-Contact contacts[MAX_CONTACTS];
-int contactCount = 0;
+// contacts points at the static block except while the delete benchmark
+// swaps in a larger one
+Contact staticContacts[MAX_CONTACTS];
+unsigned char staticDead[MAX_CONTACTS];
+Contact* contacts = staticContacts;
+int capacity = MAX_CONTACTS;
+int contactCount = 0;   // used slots, dead ones included
+
+// The array never calls malloc: its footprint is the static contacts block
+#define PERF_STATIC_BYTES sizeof(staticContacts)
+#define PERF_USED_BYTES (contactCount * sizeof(Contact))
+#include "perfcount.h"
+
+// ---------------- Delete Modes ----------------
+// DELETE_SHIFT moves every later contact down one slot (the original).
+// DELETE_TOMBSTONE marks the slot dead: scans skip dead slots, trailing ones
+// are dropped at once, and when more than 1/DEAD_RATIO of the used slots are
+// dead the array is compacted in one order-preserving pass, so the moves
+// average out to O(1) per delete. DELETE_SWAP moves the last contact into
+// the freed slot (insertion order is lost).
+// With indexOn, a name -> slot map (open addressing, linear probing) finds
+// contacts without a scan and is updated whenever a contact moves.
+enum { DELETE_SHIFT, DELETE_TOMBSTONE, DELETE_SWAP };
+#define DEAD_RATIO 4
+int deleteMode = DELETE_SHIFT;
+unsigned char* dead = staticDead;
+int deadCount = 0;
+int compactions = 0;
+int indexOn = 0;
+int* slotIndex = NULL;          // slot + 1 per entry, 0 = empty
+unsigned int indexMask = 0;
+
+unsigned int nameHash(const char* s) {
+    unsigned int h = 2166136261u;
+    while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+// Entry holding name, or the empty entry where it would go
+int* indexProbe(const char* name) {
+    for (unsigned int i = nameHash(name) & indexMask; ; i = (i + 1) & indexMask) {
+        int e = slotIndex[i];
+        if (e == 0 || strcmp(contacts[e - 1].name, name) == 0) return &slotIndex[i];
+    }
+}
+
+void indexInit(int capacity) {
+    unsigned int size = 1024;
+    while (size < (unsigned int)capacity * 2) size *= 2;
+    slotIndex = (int*)calloc(size, sizeof(int));
+    indexMask = size - 1;
+    indexOn = 1;
+}
+
+void indexFree() {
+    free(slotIndex);
+    slotIndex = NULL;
+    indexOn = 0;
+}
+
+// Drop name's entry, shifting later entries of the probe run back (no tombstones)
+void indexRemove(const char* name) {
+    int* e = indexProbe(name);
+    if (*e == 0) return;
+    unsigned int i = e - slotIndex, j = i;
+    for (;;) {
+        j = (j + 1) & indexMask;
+        if (slotIndex[j] == 0) break;
+        unsigned int home = nameHash(contacts[slotIndex[j] - 1].name) & indexMask;
+        // entry j may fill the hole unless its home lies cyclically in (i, j]
+        int between = (i <= j) ? (home > i && home <= j) : (home > i || home <= j);
+        if (!between) {
+            slotIndex[i] = slotIndex[j];
+            i = j;
+        }
+    }
+    slotIndex[i] = 0;
+}
+
+// Copy slot from into slot to, keeping the index pointing at the contact
+void moveContact(int from, int to) {
+    if (indexOn) *indexProbe(contacts[from].name) = to + 1;
+    contacts[to] = contacts[from];
+    dead[to] = dead[from];
+}
+
+void compactContacts() {
+    int j = 0;
+    for (int i = 0; i < contactCount; i++) {
+        if (dead[i]) continue;
+        if (i != j) moveContact(i, j);
+        j++;
+    }
+    contactCount = j;
+    deadCount = 0;
+    compactions++;
+}
 
 // ---------------- Core Functions ----------------
 void insertContact(char *name, char *phone, char *email) {
+    if (contactCount == capacity && deadCount > 0) compactContacts();
+    if (contactCount == capacity) return;
     strcpy(contacts[contactCount].name, name);
     strcpy(contacts[contactCount].phone, phone);
     strcpy(contacts[contactCount].email, email);
+    dead[contactCount] = 0;
+    if (indexOn) *indexProbe(name) = contactCount + 1;
     contactCount++;
 }
 
 int searchContact(char *name) {
+    if (indexOn) return *indexProbe(name) - 1;
     for (int i = 0; i < contactCount; i++) {
-        if (strcmp(contacts[i].name, name) == 0) return i;
+        if (!dead[i] && strcmp(contacts[i].name, name) == 0) return i;
     }
     return -1;
 }
@@ -39,19 +139,65 @@ void updateContact(char *name, char *newPhone, char *newEmail) {
     if (newEmail != NULL) strcpy(contacts[index].email, newEmail);
 }
 
+int insertIfAbsent(char *name, char *phone, char *email) {
+    if (indexOn) {
+        int* e = indexProbe(name);
+        if (*e != 0) return *e - 1;
+    } else {
+        for (int i = 0; i < contactCount; i++) {
+            if (!dead[i] && strcmp(contacts[i].name, name) == 0) return i;
+        }
+    }
+    if (contactCount == capacity && deadCount > 0) compactContacts();
+    if (contactCount == capacity) return -1;
+    strcpy(contacts[contactCount].name, name);
+    strcpy(contacts[contactCount].phone, phone);
+    strcpy(contacts[contactCount].email, email);
+    dead[contactCount] = 0;
+    if (indexOn) *indexProbe(name) = contactCount + 1;
+    return contactCount++;
+}
+
+int upsertContact(char *name, char *phone, char *email) {
+    int index = insertIfAbsent(name, phone, email);
+    if (index == -1) return -1;
+    strcpy(contacts[index].phone, phone);
+    strcpy(contacts[index].email, email);
+    return index;
+}
+
 void deleteContact(char *name) {
     int index = searchContact(name);
     if (index == -1) return;
-    for (int i = index; i < contactCount - 1; i++) contacts[i] = contacts[i + 1];
-    contactCount--;
+    if (indexOn) indexRemove(name);
+    switch (deleteMode) {
+        case DELETE_SHIFT:
+            if (indexOn) for (int i = index; i < contactCount - 1; i++) moveContact(i + 1, i);
+            else for (int i = index; i < contactCount - 1; i++) contacts[i] = contacts[i + 1];
+            contactCount--;
+            break;
+        case DELETE_TOMBSTONE:
+            dead[index] = 1;
+            deadCount++;
+            while (contactCount > 0 && dead[contactCount - 1]) {
+                contactCount--;
+                deadCount--;
+            }
+            if (deadCount * DEAD_RATIO > contactCount) compactContacts();
+            break;
+        case DELETE_SWAP:
+            if (index != contactCount - 1) moveContact(contactCount - 1, index);
+            contactCount--;
+            break;
+    }
 }
 
 void displayContacts() {
     printf("\n--- Contact List ---\n");
     for (int i = 0; i < contactCount; i++)
-        printf("Name: %s | Phone: %s | Email: %s\n",
+        if (!dead[i]) printf("Name: %s | Phone: %s | Email: %s\n",
                contacts[i].name, contacts[i].phone, contacts[i].email);
-    if (contactCount == 0) printf("No contacts available.\n");
+    if (contactCount == deadCount) printf("No contacts available.\n");
     printf("---------------------\n");
 }
 
@@ -77,7 +223,7 @@ Contact generateContact() {
 //     int num_tests = sizeof(test_sizes) / sizeof(test_sizes[0]);
 //     srand(time(NULL));
 
-//     printf("DataStructure,Operation,Contacts,Time_ms\n");
+//     printf("DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes\n");
 
 //     for (int t = 0; t < num_tests; t++) {
 //         int n = test_sizes[t];
@@ -132,58 +278,174 @@ void benchmarkArrayToCSV(const char* filename) {
         return;
     }
 
-    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms\n");
+    fputs(RESULT_CSV_HEADER, fp);
 
     for (int t = 0; t < num_tests; t++) {
         int n = test_sizes[t];
+        resetPeakRSS();
         contactCount = 0;
 
-        Contact temp;
+        Contact data[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
 
-        // -------- Insert Benchmark --------
-        clock_t start = clock();
+        // -------- Search + Insert Benchmark (duplicate check, two scans) --------
+        clock_t start = startPhase();
         for (int i = 0; i < n; i++) {
-            temp = generateContact();
-            insertContact(temp.name, temp.phone, temp.email);
+            if (searchContact(data[i].name) == -1)
+                insertContact(data[i].name, data[i].phone, data[i].email);
         }
-        clock_t end = clock();
-        fprintf(fp, "Array,Insert,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+        writeResult(fp, "Array,InsertSearch", n, twoPass);
+        contactCount = 0;
+
+        // -------- Insert Benchmark (insertIfAbsent, one scan) --------
+        start = startPhase();
+        for (int i = 0; i < n; i++) {
+            insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        }
+        end = stopPhase();
+        double onePass = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+        writeResult(fp, "Array,Insert", n, onePass);
+        printf("Array %d: insertIfAbsent saved %.3f ms over search + insert\n", n, twoPass - onePass);
 
         // -------- Search Benchmark --------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++) {
             searchContact(contacts[i].name);
         }
-        end = clock();
-        fprintf(fp, "Array,Search,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "Array,Search", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
 
         // -------- Update Benchmark --------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++) {
             updateContact(contacts[i].name, "1234567890", "newemail@test.com");
         }
-        end = clock();
-        fprintf(fp, "Array,Update,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "Array,Update", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+
+        // -------- Upsert Benchmark --------
+        start = startPhase();
+        for (int i = 0; i < n; i++) {
+            upsertContact(contacts[i].name, "0987654321", "upsert@test.com");
+        }
+        end = stopPhase();
+        writeResult(fp, "Array,Upsert", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
 
         // -------- Delete Benchmark --------
-        start = clock();
+        start = startPhase();
         for (int i = n - 1; i >= 0; i--) {
             deleteContact(contacts[i].name);
         }
-        end = clock();
-        fprintf(fp, "Array,Delete,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "Array,Delete", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
     }
 
     fclose(fp);
     printf("Benchmark written to %s\n", filename);
 }
 
+// ---------------- Benchmark (Delete Modes to CSV) ----------------
+// DELETE_CONTACTS contacts in a heap block, deleted in random order and timed
+// one by one. Tombstone and swap deletes find the slot through the index and
+// delete every contact; shift keeps the original scan and only the first
+// SHIFT_SAMPLE deletes are timed, since each moves half the array on average.
+#define DELETE_CONTACTS 1000000
+#define SHIFT_SAMPLE 200
+
+int compareLatency(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+void benchmarkDeleteModesToCSV(const char* filename) {
+    int n = DELETE_CONTACTS;
+    const char* modeNames[] = {"Delete_Shift", "Delete_Tombstone", "Delete_Swap"};
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+    fprintf(fp, "DataStructure,Operation,Contacts,Deletes,Time_ms,Avg_us,P99_us,Max_us,Compactions\n");
+
+    Contact* data = (Contact*)malloc(n * sizeof(Contact));
+    int* order = (int*)malloc(n * sizeof(int));
+    unsigned int* ns = (unsigned int*)malloc(n * sizeof(unsigned int));
+    for (int i = 0; i < n; i++) {
+        data[i] = generateContact();
+        order[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1), tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    contacts = (Contact*)malloc(n * sizeof(Contact));
+    dead = (unsigned char*)malloc(n);
+    capacity = n;
+
+    for (int mode = DELETE_SHIFT; mode <= DELETE_SWAP; mode++) {
+        deleteMode = mode;
+        contactCount = deadCount = compactions = 0;
+        if (mode != DELETE_SHIFT) indexInit(n);
+        for (int i = 0; i < n; i++) insertContact(data[i].name, data[i].phone, data[i].email);
+
+        int deletes = mode == DELETE_SHIFT ? SHIFT_SAMPLE : n;
+        struct timespec a, b;
+        double sum = 0;
+        for (int k = 0; k < deletes; k++) {
+            clock_gettime(CLOCK_MONOTONIC, &a);
+            deleteContact(data[order[k]].name);
+            clock_gettime(CLOCK_MONOTONIC, &b);
+            ns[k] = (unsigned int)((b.tv_sec - a.tv_sec) * 1000000000L + (b.tv_nsec - a.tv_nsec));
+            sum += ns[k];
+            // halfway, the survivors must still be found and the deleted ones not
+            if (k == deletes / 2 && mode != DELETE_SHIFT) {
+                int bad = 0;
+                for (int q = 0; q < 1000; q++) {
+                    bad += searchContact(data[order[q]].name) != -1;
+                    bad += searchContact(data[order[n - 1 - q]].name) == -1;
+                }
+                if (bad) printf("  %s: %d wrong lookups halfway\n", modeNames[mode], bad);
+            }
+        }
+        qsort(ns, deletes, sizeof(unsigned int), compareLatency);
+        fprintf(fp, "Array,%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%d\n", modeNames[mode], n, deletes, sum / 1e6,
+                sum / deletes / 1000.0, ns[(long)deletes * 99 / 100] / 1000.0, ns[deletes - 1] / 1000.0, compactions);
+        printf("%-17s %d of %d contacts: %.2f us per delete, max %.1f us, %d compactions, %d slots left\n",
+               modeNames[mode], deletes, n, sum / deletes / 1000.0, ns[deletes - 1] / 1000.0, compactions,
+               contactCount);
+        if (indexOn) indexFree();
+    }
+
+    free(contacts);
+    free(dead);
+    contacts = staticContacts;
+    dead = staticDead;
+    capacity = MAX_CONTACTS;
+    contactCount = deadCount = 0;
+    deleteMode = DELETE_SHIFT;
+    free(data);
+    free(order);
+    free(ns);
+    fclose(fp);
+    printf("Delete mode benchmark written to %s\n", filename);
+}
 
 // ---------------- Main Menu ----------------
-int main() {
+int main(int argc, char** argv) {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
 
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchmarkArrayToCSV(argc > 2 ? argv[2] : "performance_array.csv");
+        return 0;
+    }
+
     while (1) {
         printf("\nContact Management System (Array-based)\n");
         printf("1. Insert Contact\n");
@@ -193,6 +455,7 @@ int main() {
         printf("5. Display All Contacts\n");
         printf("6. Benchmark Performance\n");
         printf("7. Exit\n");
+        printf("8. Delete Modes Benchmark\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -235,6 +498,10 @@ int main() {
             case 7:
                 printf("Exiting...\n");
                 exit(0);
+            case 8:
+                printf("Running delete modes benchmark...\n");
+                benchmarkDeleteModesToCSV("performance_array_delete.csv");
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "trace.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
@@ -11,11 +12,15 @@ typedef struct Contact {
     char name[NAME_LEN];
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
+    char key[NAME_LEN];      // precomputed sort key (see makeSortKey)
     struct Contact* left;
     struct Contact* right;
     int height;
+    int size;                // contacts in this subtree, for rank/select
 } Contact;
 
+#include "cache.h"
+
 Contact* root = NULL;
 
 // Utility: max of two numbers
@@ -28,14 +33,55 @@ int height(Contact* node) {
     return (node == NULL) ? 0 : node->height;
 }
 
+// Number of contacts in a subtree
+int size(Contact* node) {
+    return (node == NULL) ? 0 : node->size;
+}
+
+// Recompute height and size from the children
+void updateNode(Contact* node) {
+    node->height = max(height(node->left), height(node->right)) + 1;
+    node->size = size(node->left) + size(node->right) + 1;
+}
+
+// Base letters for the UTF-8 Latin-1 block U+00C0..U+00FF (second byte 0x80..0xBF)
+static const char foldLatin1[64] =
+    "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+    "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+// Build the sort key for a name: case-folded with accents stripped.
+// Computed once per node so comparisons stay a plain strcmp.
+void makeSortKey(const char* name, char* key) {
+    int len = 0;
+    const unsigned char* s = (const unsigned char*)name;
+    while (*s && len < NAME_LEN - 1) {
+        if (*s == 0xC3 && s[1] >= 0x80 && s[1] <= 0xBF) {
+            key[len++] = foldLatin1[s[1] - 0x80];
+            s += 2;
+        } else {
+            key[len++] = (*s >= 'A' && *s <= 'Z') ? *s - 'A' + 'a' : *s;
+            s++;
+        }
+    }
+    key[len] = '\0';
+}
+
+// Order by sort key, then by the exact name so "alice" and "Alice" can coexist
+int compareContact(const char* key, const char* name, Contact* node) {
+    int cmp = strcmp(key, node->key);
+    return cmp != 0 ? cmp : strcmp(name, node->name);
+}
+
 // Create new contact node
-Contact* createContact(char* name, char* phone, char* email) {
+Contact* createContact(char* key, char* name, char* phone, char* email) {
     Contact* newContact = (Contact*)malloc(sizeof(Contact));
     strcpy(newContact->name, name);
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
+    strcpy(newContact->key, key);
     newContact->left = newContact->right = NULL;
     newContact->height = 1; // new node is initially a leaf
+    newContact->size = 1;
     return newContact;
 }
 
@@ -47,8 +93,8 @@ Contact* rightRotate(Contact* y) {
     x->right = y;
     y->left = T2;
 
-    y->height = max(height(y->left), height(y->right)) + 1;
-    x->height = max(height(x->left), height(x->right)) + 1;
+    updateNode(y);
+    updateNode(x);
 
     return x;
 }
@@ -61,8 +107,8 @@ Contact* leftRotate(Contact* x) {
     y->left = x;
     x->right = T2;
 
-    x->height = max(height(x->left), height(x->right)) + 1;
-    y->height = max(height(y->left), height(y->right)) + 1;
+    updateNode(x);
+    updateNode(y);
 
     return y;
 }
@@ -72,39 +118,42 @@ int getBalance(Contact* node) {
     return (node == NULL) ? 0 : height(node->left) - height(node->right);
 }
 
-// Insert contact
-Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
+// Insert contact (by sort key)
+// *result is set to the new or existing node, *created to whether it is new
+Contact* insertNode(Contact* node, char* key, char* name, char* phone, char* email,
+                    Contact** result, int* created) {
     if (node == NULL) {
-        printf("Contact added: %s\n", name);
-        return createContact(name, phone, email);
+        *result = createContact(key, name, phone, email);
+        *created = 1;
+        return *result;
     }
 
-    int cmp = strcmp(name, node->name);
+    int cmp = compareContact(key, name, node);
     if (cmp < 0)
-        node->left = insertContact(node->left, name, phone, email);
+        node->left = insertNode(node->left, key, name, phone, email, result, created);
     else if (cmp > 0)
-        node->right = insertContact(node->right, name, phone, email);
+        node->right = insertNode(node->right, key, name, phone, email, result, created);
     else {
-        printf("Contact already exists!\n");
+        *result = node;
         return node;
     }
 
-    node->height = 1 + max(height(node->left), height(node->right));
+    updateNode(node);
     int balance = getBalance(node);
 
     // Balancing cases
-    if (balance > 1 && strcmp(name, node->left->name) < 0)
+    if (balance > 1 && compareContact(key, name, node->left) < 0)
         return rightRotate(node);
 
-    if (balance < -1 && strcmp(name, node->right->name) > 0)
+    if (balance < -1 && compareContact(key, name, node->right) > 0)
         return leftRotate(node);
 
-    if (balance > 1 && strcmp(name, node->left->name) > 0) {
+    if (balance > 1 && compareContact(key, name, node->left) > 0) {
         node->left = leftRotate(node->left);
         return rightRotate(node);
     }
 
-    if (balance < -1 && strcmp(name, node->right->name) < 0) {
+    if (balance < -1 && compareContact(key, name, node->right) < 0) {
         node->right = rightRotate(node->right);
         return leftRotate(node);
     }
@@ -112,13 +161,66 @@ Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
     return node;
 }
 
-// Search by name
+Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
+    char key[NAME_LEN];
+    Contact* result;
+    int created = 0;
+    makeSortKey(name, key);
+    node = insertNode(node, key, name, phone, email, &result, &created);
+    if (created)
+        printf("Contact added: %s\n", name);
+    else
+        printf("Contact already exists!\n");
+    return node;
+}
+
+// Find a contact or insert it, in one descent; *result gets the contact
+Contact* insertIfAbsent(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    char key[NAME_LEN];
+    int created = 0;
+    makeSortKey(name, key);
+    return insertNode(node, key, name, phone, email, result, &created);
+}
+
+// Insert a contact or overwrite an existing one, in one descent
+Contact* upsertContact(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    node = insertIfAbsent(node, name, phone, email, result);
+    strcpy((*result)->phone, phone);
+    strcpy((*result)->email, email);
+    printf("Contact saved: %s\n", name);
+    return node;
+}
+
+// Search by exact name, through the front cache when it is on
 Contact* searchContact(Contact* node, char* name) {
-    if (node == NULL) return NULL;
-    int cmp = strcmp(name, node->name);
-    if (cmp == 0) return node;
-    else if (cmp < 0) return searchContact(node->left, name);
-    else return searchContact(node->right, name);
+    unsigned int h = 0;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node != NULL) {
+        int cmp = compareContact(key, name, node);
+        if (cmp == 0) {
+            if (cacheOn) cacheAdmit(node, h);
+            return node;
+        }
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    return NULL;
+}
+
+// Search ignoring case and accents: same descent, comparing keys only
+Contact* searchContactIgnoreCase(Contact* node, char* name) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node != NULL) {
+        int cmp = strcmp(key, node->key);
+        if (cmp == 0) return node;
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    return NULL;
 }
 
 // Update contact
@@ -139,21 +241,25 @@ Contact* findMin(Contact* node) {
     return node;
 }
 
-// Delete contact
-Contact* deleteContact(Contact* node, char* name) {
+// Delete contact by sort key and name
+Contact* deleteNode(Contact* node, char* key, char* name) {
     if (node == NULL) {
         printf("Contact not found.\n");
         return NULL;
     }
 
-    int cmp = strcmp(name, node->name);
+    int cmp = compareContact(key, name, node);
     if (cmp < 0) {
-        node->left = deleteContact(node->left, name);
+        node->left = deleteNode(node->left, key, name);
     } else if (cmp > 0) {
-        node->right = deleteContact(node->right, name);
+        node->right = deleteNode(node->right, key, name);
     } else {
+        // node found: it is freed or overwritten, and a single child's
+        // contents move up into it, so neither name may stay cached
+        cacheInvalidate(node->name);
         if (node->left == NULL || node->right == NULL) {
             Contact* temp = node->left ? node->left : node->right;
+            if (temp != NULL) cacheInvalidate(temp->name);
             if (temp == NULL) {
                 temp = node;
                 node = NULL;
@@ -166,13 +272,14 @@ Contact* deleteContact(Contact* node, char* name) {
             strcpy(node->name, successor->name);
             strcpy(node->phone, successor->phone);
             strcpy(node->email, successor->email);
-            node->right = deleteContact(node->right, successor->name);
+            strcpy(node->key, successor->key);
+            node->right = deleteNode(node->right, successor->key, successor->name);
         }
     }
 
     if (node == NULL) return node;
 
-    node->height = 1 + max(height(node->left), height(node->right));
+    updateNode(node);
     int balance = getBalance(node);
 
     if (balance > 1 && getBalance(node->left) >= 0)
@@ -194,6 +301,77 @@ Contact* deleteContact(Contact* node, char* name) {
     return node;
 }
 
+Contact* deleteContact(Contact* node, char* name) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    return deleteNode(node, key, name);
+}
+
+// ---------------- Order Statistics ----------------
+// Every node knows its subtree size, so the position of a name and the
+// contact at a position are found in one descent instead of an in-order
+// walk from the start.
+
+// Contacts sorted before name (its 0-based position when it is present)
+int rankContact(Contact* node, char* name) {
+    char key[NAME_LEN];
+    int rank = 0;
+    makeSortKey(name, key);
+    while (node != NULL) {
+        int cmp = compareContact(key, name, node);
+        if (cmp <= 0) {
+            if (cmp == 0) return rank + size(node->left);
+            node = node->left;
+        } else {
+            rank += size(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return rank;
+}
+
+// Contact at 0-based position k in sorted order, or NULL
+Contact* selectContact(Contact* node, int k) {
+    while (node != NULL) {
+        int left = size(node->left);
+        if (k == left) return node;
+        if (k < left) {
+            node = node->left;
+        } else {
+            k -= left + 1;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+// Print up to limit contacts starting at position offset: one descent to
+// the first, then in-order steps from the path left on the stack
+int displayPage(Contact* node, int offset, int limit) {
+    Contact* stack[64];
+    int top = 0, shown = 0;
+    while (node != NULL) {
+        int left = size(node->left);
+        if (offset < left) {
+            stack[top++] = node;
+            node = node->left;
+        } else if (offset > left) {
+            offset -= left + 1;
+            node = node->right;
+        } else {
+            stack[top++] = node;
+            break;
+        }
+    }
+    while (top > 0 && shown < limit) {
+        Contact* c = stack[--top];
+        printf("Name: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+        shown++;
+        for (c = c->right; c != NULL; c = c->left) stack[top++] = c;
+    }
+    return shown;
+}
+
 // Display contacts (in-order traversal)
 void displayContacts(Contact* node) {
     if (node != NULL) {
@@ -216,6 +394,8 @@ void freeContacts(Contact* node) {
 int main() {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
+    cacheClear();
 
     while (1) {
         printf("\nContact Management System (AVL Tree)\n");
@@ -225,6 +405,12 @@ int main() {
         printf("4. Delete Contact\n");
         printf("5. Display All Contacts (Sorted)\n");
         printf("6. Exit\n");
+        printf("7. Search Contact (Ignore Case/Accents)\n");
+        printf("8. Insert or Update Contact\n");
+        printf("9. Front Cache Statistics\n");
+        printf("10. Toggle Front Cache\n");
+        printf("11. Display Page (Sorted)\n");
+        printf("12. Contact Position\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -237,12 +423,14 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
                 root = insertContact(root, name, phone, email);
                 break;
             case 2:
                 printf("Enter Name to Search: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
                 {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
                     Contact* c = searchContact(root, name);
                     if (c != NULL)
                         printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
@@ -257,11 +445,13 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter New Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
                 updateContact(name, phone, email);
                 break;
             case 4:
                 printf("Enter Name to Delete: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
                 root = deleteContact(root, name);
                 break;
             case 5:
@@ -273,7 +463,64 @@ int main() {
             case 6:
                 freeContacts(root);
                 printf("Exiting...\n");
+                traceClose();
                 exit(0);
+            case 7:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    Contact* c = searchContactIgnoreCase(root, name);
+                    if (c != NULL)
+                        printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                {
+                    Contact* c;
+                    traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                    root = upsertContact(root, name, phone, email, &c);
+                }
+                break;
+            case 9:
+                displayCacheStats();
+                break;
+            case 10:
+                cacheOn = !cacheOn;
+                cacheClear();
+                printf("Front cache %s.\n", cacheOn ? "enabled" : "disabled");
+                break;
+            case 11: {
+                int page, pageSize;
+                printf("Enter Page Size: ");
+                if (scanf("%d", &pageSize) != 1 || pageSize < 1) pageSize = 10;
+                printf("Enter Page Number (1-%d): ", (size(root) + pageSize - 1) / pageSize);
+                if (scanf("%d", &page) != 1 || page < 1) page = 1;
+                getchar();
+                if ((long)(page - 1) * pageSize >= size(root))
+                    printf("No such page.\n");
+                else
+                    displayPage(root, (page - 1) * pageSize, pageSize);
+                break;
+            }
+            case 12:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    Contact* c = searchContact(root, name);
+                    if (c != NULL)
+                        printf("%s is contact %d of %d\n", c->name, rankContact(root, name) + 1, size(root));
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
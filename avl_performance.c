@@ -2,76 +2,148 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "perfcount.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
 #define EMAIL_LEN 50
+#define RANGE_QUERIES 1000
+#define RANGE_LEN 100
 
 typedef struct Contact {
     char name[NAME_LEN];
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
+    char key[NAME_LEN];
     struct Contact* left;
     struct Contact* right;
     int height;
+    int size;   // contacts in this subtree, for rank/select
 } Contact;
 
+#define CACHE_DEFAULT_ON 0   // off for the standard benchmark, toggled by the cache benchmark
+#include "cache.h"
+
 Contact* root = NULL;
 
 // ----------------- AVL Utilities -----------------
 int max(int a, int b){ return (a>b)?a:b; }
 int height(Contact* node){ return node?node->height:0; }
+int size(Contact* node){ return node?node->size:0; }
+void updateNode(Contact* n){ n->height=1+max(height(n->left),height(n->right)); n->size=1+size(n->left)+size(n->right); }
 int getBalance(Contact* node){ return node?height(node->left)-height(node->right):0; }
 Contact* rightRotate(Contact* y){
     Contact* x = y->left;
     Contact* T2 = x->right;
     x->right=y; y->left=T2;
-    y->height=1+max(height(y->left),height(y->right));
-    x->height=1+max(height(x->left),height(x->right));
+    updateNode(y);
+    updateNode(x);
     return x;
 }
 Contact* leftRotate(Contact* x){
     Contact* y=x->right;
     Contact* T2=y->left;
     y->left=x; x->right=T2;
-    x->height=1+max(height(x->left),height(x->right));
-    y->height=1+max(height(y->left),height(y->right));
+    updateNode(x);
+    updateNode(y);
     return y;
 }
-Contact* createContact(char* name,char* phone,char* email){
-    Contact* c=(Contact*)malloc(sizeof(Contact));
+
+// ----------------- Collation Keys -----------------
+// Base letters for the UTF-8 Latin-1 block U+00C0..U+00FF (second byte 0x80..0xBF)
+static const char foldLatin1[64] =
+    "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+    "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+// Build the sort key for a name: case-folded with accents stripped.
+// Computed once per node so comparisons stay a plain strcmp.
+void makeSortKey(const char* name, char* key) {
+    int len = 0;
+    const unsigned char* s = (const unsigned char*)name;
+    while (*s && len < NAME_LEN - 1) {
+        if (*s == 0xC3 && s[1] >= 0x80 && s[1] <= 0xBF) {
+            key[len++] = foldLatin1[s[1] - 0x80];
+            s += 2;
+        } else {
+            key[len++] = (*s >= 'A' && *s <= 'Z') ? *s - 'A' + 'a' : *s;
+            s++;
+        }
+    }
+    key[len] = '\0';
+}
+
+// Order by sort key, then by the exact name so "alice" and "Alice" can coexist
+int compareContact(const char* key, const char* name, Contact* node) {
+    int cmp = strcmp(key, node->key);
+    return cmp != 0 ? cmp : strcmp(name, node->name);
+}
+
+Contact* createContact(char* key,char* name,char* phone,char* email){
+    Contact* c=(Contact*)countedMalloc(sizeof(Contact));
+    strcpy(c->key,key);
     strcpy(c->name,name);
     strcpy(c->phone,phone);
     strcpy(c->email,email);
-    c->left=c->right=NULL; c->height=1;
+    c->left=c->right=NULL; c->height=1; c->size=1;
     return c;
 }
 
 // ----------------- AVL Operations -----------------
-Contact* insertContact(Contact* node,char* name,char* phone,char* email){
-    if(!node) return createContact(name,phone,email);
-    int cmp=strcmp(name,node->name);
-    if(cmp<0) node->left=insertContact(node->left,name,phone,email);
-    else if(cmp>0) node->right=insertContact(node->right,name,phone,email);
-    else return node;
+Contact* insertNode(Contact* node,char* key,char* name,char* phone,char* email,Contact** result){
+    if(!node) return *result=createContact(key,name,phone,email);
+    int cmp=compareContact(key,name,node);
+    if(cmp<0) node->left=insertNode(node->left,key,name,phone,email,result);
+    else if(cmp>0) node->right=insertNode(node->right,key,name,phone,email,result);
+    else { *result=node; return node; }
 
-    node->height=1+max(height(node->left),height(node->right));
+    updateNode(node);
     int balance=getBalance(node);
 
-    if(balance>1 && strcmp(name,node->left->name)<0) return rightRotate(node);
-    if(balance<-1 && strcmp(name,node->right->name)>0) return leftRotate(node);
-    if(balance>1 && strcmp(name,node->left->name)>0){ node->left=leftRotate(node->left); return rightRotate(node); }
-    if(balance<-1 && strcmp(name,node->right->name)<0){ node->right=rightRotate(node->right); return leftRotate(node); }
+    if(balance>1 && compareContact(key,name,node->left)<0) return rightRotate(node);
+    if(balance<-1 && compareContact(key,name,node->right)>0) return leftRotate(node);
+    if(balance>1 && compareContact(key,name,node->left)>0){ node->left=leftRotate(node->left); return rightRotate(node); }
+    if(balance<-1 && compareContact(key,name,node->right)<0){ node->right=rightRotate(node->right); return leftRotate(node); }
 
     return node;
 }
+Contact* insertContact(Contact* node,char* name,char* phone,char* email){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    Contact* result;
+    return insertNode(node,key,name,phone,email,&result);
+}
+Contact* insertIfAbsent(Contact* node,char* name,char* phone,char* email,Contact** result){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    return insertNode(node,key,name,phone,email,result);
+}
+Contact* upsertContact(Contact* node,char* name,char* phone,char* email,Contact** result){
+    node=insertIfAbsent(node,name,phone,email,result);
+    strcpy((*result)->phone,phone);
+    strcpy((*result)->email,email);
+    return node;
+}
 
 Contact* searchContact(Contact* node,char* name){
-    if(!node) return NULL;
-    int cmp=strcmp(name,node->name);
-    if(cmp==0) return node;
-    else if(cmp<0) return searchContact(node->left,name);
-    else return searchContact(node->right,name);
+    unsigned int h = 0;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
+    char key[NAME_LEN]; makeSortKey(name,key);
+    while(node){
+        int cmp=compareContact(key,name,node);
+        if(cmp==0){ if(cacheOn) cacheAdmit(node,h); return node; }
+        node=(cmp<0)?node->left:node->right;
+    }
+    return NULL;
+}
+Contact* searchContactIgnoreCase(Contact* node,char* name){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    while(node){
+        int cmp=strcmp(key,node->key);
+        if(cmp==0) return node;
+        node=(cmp<0)?node->left:node->right;
+    }
+    return NULL;
 }
 
 void updateContact(char* name,char* phone,char* email){
@@ -83,25 +155,28 @@ void updateContact(char* name,char* phone,char* email){
 
 Contact* findMin(Contact* node){ while(node->left) node=node->left; return node; }
 
-Contact* deleteContact(Contact* node,char* name){
+Contact* deleteNode(Contact* node,char* key,char* name){
     if(!node) return NULL;
-    int cmp=strcmp(name,node->name);
-    if(cmp<0) node->left=deleteContact(node->left,name);
-    else if(cmp>0) node->right=deleteContact(node->right,name);
+    int cmp=compareContact(key,name,node);
+    if(cmp<0) node->left=deleteNode(node->left,key,name);
+    else if(cmp>0) node->right=deleteNode(node->right,key,name);
     else{
+        cacheInvalidate(node->name);   // freed or overwritten; a single child moves up
         if(!node->left || !node->right){
             Contact* temp=node->left?node->left:node->right;
-            if(!temp){ free(node); return NULL; }
-            else{ *node=*temp; free(temp); }
+            if(temp) cacheInvalidate(temp->name);
+            if(!temp){ countedFree(node,sizeof(Contact)); return NULL; }
+            else{ *node=*temp; countedFree(temp,sizeof(Contact)); }
         }else{
             Contact* succ=findMin(node->right);
             strcpy(node->name,succ->name);
             strcpy(node->phone,succ->phone);
             strcpy(node->email,succ->email);
-            node->right=deleteContact(node->right,succ->name);
+            strcpy(node->key,succ->key);
+            node->right=deleteNode(node->right,succ->key,succ->name);
         }
     }
-    node->height=1+max(height(node->left),height(node->right));
+    updateNode(node);
     int balance=getBalance(node);
     if(balance>1 && getBalance(node->left)>=0) return rightRotate(node);
     if(balance>1 && getBalance(node->left)<0){ node->left=leftRotate(node->left); return rightRotate(node); }
@@ -109,8 +184,80 @@ Contact* deleteContact(Contact* node,char* name){
     if(balance<-1 && getBalance(node->right)>0){ node->right=rightRotate(node->right); return leftRotate(node); }
     return node;
 }
+Contact* deleteContact(Contact* node,char* name){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    return deleteNode(node,key,name);
+}
+
+// Visit up to limit contacts with name >= from in order; returns how many were visited
+int rangeContacts(Contact* node,char* from,int limit){
+    Contact* stack[64]; int top=0, count=0;
+    char key[NAME_LEN]; makeSortKey(from,key);
+    while(node){
+        if(compareContact(key,from,node)<=0){ stack[top++]=node; node=node->left; }
+        else node=node->right;
+    }
+    while(top>0 && count<limit){
+        Contact* c=stack[--top]; count++;
+        for(c=c->right;c;c=c->left) stack[top++]=c;
+    }
+    return count;
+}
 
-void freeContacts(Contact* node){ if(!node) return; freeContacts(node->left); freeContacts(node->right); free(node); }
+// ----------------- Order Statistics -----------------
+// Subtree sizes turn a position into one descent: rank, select and a page
+// at any offset cost O(log n + limit) instead of an in-order walk from the start.
+int rankContact(Contact* node,char* name){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    int rank=0;
+    while(node){
+        int cmp=compareContact(key,name,node);
+        if(cmp==0) return rank+size(node->left);
+        if(cmp<0) node=node->left;
+        else { rank+=size(node->left)+1; node=node->right; }
+    }
+    return rank;
+}
+Contact* selectContact(Contact* node,int k){
+    while(node){
+        int left=size(node->left);
+        if(k==left) return node;
+        if(k<left) node=node->left;
+        else { k-=left+1; node=node->right; }
+    }
+    return NULL;
+}
+// Visit up to limit contacts from position offset; out (if given) gets them
+int pageContacts(Contact* node,int offset,int limit,Contact** out){
+    Contact* stack[64]; int top=0, count=0;
+    while(node){
+        int left=size(node->left);
+        if(offset<left){ stack[top++]=node; node=node->left; }
+        else if(offset>left){ offset-=left+1; node=node->right; }
+        else { stack[top++]=node; break; }
+    }
+    while(top>0 && count<limit){
+        Contact* c=stack[--top];
+        if(out) out[count]=c;
+        count++;
+        for(c=c->right;c;c=c->left) stack[top++]=c;
+    }
+    return count;
+}
+// The same page without sizes: walk offset contacts in order, then limit more
+int pageContactsByWalk(Contact* node,int offset,int limit,Contact** out){
+    Contact* stack[64]; int top=0, count=0;
+    while(node || top>0){
+        for(;node;node=node->left) stack[top++]=node;
+        node=stack[--top];
+        if(offset>0) offset--;
+        else { if(out) out[count]=node; if(++count==limit) break; }
+        node=node->right;
+    }
+    return count;
+}
+
+void freeContacts(Contact* node){ if(!node) return; freeContacts(node->left); freeContacts(node->right); countedFree(node,sizeof(Contact)); }
 void displayContacts(Contact* node){ if(!node) return; displayContacts(node->left); printf("Name:%s|Phone:%s|Email:%s\n",node->name,node->phone,node->email); displayContacts(node->right); }
 
 // ----------------- Random Data -----------------
@@ -122,17 +269,22 @@ void randomString(char* str,int len){
 Contact generateContact(){
     Contact c; randomString(c.name,10); randomString(c.phone,10); randomString(c.email,15); return c;
 }
+int compareNames(const void* a,const void* b){
+    char ka[NAME_LEN], kb[NAME_LEN];
+    makeSortKey(((Contact*)a)->name,ka); makeSortKey(((Contact*)b)->name,kb);
+    int cmp=strcmp(ka,kb);
+    return cmp!=0?cmp:strcmp(((Contact*)a)->name,((Contact*)b)->name);
+}
 
 // ----------------- Benchmark -----------------
 // void benchmarkAVL(){
 //     int sizes[]={100,500,1000};
 //     int ntests=sizeof(sizes)/sizeof(sizes[0]);
 //     srand(time(NULL));
-//     printf("DataStructure,Operation,Contacts,Time_ms\n");
+//     printf("DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes\n");
 //     for(int t=0;t<ntests;t++){
 //         int n=sizes[t]; freeContacts(root); root=NULL;
 //         Contact temp; Contact* stored[n];
-
 //         // Insert
 //         clock_t start=clock();
 //         for(int i=0;i<n;i++){ temp=generateContact(); root=insertContact(root,temp.name,temp.phone,temp.email); stored[i]=searchContact(root,temp.name);}
@@ -171,58 +323,664 @@ void benchmarkAVLToCSV(const char* filename) {
         return;
     }
 
-    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms\n");
+    fputs(RESULT_CSV_HEADER, fp);
 
     for (int t = 0; t < ntests; t++) {
         int n = sizes[t];
+        resetPeakRSS();
         freeContacts(root);
         root = NULL;
 
-        Contact temp;
+        Contact data[n];
         Contact* stored[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
 
-        // ---------- Insert ----------
-        clock_t start = clock();
+        // ---------- Insert + Search (two descents) ----------
+        clock_t start = startPhase();
         for (int i = 0; i < n; i++) {
-            temp = generateContact();
-            root = insertContact(root, temp.name, temp.phone, temp.email);
-            stored[i] = searchContact(root, temp.name);
+            root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(root, data[i].name);
         }
-        clock_t end = clock();
-        fprintf(fp, "AVL,Insert,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "AVL,InsertSearch", n, twoPass);
+        freeContacts(root);
+        root = NULL;
+
+        // ---------- Insert (insertIfAbsent, one descent) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            root = insertIfAbsent(root, data[i].name, data[i].phone, data[i].email, &stored[i]);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "AVL,Insert", n, onePass);
+        printf("AVL %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
 
         // ---------- Search ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             searchContact(root, stored[i]->name);
-        end = clock();
-        fprintf(fp, "AVL,Search,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "AVL,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Case-insensitive Search ----------
+        char (*folded)[NAME_LEN] = malloc(n * sizeof(*folded));
+        for (int i = 0; i < n; i++) makeSortKey(stored[i]->name, folded[i]);
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            searchContactIgnoreCase(root, folded[i]);
+        end = stopPhase();
+        writeResult(fp, "AVL,CaseSearch", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        free(folded);
 
         // ---------- Update ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             updateContact(stored[i]->name, "1234567890", "newemail@test.com");
-        end = clock();
-        fprintf(fp, "AVL,Update,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "AVL,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            { Contact* c; root = upsertContact(root, stored[i]->name, "0987654321", "upsert@test.com", &c); }
+        end = stopPhase();
+        writeResult(fp, "AVL,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
 
         // ---------- Delete ----------
-        start = clock();
+        // Delete by the generated names: deleting a two-child node copies its
+        // successor's fields and frees the successor, so stored[] can dangle
+        start = startPhase();
         for (int i = 0; i < n; i++)
-            root = deleteContact(root, stored[i]->name);
-        end = clock();
-        fprintf(fp, "AVL,Delete,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+            root = deleteContact(root, data[i].name);
+        end = stopPhase();
+        writeResult(fp, "AVL,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
     }
 
     fclose(fp);
     printf("AVL benchmark written to %s\n", filename);
 }
 
+// ---------------- Large Benchmark (ordered operations) ----------------
+// Same phases as skiplist_performance's large benchmark so the two CSVs line up.
+// Results go to a volatile sink so optimised builds keep the lookups.
+volatile long sink;
+
+void benchmarkAVLLargeToCSV(const char* filename) {
+    int sizes[] = {100000, 1000000, 10000000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        resetPeakRSS();
+        freeContacts(root);
+        root = NULL;
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        Contact* sorted = (Contact*)malloc(n * sizeof(Contact));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+        memcpy(sorted, data, n * sizeof(Contact));
+        qsort(sorted, n, sizeof(Contact), compareNames);
+
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++)
+            root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+        clock_t end = stopPhase();
+        writeResult(fp, "AVL,Insert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            sink += searchContact(root, data[i].name) != NULL;
+        end = stopPhase();
+        writeResult(fp, "AVL,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            sink += searchContact(root, sorted[i].name) != NULL;
+        end = stopPhase();
+        writeResult(fp, "AVL,SeqSearch", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < RANGE_QUERIES; i++)
+            sink += rangeContacts(root, data[rand() % n].name, RANGE_LEN);
+        end = stopPhase();
+        writeResult(fp, "AVL,Range", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            root = deleteContact(root, data[i].name);
+        end = stopPhase();
+        writeResult(fp, "AVL,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        free(data);
+        free(sorted);
+    }
+
+    fclose(fp);
+    printf("AVL large benchmark written to %s\n", filename);
+}
+
+
+// ---------------- Front Cache Benchmark ----------------
+// Lookups follow a Zipf distribution (s = 1) over the contacts. Ranks are
+// shuffled so the hot names are spread through the structure rather than
+// sitting in insertion order. Each lookup sequence runs with the cache off
+// and then on; the uniform pair shows what the cache costs without skew.
+#define CACHE_LOOKUPS 100000
+volatile long cacheSink;
+
+// Fill out[] with count indexes in [0, n): Zipf ranks through a random permutation
+void zipfIndexes(int n, int count, int* out) {
+    double* cdf = (double*)malloc(n * sizeof(double));
+    int* perm = (int*)malloc(n * sizeof(int));
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int k = 0; k < count; k++) {
+        double u = (double)rand() / ((double)RAND_MAX + 1) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        out[k] = perm[lo];
+    }
+    free(cdf);
+    free(perm);
+}
+
+void benchmarkFrontCacheToCSV(const char* filename) {
+    int sizes[] = {1000, 10000, 100000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Lookups,Time_ms,Hit_rate," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        freeContacts(root); root = NULL;
+        cacheOn = 0;
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+        }
+        int* zipf = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        int* uniform = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        zipfIndexes(n, CACHE_LOOKUPS, zipf);
+        for (int k = 0; k < CACHE_LOOKUPS; k++) uniform[k] = rand() % n;
+
+        const char* labels[] = {"AVL" ",ZipfSearch", "AVL" ",CachedZipfSearch",
+                                "AVL" ",UniformSearch", "AVL" ",CachedUniformSearch"};
+        int* order[] = {zipf, zipf, uniform, uniform};
+        for (int r = 0; r < 4; r++) {
+            cacheOn = r % 2;
+            cacheClear();
+            cacheHits = cacheMisses = 0;
+            clock_t start = startPhase();
+            for (int k = 0; k < CACHE_LOOKUPS; k++)
+                cacheSink += searchContact(root, data[order[r][k]].name) != NULL;
+            clock_t end = stopPhase();
+            double ms = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+            double hitRate = (double)cacheHits / CACHE_LOOKUPS;
+            fprintf(fp, "%s,%d,%d,%.3f,%.4f", labels[r], n, CACHE_LOOKUPS, ms, hitRate);
+            writeCounters(fp, CACHE_LOOKUPS);
+            fputc('\n', fp);
+            printf("%s %d: %.3f ms, hit rate %.1f%%\n", labels[r], n, ms, 100 * hitRate);
+        }
+
+        cacheOn = 0;
+        cacheClear();
+        free(data);
+        free(zipf);
+        free(uniform);
+    }
+
+    fclose(fp);
+    printf("Front cache benchmark written to %s\n", filename);
+}
+
+// ---------------- Pagination Benchmark ----------------
+// Deep pages at 1M and 10M contacts: select, rank and a page of PAGE_SIZE at
+// a random offset through subtree sizes, against reaching the same page by an
+// in-order walk. Each query is timed on its own for the percentiles; names
+// are not kept outside the tree, rank queries use names picked by select.
+#define PAGE_SIZE 50
+#define PAGE_QUERIES 100000
+#define WALK_QUERIES 20
+
+double nowUs(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1e6 + ts.tv_nsec/1e3;
+}
+
+int compareDouble(const void* a,const void* b){
+    double x=*(const double*)a, y=*(const double*)b;
+    return (x>y)-(x<y);
+}
+
+void writePageRow(FILE* fp, const char* op, int n, int queries, double* us){
+    double total=0;
+    for(int i=0;i<queries;i++) total+=us[i];
+    qsort(us, queries, sizeof(double), compareDouble);
+    double p50=us[queries/2], p99=us[(int)(queries*0.99)], maxUs=us[queries-1];
+    fprintf(fp, "AVL,%s,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f\n", op, n, queries, PAGE_SIZE, total/1000,
+            total/queries, p50, p99, maxUs);
+    printf("%-10s %8d contacts: avg %10.3f us, p99 %10.3f us, max %10.3f us\n", op, n, total/queries, p99, maxUs);
+}
+
+void benchmarkPaginationToCSV(const char* filename) {
+    int sizes[] = {1000000, 10000000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+    fprintf(fp, "DataStructure,Operation,Contacts,Queries,Page_size,Time_ms,Avg_us,P50_us,P99_us,Max_us\n");
+
+    double* us = (double*)malloc(PAGE_QUERIES * sizeof(double));
+    Contact* page[PAGE_SIZE];
+    Contact* walked[PAGE_SIZE];
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        freeContacts(root); root = NULL;
+        cacheOn = 0;
+        while (size(root) < n) {
+            Contact c = generateContact();
+            root = insertContact(root, c.name, c.phone, c.email);
+        }
+
+        int bad = 0;
+        for (int i = 0; i < PAGE_QUERIES; i++) {
+            int k = (int)(((long)rand() * RAND_MAX + rand()) % n);
+            double t0 = nowUs();
+            Contact* c = selectContact(root, k);
+            us[i] = nowUs() - t0;
+            sink += c->phone[0];
+        }
+        writePageRow(fp, "Select", n, PAGE_QUERIES, us);
+
+        char (*names)[NAME_LEN] = malloc(PAGE_QUERIES * sizeof(*names));
+        int* positions = (int*)malloc(PAGE_QUERIES * sizeof(int));
+        for (int i = 0; i < PAGE_QUERIES; i++) {
+            positions[i] = (int)(((long)rand() * RAND_MAX + rand()) % n);
+            strcpy(names[i], selectContact(root, positions[i])->name);
+        }
+        for (int i = 0; i < PAGE_QUERIES; i++) {
+            double t0 = nowUs();
+            int r = rankContact(root, names[i]);
+            us[i] = nowUs() - t0;
+            bad += r != positions[i];
+        }
+        writePageRow(fp, "Rank", n, PAGE_QUERIES, us);
+        free(names);
+        free(positions);
+
+        for (int i = 0; i < PAGE_QUERIES; i++) {
+            int offset = (int)(((long)rand() * RAND_MAX + rand()) % (n / PAGE_SIZE)) * PAGE_SIZE;
+            double t0 = nowUs();
+            sink += pageContacts(root, offset, PAGE_SIZE, page);
+            us[i] = nowUs() - t0;
+        }
+        writePageRow(fp, "Page", n, PAGE_QUERIES, us);
+
+        // Walks cost O(offset): few of them, each checked against the indexed page
+        for (int i = 0; i < WALK_QUERIES; i++) {
+            int offset = (int)(((long)rand() * RAND_MAX + rand()) % (n / PAGE_SIZE)) * PAGE_SIZE;
+            double t0 = nowUs();
+            int got = pageContactsByWalk(root, offset, PAGE_SIZE, walked);
+            us[i] = nowUs() - t0;
+            bad += got != pageContacts(root, offset, PAGE_SIZE, page) || memcmp(page, walked, got * sizeof(Contact*)) != 0;
+        }
+        writePageRow(fp, "PageByWalk", n, WALK_QUERIES, us);
+        if (bad) printf("%d rank/page results did not match\n", bad);
+    }
+
+    freeContacts(root); root = NULL;
+    free(us);
+    fclose(fp);
+    printf("Pagination benchmark written to %s\n", filename);
+}
+
+// ---------------- Persistent AVL (copy-on-write snapshots) ----------------
+// A second tree whose nodes carry a reference count: one per parent pointer
+// and one per root (the live version and every snapshot). A snapshot is a
+// single increment of the root's count. A write walks down with pOwn, which
+// copies a node only if another version still shares it, so each write
+// copies the path that a snapshot shares (path copying) and changes nodes in
+// place where nothing does. Releasing a version frees exactly the nodes no
+// other version reaches.
+typedef struct PNode {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    char key[NAME_LEN];
+    struct PNode* left;
+    struct PNode* right;
+    int height;
+    int refs;
+} PNode;
+
+PNode* liveRoot = NULL;
+long pCopies = 0;   // nodes copied by writes (write amplification)
+
+int pHeight(PNode* n){ return n?n->height:0; }
+void pFix(PNode* n){ n->height=1+max(pHeight(n->left),pHeight(n->right)); }
+int pBalanceOf(PNode* n){ return n?pHeight(n->left)-pHeight(n->right):0; }
+
+PNode* pRetain(PNode* n){ if(n) n->refs++; return n; }
+
+void pRelease(PNode* n){
+    if(!n || --n->refs>0) return;
+    pRelease(n->left);
+    pRelease(n->right);
+    countedFree(n,sizeof(PNode));
+}
+
+// Take one reference to n and return a node only the caller holds: n itself
+// if nothing else does, else a copy sharing n's children
+PNode* pOwn(PNode* n){
+    if(n->refs==1) return n;
+    PNode* c=(PNode*)countedMalloc(sizeof(PNode));
+    *c=*n;
+    c->refs=1;
+    pRetain(c->left);
+    pRetain(c->right);
+    n->refs--;
+    pCopies++;
+    return c;
+}
+
+// Rotations take and return an owned reference, owning each node they change
+PNode* pRotateRight(PNode* y){
+    y=pOwn(y);
+    PNode* x=pOwn(y->left);
+    y->left=x->right;
+    x->right=y;
+    pFix(y); pFix(x);
+    return x;
+}
+PNode* pRotateLeft(PNode* x){
+    x=pOwn(x);
+    PNode* y=pOwn(x->right);
+    x->right=y->left;
+    y->left=x;
+    pFix(x); pFix(y);
+    return y;
+}
+
+// n is owned by the caller alone
+PNode* pRebalance(PNode* n){
+    pFix(n);
+    int balance=pBalanceOf(n);
+    if(balance>1){
+        if(pBalanceOf(n->left)<0) n->left=pRotateLeft(n->left);
+        return pRotateRight(n);
+    }
+    if(balance<-1){
+        if(pBalanceOf(n->right)>0) n->right=pRotateRight(n->right);
+        return pRotateLeft(n);
+    }
+    return n;
+}
+
+PNode* pFind(PNode* node,char* key,char* name){
+    while(node){
+        int cmp=strcmp(key,node->key);
+        if(cmp==0) cmp=strcmp(name,node->name);
+        if(cmp==0) return node;
+        node=(cmp<0)?node->left:node->right;
+    }
+    return NULL;
+}
+
+// Each write consumes the caller's reference to node and returns the new
+// version's. Callers check that the name is present (or absent) first, so a
+// write that changes nothing copies nothing.
+PNode* pInsertNode(PNode* node,char* key,char* name,char* phone,char* email){
+    if(!node){
+        PNode* c=(PNode*)countedMalloc(sizeof(PNode));
+        strcpy(c->key,key); strcpy(c->name,name); strcpy(c->phone,phone); strcpy(c->email,email);
+        c->left=c->right=NULL;
+        c->height=1;
+        c->refs=1;
+        return c;
+    }
+    node=pOwn(node);
+    int cmp=strcmp(key,node->key);
+    if(cmp==0) cmp=strcmp(name,node->name);
+    if(cmp<0) node->left=pInsertNode(node->left,key,name,phone,email);
+    else node->right=pInsertNode(node->right,key,name,phone,email);
+    return pRebalance(node);
+}
+
+PNode* pUpdateNode(PNode* node,char* key,char* name,char* phone,char* email){
+    node=pOwn(node);
+    int cmp=strcmp(key,node->key);
+    if(cmp==0) cmp=strcmp(name,node->name);
+    if(cmp<0) node->left=pUpdateNode(node->left,key,name,phone,email);
+    else if(cmp>0) node->right=pUpdateNode(node->right,key,name,phone,email);
+    else { strcpy(node->phone,phone); strcpy(node->email,email); }
+    return node;
+}
+
+PNode* pDeleteNode(PNode* node,char* key,char* name){
+    node=pOwn(node);
+    int cmp=strcmp(key,node->key);
+    if(cmp==0) cmp=strcmp(name,node->name);
+    if(cmp<0) node->left=pDeleteNode(node->left,key,name);
+    else if(cmp>0) node->right=pDeleteNode(node->right,key,name);
+    else if(!node->left || !node->right){
+        PNode* child=node->left?node->left:node->right;   // our reference moves up
+        countedFree(node,sizeof(PNode));
+        return child;
+    }else{
+        PNode* succ=node->right;
+        while(succ->left) succ=succ->left;
+        strcpy(node->name,succ->name); strcpy(node->phone,succ->phone);
+        strcpy(node->email,succ->email); strcpy(node->key,succ->key);
+        node->right=pDeleteNode(node->right,node->key,node->name);
+    }
+    return pRebalance(node);
+}
+
+// Versioned operations on the live tree; 1 if the contact was changed
+int pInsert(char* name,char* phone,char* email){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    if(pFind(liveRoot,key,name)) return 0;
+    liveRoot=pInsertNode(liveRoot,key,name,phone,email);
+    return 1;
+}
+int pUpdate(char* name,char* phone,char* email){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    if(!pFind(liveRoot,key,name)) return 0;
+    liveRoot=pUpdateNode(liveRoot,key,name,phone,email);
+    return 1;
+}
+int pDelete(char* name){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    if(!pFind(liveRoot,key,name)) return 0;
+    liveRoot=pDeleteNode(liveRoot,key,name);
+    return 1;
+}
+PNode* pSearch(PNode* version,char* name){
+    char key[NAME_LEN]; makeSortKey(name,key);
+    return pFind(version,key,name);
+}
+
+// O(1): the snapshot shares the whole tree until writes copy their paths
+PNode* takeSnapshot(){ return pRetain(liveRoot); }
+void releaseSnapshot(PNode* snapshot){ pRelease(snapshot); }
+
+// In-order walk of one version (an export or audit reads this way)
+long pWalk(PNode* node){
+    PNode* stack[64]; int top=0; long count=0;
+    while(node || top>0){
+        for(;node;node=node->left) stack[top++]=node;
+        node=stack[--top];
+        sink+=node->phone[0];
+        count++;
+        node=node->right;
+    }
+    return count;
+}
+
+// ---------------- Persistent AVL Benchmark ----------------
+// Writes on the persistent tree with no snapshot, a snapshot every 64 writes
+// and a snapshot before every write (each released when the next is taken),
+// next to the in-place tree: time, nodes copied per write and the bytes per
+// contact left live. Reads then go to a snapshot taken before PERSIST_WRITES
+// updates and deletes, so it no longer matches the live tree.
+#define PERSIST_WRITES 200000
+
+void writePersistRow(FILE* fp, const char* op, int n, int ops, const char* every, double ms, long copies){
+    fprintf(fp, "AVL,%s,%d,%d,%s,%.3f,%.1f,%.2f,%.1f,%.1f,%ld\n", op, n, ops, every, ms, ms*1e6/ops,
+            (double)copies/ops, (double)copies*sizeof(PNode)/ops, (double)liveBytes/n, peakRSSKB());
+    printf("%-16s every %-5s %8.1f ns/op, %6.2f nodes copied/op, %6.1f bytes/contact\n", op, every,
+           ms*1e6/ops, (double)copies/ops, (double)liveBytes/n);
+}
+
+void benchmarkPersistentToCSV(const char* filename) {
+    int n = 1000000;
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+    fprintf(fp, "DataStructure,Operation,Contacts,Ops,Snapshot_every,Time_ms,Ns_per_op,Copies_per_op,Copied_bytes_per_op,Bytes_per_contact,Peak_RSS_KB\n");
+
+    freeContacts(root); root = NULL;
+    cacheOn = 0;
+    Contact* data = (Contact*)malloc(n * sizeof(Contact));
+    for (int i = 0; i < n; i++) data[i] = generateContact();
+    int* pick = (int*)malloc(PERSIST_WRITES * sizeof(int));
+    for (int i = 0; i < PERSIST_WRITES; i++) pick[i] = rand() % n;
+
+    // ---------- In-place tree ----------
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+    writePersistRow(fp, "InPlaceInsert", n, n, "-", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) updateContact(data[pick[i]].name, "1234567890", "newemail@test.com");
+    writePersistRow(fp, "InPlaceUpdate", n, PERSIST_WRITES, "-", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) sink += searchContact(root, data[pick[i]].name) != NULL;
+    writePersistRow(fp, "InPlaceSearch", n, PERSIST_WRITES, "-", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    freeContacts(root); root = NULL;
+
+    // ---------- Persistent tree ----------
+    pCopies = 0;
+    start = clock();
+    for (int i = 0; i < n; i++) pInsert(data[i].name, data[i].phone, data[i].email);
+    writePersistRow(fp, "Insert", n, n, "never", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, pCopies);
+
+    int every[] = {0, 64, 1};
+    const char* everyLabel[] = {"never", "64", "1"};
+    for (int e = 0; e < 3; e++) {
+        PNode* snap = NULL;
+        pCopies = 0;
+        start = clock();
+        for (int i = 0; i < PERSIST_WRITES; i++) {
+            if (every[e] && i % every[e] == 0) { releaseSnapshot(snap); snap = takeSnapshot(); }
+            pUpdate(data[pick[i]].name, "1234567890", "newemail@test.com");
+        }
+        double ms = ((double)(clock()-start))/CLOCKS_PER_SEC*1000;
+        writePersistRow(fp, "Update", n, PERSIST_WRITES, everyLabel[e], ms, pCopies);
+        releaseSnapshot(snap);
+    }
+
+    // Delete then re-insert the same names, so every round starts from n contacts
+    for (int e = 0; e < 3; e++) {
+        PNode* snap = NULL;
+        pCopies = 0;
+        start = clock();
+        for (int i = 0; i < PERSIST_WRITES; i++) {
+            if (every[e] && i % every[e] == 0) { releaseSnapshot(snap); snap = takeSnapshot(); }
+            pDelete(data[pick[i]].name);
+        }
+        double ms = ((double)(clock()-start))/CLOCKS_PER_SEC*1000;
+        writePersistRow(fp, "Delete", n, PERSIST_WRITES, everyLabel[e], ms, pCopies);
+        releaseSnapshot(snap);
+        for (int i = 0; i < PERSIST_WRITES; i++) pInsert(data[pick[i]].name, data[pick[i]].phone, data[pick[i]].email);
+    }
+
+    // ---------- Snapshots ----------
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) releaseSnapshot(takeSnapshot());
+    writePersistRow(fp, "Snapshot", n, PERSIST_WRITES, "-", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+
+    // A snapshot that the live tree has moved away from: half the picked
+    // names are deleted and the rest updated after it is taken
+    PNode* snap = takeSnapshot();
+    int live = n;
+    pCopies = 0;
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) {
+        if (i % 2) live -= pDelete(data[pick[i]].name);
+        else pUpdate(data[pick[i]].name, "5555555555", "after@test.com");
+    }
+    writePersistRow(fp, "DivergeWrites", n, PERSIST_WRITES, "once", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, pCopies);
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) sink += pSearch(snap, data[pick[i]].name) != NULL;
+    writePersistRow(fp, "SnapshotSearch", n, PERSIST_WRITES, "once", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    start = clock();
+    for (int i = 0; i < PERSIST_WRITES; i++) sink += pSearch(liveRoot, data[pick[i]].name) != NULL;
+    writePersistRow(fp, "LiveSearch", n, PERSIST_WRITES, "once", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    start = clock();
+    long walked = pWalk(snap);
+    double ms = ((double)(clock()-start))/CLOCKS_PER_SEC*1000;
+    writePersistRow(fp, "SnapshotWalk", n, (int)walked, "once", ms, 0);
+    if (walked != n) printf("Snapshot walk saw %ld contacts, expected %d\n", walked, n);
+
+    // Frees the nodes only the snapshot still reached; bytes per contact are now for the live tree
+    start = clock();
+    releaseSnapshot(snap);
+    writePersistRow(fp, "ReleaseSnapshot", live, 1, "once", ((double)(clock()-start))/CLOCKS_PER_SEC*1000, 0);
+    releaseSnapshot(liveRoot);
+    liveRoot = NULL;
+    free(data);
+    free(pick);
+    fclose(fp);
+    printf("Persistent AVL benchmark written to %s\n", filename);
+}
 
 // ----------------- Main Menu -----------------
-int main(){
-    int choice; char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN]; srand(time(NULL));
+int main(int argc,char** argv){
+    int choice; char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN]; srand(time(NULL)); cacheClear();
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if(argc>1 && strcmp(argv[1],"--bench")==0){ benchmarkAVLToCSV(argc>2?argv[2]:"performance_avl.csv"); return 0; }
     while(1){
-        printf("\nContact Management System (AVL Tree)\n1.Insert\n2.Search\n3.Update\n4.Delete\n5.Display\n6.Benchmark\n7.Exit\nEnter choice:");
+        printf("\nContact Management System (AVL Tree)\n1.Insert\n2.Search\n3.Update\n4.Delete\n5.Display\n6.Benchmark\n7.Exit\n8.Large Benchmark\n9.Front Cache Benchmark\n10.Persistent Snapshot Benchmark\n11.Pagination Benchmark\nEnter choice:");
         scanf("%d",&choice); getchar();
         switch(choice){
             case 1: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
@@ -240,6 +998,10 @@ int main(){
             case 5: if(!root) printf("No contacts.\n"); else displayContacts(root); break;
             case 6: benchmarkAVLToCSV("performance_avl.csv"); break;
             case 7: freeContacts(root); exit(0);
+            case 8: benchmarkAVLLargeToCSV("performance_avl_large.csv"); break;
+            case 9: benchmarkFrontCacheToCSV("performance_cache_avl.csv"); break;
+            case 10: benchmarkPersistentToCSV("performance_avl_persistent.csv"); break;
+            case 11: benchmarkPaginationToCSV("performance_avl_pages.csv"); break;
             default: printf("Invalid choice\n");
         }
     }
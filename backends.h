@@ -0,0 +1,1566 @@
+// Compact copies of the contact backends behind one interface, for the
+// tools that drive every backend with the same operations (workload.c and
+// later multi-backend tools). Each backend keeps the algorithm of its
+// *_performance.c counterpart; functions are prefixed per backend so they can
+// live in one program. Include this file from exactly one .c file.
+#ifndef BACKENDS_H
+#define BACKENDS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each backend is a single instance per program. A file that defines
+// BACKENDS_PER_THREAD before including this one gets one instance per
+// thread instead, so threads can each own a store without sharing or locking
+// (shard.c).
+#ifdef BACKENDS_PER_THREAD
+#define BACKEND_STATE static __thread
+#else
+#define BACKEND_STATE static
+#endif
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+
+// Called once per contact by Backend.visit
+typedef void (*VisitFn)(void* ctx, const char* name, const char* phone, const char* email);
+
+typedef struct {
+    const char* name;
+    void (*init)(int capacity);                        // empty store sized for capacity contacts
+    int (*insert)(char* name, char* phone, char* email); // insertIfAbsent: 1 created, 0 existed, -1 full
+    int (*search)(char* name);                          // 1 if found
+    int (*get)(char* name, char* phone, char* email);   // search that copies out phone and email; 1 if found
+    int (*update)(char* name, char* phone, char* email); // 1 if found and updated
+    int (*remove)(char* name);                          // 1 if found and deleted
+    int (*scan)(char* from, int limit);                 // contacts visited from name in order; NULL if unordered
+    long (*visit)(VisitFn fn, void* ctx);               // every contact in storage order (sorted for trees and skip list)
+    void (*destroy)(void);
+} Backend;
+
+// ---------------- Collation Keys (BST / AVL) ----------------
+static const char foldLatin1[64] =
+    "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+    "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+static void makeSortKey(const char* name, char* key) {
+    int len = 0;
+    const unsigned char* s = (const unsigned char*)name;
+    while (*s && len < NAME_LEN - 1) {
+        if (*s == 0xC3 && s[1] >= 0x80 && s[1] <= 0xBF) {
+            key[len++] = foldLatin1[s[1] - 0x80];
+            s += 2;
+        } else {
+            key[len++] = (*s >= 'A' && *s <= 'Z') ? *s - 'A' + 'a' : *s;
+            s++;
+        }
+    }
+    key[len] = '\0';
+}
+
+// ---------------- Array (linear scan, tombstones on delete) ----------------
+// Deletes leave a tombstone as in array.c: dead[i] = 1 instead of shifting
+// the rest down. Every scan skips dead slots, trailing tombstones are dropped
+// at once, and past ARR_DEAD_RATIO the array is compacted in one
+// order-preserving pass. The arrStore* functions work on any ArrStore; the
+// Array backend is the one in arrStore, and Adaptive keeps its own.
+#define ARR_DEAD_RATIO 4   // compact when more than 1/ARR_DEAD_RATIO of the used slots are dead
+
+typedef struct {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+} ArrContact;
+
+typedef struct {
+    ArrContact* contacts;
+    unsigned char* dead;
+    int count, capacity;   // used slots, dead ones included
+    int deadCount;
+} ArrStore;
+
+BACKEND_STATE ArrStore arrStore;
+
+static void arrStoreInit(ArrStore* a, int capacity) {
+    a->capacity = capacity > 0 ? capacity : 1;
+    a->contacts = (ArrContact*)malloc(a->capacity * sizeof(ArrContact));
+    a->dead = (unsigned char*)malloc(a->capacity);
+    a->count = a->deadCount = 0;
+}
+
+// Squeeze out the dead slots, keeping the order of the live ones
+static void arrStoreCompact(ArrStore* a) {
+    int j = 0;
+    for (int i = 0; i < a->count; i++) {
+        if (a->dead[i]) continue;
+        if (i != j) a->contacts[j] = a->contacts[i];
+        a->dead[j++] = 0;
+    }
+    a->count = j;
+    a->deadCount = 0;
+}
+
+static int arrStoreFind(ArrStore* a, char* name) {
+    for (int i = 0; i < a->count; i++)
+        if (!a->dead[i] && strcmp(a->contacts[i].name, name) == 0) return i;
+    return -1;
+}
+
+static int arrStoreInsert(ArrStore* a, char* name, char* phone, char* email) {
+    if (arrStoreFind(a, name) >= 0) return 0;
+    if (a->count == a->capacity && a->deadCount > 0) arrStoreCompact(a);
+    if (a->count == a->capacity) {
+        a->capacity *= 2;
+        a->contacts = (ArrContact*)realloc(a->contacts, a->capacity * sizeof(ArrContact));
+        a->dead = (unsigned char*)realloc(a->dead, a->capacity);
+    }
+    a->dead[a->count] = 0;
+    strcpy(a->contacts[a->count].name, name);
+    strcpy(a->contacts[a->count].phone, phone);
+    strcpy(a->contacts[a->count].email, email);
+    a->count++;
+    return 1;
+}
+
+static int arrStoreGet(ArrStore* a, char* name, char* phone, char* email) {
+    int i = arrStoreFind(a, name);
+    if (i < 0) return 0;
+    strcpy(phone, a->contacts[i].phone);
+    strcpy(email, a->contacts[i].email);
+    return 1;
+}
+
+static int arrStoreUpdate(ArrStore* a, char* name, char* phone, char* email) {
+    int i = arrStoreFind(a, name);
+    if (i < 0) return 0;
+    strcpy(a->contacts[i].phone, phone);
+    strcpy(a->contacts[i].email, email);
+    return 1;
+}
+
+// Drop trailing tombstones, so the last used slot is always live
+static void arrStoreTrim(ArrStore* a) {
+    while (a->count > 0 && a->dead[a->count - 1]) {
+        a->count--;
+        a->deadCount--;
+    }
+}
+
+static int arrStoreRemove(ArrStore* a, char* name) {
+    int index = arrStoreFind(a, name);
+    if (index < 0) return 0;
+    a->dead[index] = 1;
+    a->deadCount++;
+    arrStoreTrim(a);
+    if (a->deadCount * ARR_DEAD_RATIO > a->count) arrStoreCompact(a);
+    return 1;
+}
+
+static long arrStoreVisit(ArrStore* a, VisitFn fn, void* ctx) {
+    for (int i = 0; i < a->count; i++)
+        if (!a->dead[i]) fn(ctx, a->contacts[i].name, a->contacts[i].phone, a->contacts[i].email);
+    return a->count - a->deadCount;
+}
+
+static void arrStoreDestroy(ArrStore* a) {
+    free(a->contacts);
+    free(a->dead);
+    a->contacts = NULL;
+    a->dead = NULL;
+    a->count = a->capacity = a->deadCount = 0;
+}
+
+static void arrInit(int capacity) { arrStoreInit(&arrStore, capacity); }
+static int arrInsert(char* name, char* phone, char* email) { return arrStoreInsert(&arrStore, name, phone, email); }
+static int arrSearch(char* name) { return arrStoreFind(&arrStore, name) >= 0; }
+static int arrGet(char* name, char* phone, char* email) { return arrStoreGet(&arrStore, name, phone, email); }
+static int arrUpdate(char* name, char* phone, char* email) { return arrStoreUpdate(&arrStore, name, phone, email); }
+static int arrRemove(char* name) { return arrStoreRemove(&arrStore, name); }
+static long arrVisit(VisitFn fn, void* ctx) { return arrStoreVisit(&arrStore, fn, ctx); }
+static void arrDestroy(void) { arrStoreDestroy(&arrStore); }
+
+// ---------------- Linked List (append at tail) ----------------
+typedef struct LLContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct LLContact* next;
+} LLContact;
+
+BACKEND_STATE LLContact* llHead = NULL;
+
+static void llInit(int capacity) { (void)capacity; llHead = NULL; }
+
+static LLContact* llFind(char* name) {
+    for (LLContact* c = llHead; c; c = c->next)
+        if (strcmp(c->name, name) == 0) return c;
+    return NULL;
+}
+
+static int llInsert(char* name, char* phone, char* email) {
+    LLContact* temp = llHead;
+    LLContact* last = NULL;
+    while (temp) {
+        if (strcmp(temp->name, name) == 0) return 0;
+        last = temp;
+        temp = temp->next;
+    }
+    LLContact* c = (LLContact*)malloc(sizeof(LLContact));
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    c->next = NULL;
+    if (last == NULL) llHead = c;
+    else last->next = c;
+    return 1;
+}
+
+static int llSearch(char* name) { return llFind(name) != NULL; }
+
+static int llGet(char* name, char* phone, char* email) {
+    LLContact* c = llFind(name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int llUpdate(char* name, char* phone, char* email) {
+    LLContact* c = llFind(name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+static int llRemove(char* name) {
+    LLContact* temp = llHead;
+    LLContact* prev = NULL;
+    while (temp && strcmp(temp->name, name) != 0) {
+        prev = temp;
+        temp = temp->next;
+    }
+    if (!temp) return 0;
+    if (prev == NULL) llHead = temp->next;
+    else prev->next = temp->next;
+    free(temp);
+    return 1;
+}
+
+static long llVisit(VisitFn fn, void* ctx) {
+    long count = 0;
+    for (LLContact* c = llHead; c; c = c->next, count++) fn(ctx, c->name, c->phone, c->email);
+    return count;
+}
+
+static void llDestroy(void) {
+    while (llHead) {
+        LLContact* next = llHead->next;
+        free(llHead);
+        llHead = next;
+    }
+}
+
+// ---------------- Hash Map (separate chaining, djb2, incremental growth) ----------------
+// Grows as hashmap.c does: past one contact per bucket a table about twice
+// the size is allocated next to the old one, and every operation moves
+// HM_MIGRATE_BUCKETS old buckets, in index order, into it. A name whose old
+// bucket is below migrateIndex is in the new table and any other name is
+// still in the old one, so each lookup probes exactly one table. The
+// HashMap backend is the store in hmStore; Adaptive keeps its own.
+#define HM_MAX_LOAD 1          // grow when contacts exceed buckets * HM_MAX_LOAD
+#define HM_MIGRATE_BUCKETS 4   // old buckets moved per operation while growing
+
+typedef struct HMContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct HMContact* next;
+} HMContact;
+
+typedef struct {
+    HMContact** table;
+    unsigned int size;
+    HMContact** oldTable;        // table being drained, NULL when not growing
+    unsigned int oldSize;
+    unsigned int migrateIndex;   // old buckets below this have been moved
+    long count;
+} HMStore;
+
+BACKEND_STATE HMStore hmStore;
+
+static unsigned long hmHash(const char* str) {
+    unsigned long hash = 5381;
+    int c;
+    while ((c = *str++))
+        hash = ((hash << 5) + hash) + c;
+    return hash;
+}
+
+static unsigned int hmNextPrime(unsigned int n) {
+    if (n < 3) n = 3;
+    for (n |= 1; ; n += 2) {
+        int prime = 1;
+        for (unsigned int d = 3; d * d <= n; d += 2)
+            if (n % d == 0) { prime = 0; break; }
+        if (prime) return n;
+    }
+}
+
+// Table sized to the next prime >= capacity, as in hashmap_performance.c;
+// it grows from there if the hint was too small
+static void hmStoreInit(HMStore* m, int capacity) {
+    m->size = hmNextPrime(capacity > 0 ? (unsigned int)capacity : 0);
+    m->table = (HMContact**)calloc(m->size, sizeof(HMContact*));
+    m->oldTable = NULL;
+    m->oldSize = m->migrateIndex = 0;
+    m->count = 0;
+}
+
+// Bucket that holds name, or will hold it once inserted
+static HMContact** hmBucketFor(HMStore* m, const char* name) {
+    unsigned long h = hmHash(name);
+    if (m->oldTable != NULL && h % m->oldSize >= m->migrateIndex) return &m->oldTable[h % m->oldSize];
+    return &m->table[h % m->size];
+}
+
+static void hmMigrateBuckets(HMStore* m, unsigned int count) {
+    while (m->oldTable != NULL && count-- > 0) {
+        HMContact* c = m->oldTable[m->migrateIndex];
+        while (c) {
+            HMContact* next = c->next;
+            unsigned int index = hmHash(c->name) % m->size;
+            c->next = m->table[index];
+            m->table[index] = c;
+            c = next;
+        }
+        m->oldTable[m->migrateIndex++] = NULL;
+        if (m->migrateIndex == m->oldSize) {
+            free(m->oldTable);
+            m->oldTable = NULL;
+        }
+    }
+}
+
+// Move whatever is left, for walks over every bucket
+static void hmFinishResize(HMStore* m) {
+    if (m->oldTable != NULL) hmMigrateBuckets(m, m->oldSize - m->migrateIndex);
+}
+
+static void hmMaybeGrow(HMStore* m) {
+    if (m->oldTable != NULL || m->count <= (long)m->size * HM_MAX_LOAD) return;
+    m->oldTable = m->table;
+    m->oldSize = m->size;
+    m->migrateIndex = 0;
+    m->size = hmNextPrime(m->size * 2);
+    m->table = (HMContact**)calloc(m->size, sizeof(HMContact*));
+}
+
+static HMContact* hmStoreFind(HMStore* m, char* name) {
+    hmMigrateBuckets(m, HM_MIGRATE_BUCKETS);
+    for (HMContact* c = *hmBucketFor(m, name); c; c = c->next)
+        if (strcmp(c->name, name) == 0) return c;
+    return NULL;
+}
+
+static int hmStoreInsert(HMStore* m, char* name, char* phone, char* email) {
+    hmMigrateBuckets(m, HM_MIGRATE_BUCKETS);
+    HMContact** bucket = hmBucketFor(m, name);
+    for (HMContact* c = *bucket; c; c = c->next)
+        if (strcmp(c->name, name) == 0) return 0;
+    HMContact* c = (HMContact*)malloc(sizeof(HMContact));
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    c->next = *bucket;
+    *bucket = c;
+    m->count++;
+    hmMaybeGrow(m);
+    return 1;
+}
+
+static int hmStoreGet(HMStore* m, char* name, char* phone, char* email) {
+    HMContact* c = hmStoreFind(m, name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int hmStoreUpdate(HMStore* m, char* name, char* phone, char* email) {
+    HMContact* c = hmStoreFind(m, name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+static int hmStoreRemove(HMStore* m, char* name) {
+    hmMigrateBuckets(m, HM_MIGRATE_BUCKETS);
+    HMContact** link = hmBucketFor(m, name);
+    while (*link && strcmp((*link)->name, name) != 0) link = &(*link)->next;
+    if (!*link) return 0;
+    HMContact* temp = *link;
+    *link = temp->next;
+    free(temp);
+    m->count--;
+    return 1;
+}
+
+static long hmStoreVisit(HMStore* m, VisitFn fn, void* ctx) {
+    long count = 0;
+    hmFinishResize(m);
+    for (unsigned int i = 0; i < m->size; i++)
+        for (HMContact* c = m->table[i]; c; c = c->next, count++) fn(ctx, c->name, c->phone, c->email);
+    return count;
+}
+
+// Stops at the last contact, so a map drained by Adaptive is freed in O(1)
+static void hmStoreDestroy(HMStore* m) {
+    hmFinishResize(m);
+    for (unsigned int i = 0; i < m->size && m->count > 0; i++) {
+        HMContact* c = m->table[i];
+        while (c) {
+            HMContact* next = c->next;
+            free(c);
+            m->count--;
+            c = next;
+        }
+    }
+    free(m->table);
+    m->table = NULL;
+    m->size = 0;
+    m->count = 0;
+}
+
+static void hmInit(int capacity) { hmStoreInit(&hmStore, capacity); }
+static int hmInsert(char* name, char* phone, char* email) { return hmStoreInsert(&hmStore, name, phone, email); }
+static int hmSearch(char* name) { return hmStoreFind(&hmStore, name) != NULL; }
+static int hmGet(char* name, char* phone, char* email) { return hmStoreGet(&hmStore, name, phone, email); }
+static int hmUpdate(char* name, char* phone, char* email) { return hmStoreUpdate(&hmStore, name, phone, email); }
+static int hmRemove(char* name) { return hmStoreRemove(&hmStore, name); }
+static long hmVisit(VisitFn fn, void* ctx) { return hmStoreVisit(&hmStore, fn, ctx); }
+static void hmDestroy(void) { hmStoreDestroy(&hmStore); }
+
+// ---------------- BST (ordered by sort key) ----------------
+typedef struct TreeContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    char key[NAME_LEN];
+    struct TreeContact* left;
+    struct TreeContact* right;
+    int height;                 // used by the AVL only
+} TreeContact;
+
+BACKEND_STATE TreeContact* bstRoot = NULL;
+
+static int treeCompare(const char* key, const char* name, TreeContact* node) {
+    int cmp = strcmp(key, node->key);
+    return cmp != 0 ? cmp : strcmp(name, node->name);
+}
+
+static TreeContact* treeCreate(char* key, char* name, char* phone, char* email) {
+    TreeContact* c = (TreeContact*)malloc(sizeof(TreeContact));
+    strcpy(c->key, key);
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    c->left = c->right = NULL;
+    c->height = 1;
+    return c;
+}
+
+static TreeContact* treeFind(TreeContact* node, char* name) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node) {
+        int cmp = treeCompare(key, name, node);
+        if (cmp == 0) return node;
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    return NULL;
+}
+
+static int treeGet(TreeContact* node, char* name, char* phone, char* email) {
+    TreeContact* c = treeFind(node, name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int treeUpdate(TreeContact* node, char* name, char* phone, char* email) {
+    TreeContact* c = treeFind(node, name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+// In-order walk from the first contact >= from, visiting up to limit contacts;
+// a heap stack as in treeVisit, since an unbalanced BST can be deep
+static int treeScan(TreeContact* node, char* from, int limit) {
+    int cap = 128, top = 0, count = 0;
+    TreeContact** stack = (TreeContact**)malloc(cap * sizeof(TreeContact*));
+    char key[NAME_LEN];
+    makeSortKey(from, key);
+    while (node) {
+        if (treeCompare(key, from, node) <= 0) {
+            if (top == cap) stack = (TreeContact**)realloc(stack, (cap *= 2) * sizeof(TreeContact*));
+            stack[top++] = node;
+            node = node->left;
+        } else node = node->right;
+    }
+    while (top > 0 && count < limit) {
+        TreeContact* c = stack[--top];
+        count++;
+        for (c = c->right; c; c = c->left) {
+            if (top == cap) stack = (TreeContact**)realloc(stack, (cap *= 2) * sizeof(TreeContact*));
+            stack[top++] = c;
+        }
+    }
+    free(stack);
+    return count;
+}
+
+// In-order walk with a heap stack, since an unbalanced BST can be deep
+static long treeVisit(TreeContact* node, VisitFn fn, void* ctx) {
+    int cap = 128, top = 0;
+    long count = 0;
+    TreeContact** stack = (TreeContact**)malloc(cap * sizeof(TreeContact*));
+    while (node || top > 0) {
+        for (; node; node = node->left) {
+            if (top == cap) stack = (TreeContact**)realloc(stack, (cap *= 2) * sizeof(TreeContact*));
+            stack[top++] = node;
+        }
+        node = stack[--top];
+        fn(ctx, node->name, node->phone, node->email);
+        count++;
+        node = node->right;
+    }
+    free(stack);
+    return count;
+}
+
+static void treeFree(TreeContact* node) {
+    if (!node) return;
+    treeFree(node->left);
+    treeFree(node->right);
+    free(node);
+}
+
+static TreeContact* bstInsertNode(TreeContact* node, char* key, char* name, char* phone, char* email, int* created) {
+    if (!node) { *created = 1; return treeCreate(key, name, phone, email); }
+    int cmp = treeCompare(key, name, node);
+    if (cmp < 0) node->left = bstInsertNode(node->left, key, name, phone, email, created);
+    else if (cmp > 0) node->right = bstInsertNode(node->right, key, name, phone, email, created);
+    return node;
+}
+
+static TreeContact* bstDeleteNode(TreeContact* node, char* key, char* name, int* found) {
+    if (!node) return NULL;
+    int cmp = treeCompare(key, name, node);
+    if (cmp < 0) node->left = bstDeleteNode(node->left, key, name, found);
+    else if (cmp > 0) node->right = bstDeleteNode(node->right, key, name, found);
+    else {
+        *found = 1;
+        if (!node->left || !node->right) {
+            TreeContact* child = node->left ? node->left : node->right;
+            free(node);
+            return child;
+        }
+        TreeContact* succ = node->right;
+        while (succ->left) succ = succ->left;
+        strcpy(node->name, succ->name);
+        strcpy(node->phone, succ->phone);
+        strcpy(node->email, succ->email);
+        strcpy(node->key, succ->key);
+        node->right = bstDeleteNode(node->right, succ->key, succ->name, found);
+    }
+    return node;
+}
+
+static void bstInit(int capacity) { (void)capacity; bstRoot = NULL; }
+
+static int bstInsert(char* name, char* phone, char* email) {
+    char key[NAME_LEN];
+    int created = 0;
+    makeSortKey(name, key);
+    bstRoot = bstInsertNode(bstRoot, key, name, phone, email, &created);
+    return created;
+}
+
+static int bstSearch(char* name) { return treeFind(bstRoot, name) != NULL; }
+static int bstGet(char* name, char* phone, char* email) { return treeGet(bstRoot, name, phone, email); }
+static int bstUpdate(char* name, char* phone, char* email) { return treeUpdate(bstRoot, name, phone, email); }
+
+static int bstRemove(char* name) {
+    char key[NAME_LEN];
+    int found = 0;
+    makeSortKey(name, key);
+    bstRoot = bstDeleteNode(bstRoot, key, name, &found);
+    return found;
+}
+
+static int bstScan(char* from, int limit) { return treeScan(bstRoot, from, limit); }
+static long bstVisit(VisitFn fn, void* ctx) { return treeVisit(bstRoot, fn, ctx); }
+static void bstDestroy(void) { treeFree(bstRoot); bstRoot = NULL; }
+
+// ---------------- AVL (ordered by sort key) ----------------
+BACKEND_STATE TreeContact* avlRoot = NULL;
+
+static int avlHeight(TreeContact* n) { return n ? n->height : 0; }
+static int avlBalance(TreeContact* n) { return n ? avlHeight(n->left) - avlHeight(n->right) : 0; }
+
+static void avlFix(TreeContact* n) {
+    int l = avlHeight(n->left), r = avlHeight(n->right);
+    n->height = 1 + (l > r ? l : r);
+}
+
+static TreeContact* avlRotateRight(TreeContact* y) {
+    TreeContact* x = y->left;
+    y->left = x->right;
+    x->right = y;
+    avlFix(y);
+    avlFix(x);
+    return x;
+}
+
+static TreeContact* avlRotateLeft(TreeContact* x) {
+    TreeContact* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    avlFix(x);
+    avlFix(y);
+    return y;
+}
+
+static TreeContact* avlRebalance(TreeContact* node) {
+    avlFix(node);
+    int balance = avlBalance(node);
+    if (balance > 1) {
+        if (avlBalance(node->left) < 0) node->left = avlRotateLeft(node->left);
+        return avlRotateRight(node);
+    }
+    if (balance < -1) {
+        if (avlBalance(node->right) > 0) node->right = avlRotateRight(node->right);
+        return avlRotateLeft(node);
+    }
+    return node;
+}
+
+static TreeContact* avlInsertNode(TreeContact* node, char* key, char* name, char* phone, char* email, int* created) {
+    if (!node) { *created = 1; return treeCreate(key, name, phone, email); }
+    int cmp = treeCompare(key, name, node);
+    if (cmp < 0) node->left = avlInsertNode(node->left, key, name, phone, email, created);
+    else if (cmp > 0) node->right = avlInsertNode(node->right, key, name, phone, email, created);
+    else return node;
+    return avlRebalance(node);
+}
+
+static TreeContact* avlDeleteNode(TreeContact* node, char* key, char* name, int* found) {
+    if (!node) return NULL;
+    int cmp = treeCompare(key, name, node);
+    if (cmp < 0) node->left = avlDeleteNode(node->left, key, name, found);
+    else if (cmp > 0) node->right = avlDeleteNode(node->right, key, name, found);
+    else {
+        *found = 1;
+        if (!node->left || !node->right) {
+            TreeContact* child = node->left ? node->left : node->right;
+            free(node);
+            return child;
+        }
+        TreeContact* succ = node->right;
+        while (succ->left) succ = succ->left;
+        strcpy(node->name, succ->name);
+        strcpy(node->phone, succ->phone);
+        strcpy(node->email, succ->email);
+        strcpy(node->key, succ->key);
+        node->right = avlDeleteNode(node->right, succ->key, succ->name, found);
+    }
+    return avlRebalance(node);
+}
+
+// The AVL backend is the tree at avlRoot; Adaptive keeps its own root
+static int avlStoreInsert(TreeContact** root, char* name, char* phone, char* email) {
+    char key[NAME_LEN];
+    int created = 0;
+    makeSortKey(name, key);
+    *root = avlInsertNode(*root, key, name, phone, email, &created);
+    return created;
+}
+
+static int avlStoreRemove(TreeContact** root, char* name) {
+    char key[NAME_LEN];
+    int found = 0;
+    makeSortKey(name, key);
+    *root = avlDeleteNode(*root, key, name, &found);
+    return found;
+}
+
+static void avlInit(int capacity) { (void)capacity; avlRoot = NULL; }
+static int avlInsert(char* name, char* phone, char* email) { return avlStoreInsert(&avlRoot, name, phone, email); }
+static int avlSearch(char* name) { return treeFind(avlRoot, name) != NULL; }
+static int avlGet(char* name, char* phone, char* email) { return treeGet(avlRoot, name, phone, email); }
+static int avlUpdate(char* name, char* phone, char* email) { return treeUpdate(avlRoot, name, phone, email); }
+static int avlRemove(char* name) { return avlStoreRemove(&avlRoot, name); }
+static int avlScan(char* from, int limit) { return treeScan(avlRoot, from, limit); }
+static long avlVisit(VisitFn fn, void* ctx) { return treeVisit(avlRoot, fn, ctx); }
+static void avlDestroy(void) { treeFree(avlRoot); avlRoot = NULL; }
+
+// ---------------- Skip List (pooled towers, finger search) ----------------
+#define SL_MAX_LEVEL 24
+#define SL_POOL_CHUNK 256
+
+typedef struct SLContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    int level;
+    struct SLContact* next[];
+} SLContact;
+
+typedef struct SLSlab {
+    struct SLSlab* nextSlab;
+    char data[];
+} SLSlab;
+
+BACKEND_STATE SLContact* slHead = NULL;
+BACKEND_STATE int slLevel = 1;
+BACKEND_STATE SLContact* slFreeTowers[SL_MAX_LEVEL + 1];
+BACKEND_STATE SLSlab* slSlabs = NULL;
+BACKEND_STATE SLContact* slFinger[SL_MAX_LEVEL];
+BACKEND_STATE char slFingerName[NAME_LEN];
+BACKEND_STATE int slFingerValid = 0;
+BACKEND_STATE unsigned int slSeed = 2463534242u;
+
+static SLContact* slAllocTower(int level) {
+    if (slFreeTowers[level] == NULL) {
+        size_t size = sizeof(SLContact) + level * sizeof(SLContact*);
+        SLSlab* slab = (SLSlab*)malloc(sizeof(SLSlab) + size * SL_POOL_CHUNK);
+        slab->nextSlab = slSlabs;
+        slSlabs = slab;
+        for (int i = SL_POOL_CHUNK - 1; i >= 0; i--) {
+            SLContact* c = (SLContact*)(slab->data + i * size);
+            c->next[0] = slFreeTowers[level];
+            slFreeTowers[level] = c;
+        }
+    }
+    SLContact* c = slFreeTowers[level];
+    slFreeTowers[level] = c->next[0];
+    return c;
+}
+
+static int slRandomLevel(void) {
+    unsigned int x = slSeed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    slSeed = x;
+    int level = 1;
+    while ((x & 1) && level < SL_MAX_LEVEL) {
+        level++;
+        x >>= 1;
+    }
+    return level;
+}
+
+static void slInit(int capacity) {
+    (void)capacity;
+    slHead = slAllocTower(SL_MAX_LEVEL);
+    slHead->name[0] = '\0';
+    slHead->level = SL_MAX_LEVEL;
+    for (int i = 0; i < SL_MAX_LEVEL; i++) slHead->next[i] = NULL;
+    slLevel = 1;
+    slFingerValid = 0;
+}
+
+static void slFindPredecessors(char* name, SLContact** update) {
+    SLContact* x = slHead;
+    int top = slLevel - 1;
+    if (slFingerValid && strcmp(name, slFingerName) > 0) {
+        int lvl = 0;
+        while (lvl + 1 < slLevel && slFinger[lvl + 1]->next[lvl + 1] != NULL &&
+               strcmp(slFinger[lvl + 1]->next[lvl + 1]->name, name) < 0)
+            lvl++;
+        for (int i = slLevel - 1; i > lvl; i--) update[i] = slFinger[i];
+        x = slFinger[lvl];
+        top = lvl;
+    }
+    for (int i = top; i >= 0; i--) {
+        while (x->next[i] != NULL && strcmp(x->next[i]->name, name) < 0)
+            x = x->next[i];
+        update[i] = x;
+    }
+    for (int i = 0; i < slLevel; i++) slFinger[i] = update[i];
+    strcpy(slFingerName, name);
+    slFingerValid = 1;
+}
+
+static SLContact* slFind(char* name) {
+    SLContact* update[SL_MAX_LEVEL];
+    slFindPredecessors(name, update);
+    SLContact* x = update[0]->next[0];
+    return (x && strcmp(x->name, name) == 0) ? x : NULL;
+}
+
+static int slInsert(char* name, char* phone, char* email) {
+    SLContact* update[SL_MAX_LEVEL];
+    slFindPredecessors(name, update);
+    SLContact* x = update[0]->next[0];
+    if (x && strcmp(x->name, name) == 0) return 0;
+    int level = slRandomLevel();
+    if (level > slLevel) {
+        for (int i = slLevel; i < level; i++) update[i] = slFinger[i] = slHead;
+        slLevel = level;
+    }
+    SLContact* c = slAllocTower(level);
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    c->level = level;
+    for (int i = 0; i < level; i++) {
+        c->next[i] = update[i]->next[i];
+        update[i]->next[i] = c;
+    }
+    return 1;
+}
+
+static int slSearch(char* name) { return slFind(name) != NULL; }
+
+static int slGet(char* name, char* phone, char* email) {
+    SLContact* c = slFind(name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int slUpdate(char* name, char* phone, char* email) {
+    SLContact* c = slFind(name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+static int slRemove(char* name) {
+    SLContact* update[SL_MAX_LEVEL];
+    slFindPredecessors(name, update);
+    SLContact* x = update[0]->next[0];
+    if (!x || strcmp(x->name, name) != 0) return 0;
+    for (int i = x->level - 1; i >= 0; i--)
+        if (update[i]->next[i] == x) update[i]->next[i] = x->next[i];
+    while (slLevel > 1 && slHead->next[slLevel - 1] == NULL) slLevel--;
+    slFingerValid = 0;
+    x->next[0] = slFreeTowers[x->level];
+    slFreeTowers[x->level] = x;
+    return 1;
+}
+
+static int slScan(char* from, int limit) {
+    SLContact* update[SL_MAX_LEVEL];
+    slFindPredecessors(from, update);
+    int count = 0;
+    for (SLContact* x = update[0]->next[0]; x && count < limit; x = x->next[0]) count++;
+    return count;
+}
+
+static long slVisit(VisitFn fn, void* ctx) {
+    long count = 0;
+    for (SLContact* x = slHead->next[0]; x; x = x->next[0], count++) fn(ctx, x->name, x->phone, x->email);
+    return count;
+}
+
+static void slDestroy(void) {
+    while (slSlabs) {
+        SLSlab* next = slSlabs->nextSlab;
+        free(slSlabs);
+        slSlabs = next;
+    }
+    for (int i = 0; i <= SL_MAX_LEVEL; i++) slFreeTowers[i] = NULL;
+    slHead = NULL;
+}
+
+// ---------------- Splay Tree (top-down splaying, no recursion) ----------------
+typedef struct SPContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct SPContact* left;
+    struct SPContact* right;
+} SPContact;
+
+BACKEND_STATE SPContact* spRoot = NULL;
+
+// name's contact, or the last one on its search path, becomes the root
+static SPContact* spSplay(SPContact* t, const char* name) {
+    SPContact header;
+    SPContact* leftMax = &header;
+    SPContact* rightMin = &header;
+    if (!t) return NULL;
+    header.left = header.right = NULL;
+    while (1) {
+        int cmp = strcmp(name, t->name);
+        if (cmp < 0) {
+            if (!t->left) break;
+            if (strcmp(name, t->left->name) < 0) {
+                SPContact* y = t->left;
+                t->left = y->right;
+                y->right = t;
+                t = y;
+                if (!t->left) break;
+            }
+            rightMin->left = t;
+            rightMin = t;
+            t = t->left;
+        } else if (cmp > 0) {
+            if (!t->right) break;
+            if (strcmp(name, t->right->name) > 0) {
+                SPContact* y = t->right;
+                t->right = y->left;
+                y->left = t;
+                t = y;
+                if (!t->right) break;
+            }
+            leftMax->right = t;
+            leftMax = t;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    leftMax->right = t->left;
+    rightMin->left = t->right;
+    t->left = header.right;
+    t->right = header.left;
+    return t;
+}
+
+static SPContact* spFind(char* name) {
+    spRoot = spSplay(spRoot, name);
+    return (spRoot && strcmp(spRoot->name, name) == 0) ? spRoot : NULL;
+}
+
+static void spInit(int capacity) { (void)capacity; spRoot = NULL; }
+
+static int spInsert(char* name, char* phone, char* email) {
+    spRoot = spSplay(spRoot, name);
+    int cmp = spRoot ? strcmp(name, spRoot->name) : 0;
+    if (spRoot && cmp == 0) return 0;
+    SPContact* c = (SPContact*)malloc(sizeof(SPContact));
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    c->left = c->right = NULL;
+    if (spRoot && cmp < 0) {
+        c->left = spRoot->left;
+        c->right = spRoot;
+        spRoot->left = NULL;
+    } else if (spRoot) {
+        c->right = spRoot->right;
+        c->left = spRoot;
+        spRoot->right = NULL;
+    }
+    spRoot = c;
+    return 1;
+}
+
+static int spSearch(char* name) { return spFind(name) != NULL; }
+
+static int spGet(char* name, char* phone, char* email) {
+    SPContact* c = spFind(name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int spUpdate(char* name, char* phone, char* email) {
+    SPContact* c = spFind(name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+static int spRemove(char* name) {
+    SPContact* c = spFind(name);
+    if (!c) return 0;
+    if (!c->left) {
+        spRoot = c->right;
+    } else {
+        spRoot = spSplay(c->left, name);   // largest on the left: no right child
+        spRoot->right = c->right;
+    }
+    free(c);
+    return 1;
+}
+
+// In-order walk of node's subtree, up to limit contacts (fn may be NULL);
+// a heap stack since a splay tree can be arbitrarily deep
+static long spWalk(SPContact* node, long limit, VisitFn fn, void* ctx) {
+    int cap = 128, top = 0;
+    long count = 0;
+    SPContact** stack = (SPContact**)malloc(cap * sizeof(SPContact*));
+    while ((node || top > 0) && count < limit) {
+        for (; node; node = node->left) {
+            if (top == cap) stack = (SPContact**)realloc(stack, (cap *= 2) * sizeof(SPContact*));
+            stack[top++] = node;
+        }
+        node = stack[--top];
+        if (fn) fn(ctx, node->name, node->phone, node->email);
+        count++;
+        node = node->right;
+    }
+    free(stack);
+    return count;
+}
+
+// After the splay the root is from or a neighbour of it; everything to its
+// right is greater than from
+static int spScan(char* from, int limit) {
+    spRoot = spSplay(spRoot, from);
+    if (!spRoot || limit <= 0) return 0;
+    int count = strcmp(spRoot->name, from) >= 0;
+    return count + (int)spWalk(spRoot->right, limit - count, NULL, NULL);
+}
+
+static long spVisit(VisitFn fn, void* ctx) { return spWalk(spRoot, -1UL >> 1, fn, ctx); }
+
+// Rotate left children up until the tree is a list, then free along it
+static void spDestroy(void) {
+    SPContact* x = spRoot;
+    while (x) {
+        if (x->left) {
+            SPContact* l = x->left;
+            x->left = l->right;
+            l->right = x;
+            x = l;
+        } else {
+            SPContact* next = x->right;
+            free(x);
+            x = next;
+        }
+    }
+    spRoot = NULL;
+}
+
+// ---------------- Cuckoo Hash (2 buckets x 4 tagged slots, stash) ----------------
+#define CK_SLOTS 4
+#define CK_MIN_BUCKETS 16
+#define CK_MAX_KICKS 500
+#define CK_STASH_SIZE 8
+
+typedef struct {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+} CKContact;
+
+typedef struct __attribute__((aligned(64))) {
+    unsigned char tag[CK_SLOTS];   // 0 = empty slot
+    CKContact* slot[CK_SLOTS];
+} CKBucket;
+
+BACKEND_STATE CKBucket* ckTable = NULL;
+BACKEND_STATE unsigned int ckMask = 0;
+BACKEND_STATE CKContact* ckStash[CK_STASH_SIZE];
+BACKEND_STATE int ckStashCount = 0;
+BACKEND_STATE unsigned int ckSeed = 2463534242u;
+
+static unsigned long long ckHash(const char* s) {
+    unsigned long long h = 14695981039346656037ULL;
+    while (*s) h = (h ^ (unsigned char)*s++) * 1099511628211ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static unsigned char ckTag(unsigned long long h) { return (unsigned char)(h >> 56) ? (unsigned char)(h >> 56) : 1; }
+static unsigned int ckFirst(unsigned long long h) { return (unsigned int)h & ckMask; }
+static unsigned int ckSecond(unsigned long long h) { return (unsigned int)(h >> 32) & ckMask; }
+
+static void ckInitTable(unsigned int buckets) {
+    ckTable = (CKBucket*)aligned_alloc(64, buckets * sizeof(CKBucket));
+    memset(ckTable, 0, buckets * sizeof(CKBucket));
+    ckMask = buckets - 1;
+    ckStashCount = 0;
+}
+
+// Sized for capacity contacts at about 90% load
+static void ckInit(int capacity) {
+    unsigned int buckets = CK_MIN_BUCKETS;
+    while ((long)buckets * CK_SLOTS * 9 < (long)capacity * 10) buckets *= 2;
+    ckInitTable(buckets);
+}
+
+// Slot index in *bucket, or in the stash when *bucket is NULL; -1 if absent
+static int ckFind(const char* name, CKBucket** bucket) {
+    unsigned long long h = ckHash(name);
+    unsigned char tag = ckTag(h);
+    unsigned int b = ckFirst(h);
+    for (int pass = 0; pass < 2; pass++, b = ckSecond(h)) {
+        CKBucket* bk = &ckTable[b];
+        for (int i = 0; i < CK_SLOTS; i++) {
+            if (bk->tag[i] == tag && strcmp(bk->slot[i]->name, name) == 0) {
+                *bucket = bk;
+                return i;
+            }
+        }
+    }
+    *bucket = NULL;
+    for (int i = 0; i < ckStashCount; i++)
+        if (strcmp(ckStash[i]->name, name) == 0) return i;
+    return -1;
+}
+
+static int ckPut(unsigned int b, unsigned char tag, CKContact* c) {
+    CKBucket* bk = &ckTable[b];
+    for (int i = 0; i < CK_SLOTS; i++) {
+        if (bk->tag[i] == 0) {
+            bk->tag[i] = tag;
+            bk->slot[i] = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static unsigned int ckRandom(void) {
+    ckSeed ^= ckSeed << 13;
+    ckSeed ^= ckSeed >> 17;
+    ckSeed ^= ckSeed << 5;
+    return ckSeed;
+}
+
+// Random-walk displacement of at most CK_MAX_KICKS steps, leftover to the
+// stash; 0 (nothing moved) only when the stash is full
+static int ckPlace(CKContact* c) {
+    unsigned long long h = ckHash(c->name);
+    unsigned char tag = ckTag(h);
+    unsigned int b = ckFirst(h);
+    if (ckPut(b, tag, c) || ckPut(ckSecond(h), tag, c)) return 1;
+    if (ckStashCount == CK_STASH_SIZE) return 0;
+    if (ckRandom() & 1) b = ckSecond(h);
+    for (int k = 0; k < CK_MAX_KICKS; k++) {
+        CKBucket* bk = &ckTable[b];
+        int i = ckRandom() % CK_SLOTS;
+        CKContact* victim = bk->slot[i];
+        unsigned char victimTag = bk->tag[i];
+        bk->slot[i] = c;
+        bk->tag[i] = tag;
+        c = victim;
+        tag = victimTag;
+        h = ckHash(c->name);
+        b = ckFirst(h) == b ? ckSecond(h) : ckFirst(h);
+        if (ckPut(b, tag, c)) return 1;
+    }
+    ckStash[ckStashCount++] = c;
+    return 1;
+}
+
+static void ckGrow(void) {
+    CKBucket* old = ckTable;
+    unsigned int oldBuckets = ckMask + 1, buckets = oldBuckets * 2;
+    CKContact* oldStash[CK_STASH_SIZE];
+    int oldStashCount = ckStashCount;
+    memcpy(oldStash, ckStash, sizeof(ckStash));
+    for (;;) {
+        int ok = 1;
+        ckInitTable(buckets);
+        for (unsigned int b = 0; b < oldBuckets && ok; b++)
+            for (int i = 0; i < CK_SLOTS && ok; i++)
+                if (old[b].tag[i] != 0) ok = ckPlace(old[b].slot[i]);
+        for (int i = 0; i < oldStashCount && ok; i++) ok = ckPlace(oldStash[i]);
+        if (ok) break;
+        free(ckTable);
+        buckets *= 2;
+    }
+    free(old);
+}
+
+static int ckInsert(char* name, char* phone, char* email) {
+    CKBucket* bk;
+    if (ckFind(name, &bk) >= 0) return 0;
+    CKContact* c = (CKContact*)malloc(sizeof(CKContact));
+    strcpy(c->name, name);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    while (!ckPlace(c)) ckGrow();
+    return 1;
+}
+
+static CKContact* ckLookup(char* name) {
+    CKBucket* bk;
+    int i = ckFind(name, &bk);
+    if (i < 0) return NULL;
+    return bk ? bk->slot[i] : ckStash[i];
+}
+
+static int ckSearch(char* name) { return ckLookup(name) != NULL; }
+
+static int ckGet(char* name, char* phone, char* email) {
+    CKContact* c = ckLookup(name);
+    if (!c) return 0;
+    strcpy(phone, c->phone);
+    strcpy(email, c->email);
+    return 1;
+}
+
+static int ckUpdate(char* name, char* phone, char* email) {
+    CKContact* c = ckLookup(name);
+    if (!c) return 0;
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    return 1;
+}
+
+static int ckRemove(char* name) {
+    CKBucket* bk;
+    int i = ckFind(name, &bk);
+    if (i < 0) return 0;
+    if (bk) {
+        free(bk->slot[i]);
+        bk->tag[i] = 0;
+        bk->slot[i] = NULL;
+    } else {
+        free(ckStash[i]);
+        ckStash[i] = ckStash[--ckStashCount];
+    }
+    // A freed slot may take a stashed contact back
+    for (int s = 0; s < ckStashCount; ) {
+        unsigned long long h = ckHash(ckStash[s]->name);
+        if (ckPut(ckFirst(h), ckTag(h), ckStash[s]) || ckPut(ckSecond(h), ckTag(h), ckStash[s]))
+            ckStash[s] = ckStash[--ckStashCount];
+        else
+            s++;
+    }
+    return 1;
+}
+
+static long ckVisit(VisitFn fn, void* ctx) {
+    long count = 0;
+    for (unsigned int b = 0; b <= ckMask; b++)
+        for (int i = 0; i < CK_SLOTS; i++)
+            if (ckTable[b].tag[i] != 0) {
+                CKContact* c = ckTable[b].slot[i];
+                fn(ctx, c->name, c->phone, c->email);
+                count++;
+            }
+    for (int i = 0; i < ckStashCount; i++, count++) fn(ctx, ckStash[i]->name, ckStash[i]->phone, ckStash[i]->email);
+    return count;
+}
+
+static void ckDestroy(void) {
+    for (unsigned int b = 0; b <= ckMask; b++)
+        for (int i = 0; i < CK_SLOTS; i++)
+            if (ckTable[b].tag[i] != 0) free(ckTable[b].slot[i]);
+    for (int i = 0; i < ckStashCount; i++) free(ckStash[i]);
+    free(ckTable);
+    ckTable = NULL;
+    ckStashCount = 0;
+}
+
+// ---------------- Adaptive (array -> hash map / AVL, migrated incrementally) ----------------
+// Starts as the flat array and moves to the hash map once it outgrows
+// AD_ARRAY_MAX, or to the AVL tree while ordered scans make up at least
+// 1 in AD_ORDERED_SHARE of the last AD_WINDOW operations (and back to the
+// hash map after a window without any). A move is incremental: the new
+// representation takes every write, lookups check the new one and then the
+// old, and every operation carries AD_STEP contacts across until the old one
+// is empty, so no operation does more than a fixed amount of moving. Each
+// representation is a private store (adArr, adHm, adAvl), so Adaptive can
+// run next to the other backends.
+#define AD_ARRAY_MAX 64       // array -> hash map / AVL above this many contacts
+#define AD_ARRAY_MIN 32       // back to the array below this many
+#define AD_WINDOW 1024        // operations per mix sample
+#define AD_ORDERED_SHARE 64   // AVL while scans are >= 1/64 of the window
+#define AD_STEP 8             // contacts migrated per operation
+
+enum { AD_NONE, AD_ARRAY, AD_HASH, AD_TREE };
+
+BACKEND_STATE ArrStore adArr;
+BACKEND_STATE HMStore adHm;
+BACKEND_STATE TreeContact* adAvl;
+BACKEND_STATE unsigned int adBucket;   // hash map migration cursor
+
+// The last used slot is always live, since trailing tombstones are dropped
+static int arrStorePop(ArrStore* a, ArrContact* out) {
+    if (a->count == 0) return 0;
+    *out = a->contacts[--a->count];
+    arrStoreTrim(a);
+    return 1;
+}
+
+// Buckets in order; the old table takes no inserts, so the cursor never goes
+// back. A table caught mid-growth is drained from its old half first, at the
+// bucket the growth would have moved next.
+static int hmStorePop(HMStore* m, ArrContact* out) {
+    HMContact** bucket;
+    if (m->oldTable != NULL) {
+        while (m->migrateIndex < m->oldSize && m->oldTable[m->migrateIndex] == NULL) m->migrateIndex++;
+        if (m->migrateIndex == m->oldSize) {
+            free(m->oldTable);
+            m->oldTable = NULL;
+            return hmStorePop(m, out);
+        }
+        bucket = &m->oldTable[m->migrateIndex];
+    } else {
+        while (adBucket < m->size && m->table[adBucket] == NULL) adBucket++;
+        if (adBucket == m->size) return 0;
+        bucket = &m->table[adBucket];
+    }
+    HMContact* c = *bucket;
+    *bucket = c->next;
+    strcpy(out->name, c->name);
+    strcpy(out->phone, c->phone);
+    strcpy(out->email, c->email);
+    free(c);
+    m->count--;
+    return 1;
+}
+
+static int avlStorePop(TreeContact** root, ArrContact* out) {
+    if (*root == NULL) return 0;
+    strcpy(out->name, (*root)->name);
+    strcpy(out->phone, (*root)->phone);
+    strcpy(out->email, (*root)->email);
+    avlStoreRemove(root, out->name);
+    return 1;
+}
+
+// Operations on one representation's private store
+static void adRepInit(int rep, int capacity) {
+    if (rep == AD_ARRAY) arrStoreInit(&adArr, capacity);
+    else if (rep == AD_HASH) hmStoreInit(&adHm, capacity);
+    else adAvl = NULL;
+}
+
+static int adRepInsert(int rep, char* name, char* phone, char* email) {
+    if (rep == AD_ARRAY) return arrStoreInsert(&adArr, name, phone, email);
+    if (rep == AD_HASH) return hmStoreInsert(&adHm, name, phone, email);
+    return avlStoreInsert(&adAvl, name, phone, email);
+}
+
+static int adRepSearch(int rep, char* name) {
+    if (rep == AD_ARRAY) return arrStoreFind(&adArr, name) >= 0;
+    if (rep == AD_HASH) return hmStoreFind(&adHm, name) != NULL;
+    return treeFind(adAvl, name) != NULL;
+}
+
+static int adRepGet(int rep, char* name, char* phone, char* email) {
+    if (rep == AD_ARRAY) return arrStoreGet(&adArr, name, phone, email);
+    if (rep == AD_HASH) return hmStoreGet(&adHm, name, phone, email);
+    return treeGet(adAvl, name, phone, email);
+}
+
+static int adRepUpdate(int rep, char* name, char* phone, char* email) {
+    if (rep == AD_ARRAY) return arrStoreUpdate(&adArr, name, phone, email);
+    if (rep == AD_HASH) return hmStoreUpdate(&adHm, name, phone, email);
+    return treeUpdate(adAvl, name, phone, email);
+}
+
+static int adRepRemove(int rep, char* name) {
+    if (rep == AD_ARRAY) return arrStoreRemove(&adArr, name);
+    if (rep == AD_HASH) return hmStoreRemove(&adHm, name);
+    return avlStoreRemove(&adAvl, name);
+}
+
+// Take out any one contact, 0 when empty
+static int adRepPop(int rep, ArrContact* out) {
+    if (rep == AD_ARRAY) return arrStorePop(&adArr, out);
+    if (rep == AD_HASH) return hmStorePop(&adHm, out);
+    return avlStorePop(&adAvl, out);
+}
+
+static long adRepVisit(int rep, VisitFn fn, void* ctx) {
+    if (rep == AD_ARRAY) return arrStoreVisit(&adArr, fn, ctx);
+    if (rep == AD_HASH) return hmStoreVisit(&adHm, fn, ctx);
+    return treeVisit(adAvl, fn, ctx);
+}
+
+static void adRepDestroy(int rep) {
+    if (rep == AD_ARRAY) arrStoreDestroy(&adArr);
+    else if (rep == AD_HASH) hmStoreDestroy(&adHm);
+    else {
+        treeFree(adAvl);
+        adAvl = NULL;
+    }
+}
+
+BACKEND_STATE int adCur;               // takes every write
+BACKEND_STATE int adOld;               // being drained into adCur, AD_NONE when settled
+BACKEND_STATE long adCount, adOldCount;
+BACKEND_STATE int adCapacity;          // sizing hint from init, for the hash table
+BACKEND_STATE int adOps, adOrdered, adWantOrdered;
+
+static void adInit(int capacity) {
+    adCapacity = capacity;
+    adCur = AD_ARRAY;
+    adOld = AD_NONE;
+    adCount = 0;
+    adOps = adOrdered = adWantOrdered = 0;
+    adRepInit(AD_ARRAY, AD_ARRAY_MAX);
+}
+
+static void adStartMigration(int to) {
+    adOld = adCur;
+    adOldCount = adCount;
+    adCur = to;
+    adBucket = 0;
+    if (to == AD_HASH) adRepInit(to, adCapacity > 2 * adCount ? adCapacity : (int)(2 * adCount));
+    else adRepInit(to, (int)adCount);
+}
+
+static void adMigrate(long n) {
+    ArrContact c;
+    for (long i = 0; i < n; i++) {
+        if (!adRepPop(adOld, &c)) {
+            adRepDestroy(adOld);
+            adOld = AD_NONE;
+            return;
+        }
+        adOldCount--;
+        adRepInsert(adCur, c.name, c.phone, c.email);
+    }
+}
+
+// After every operation: sample the mix, move AD_STEP contacts, and start
+// a new migration once the last one has finished. Enough scans switch to
+// the tree at once rather than at the end of the window.
+static void adStep(int ordered) {
+    adOrdered += ordered;
+    if (adOrdered * AD_ORDERED_SHARE >= AD_WINDOW) adWantOrdered = 1;
+    if (++adOps == AD_WINDOW) {
+        if (adOrdered == 0) adWantOrdered = 0;
+        adOps = adOrdered = 0;
+    }
+    if (adOld != AD_NONE) {
+        adMigrate(AD_STEP);
+        return;
+    }
+    int want = adWantOrdered ? AD_TREE : AD_HASH;
+    if (adCur == AD_ARRAY ? adCount <= AD_ARRAY_MAX : adCount < AD_ARRAY_MIN) want = AD_ARRAY;
+    if (want != adCur) adStartMigration(want);
+}
+
+static int adInsert(char* name, char* phone, char* email) {
+    int r = (adOld != AD_NONE && adRepSearch(adOld, name)) ? 0 : adRepInsert(adCur, name, phone, email);
+    adCount += r == 1;
+    adStep(0);
+    return r;
+}
+
+static int adSearch(char* name) {
+    int r = adRepSearch(adCur, name) || (adOld != AD_NONE && adRepSearch(adOld, name));
+    adStep(0);
+    return r;
+}
+
+static int adGet(char* name, char* phone, char* email) {
+    int r = adRepGet(adCur, name, phone, email) || (adOld != AD_NONE && adRepGet(adOld, name, phone, email));
+    adStep(0);
+    return r;
+}
+
+static int adUpdate(char* name, char* phone, char* email) {
+    int r = adRepUpdate(adCur, name, phone, email) || (adOld != AD_NONE && adRepUpdate(adOld, name, phone, email));
+    adStep(0);
+    return r;
+}
+
+static int adRemove(char* name) {
+    int r = adRepRemove(adCur, name);
+    if (!r && adOld != AD_NONE && adRepRemove(adOld, name)) {
+        adOldCount--;
+        r = 1;
+    }
+    adCount -= r;
+    adStep(0);
+    return r;
+}
+
+// Contacts >= from in sort-key order, for the array half
+typedef struct {
+    char key[NAME_LEN];
+    char* from;
+    long count;
+} AdScanCount;
+
+static void adCountFrom(void* ctx, const char* name, const char* phone, const char* email) {
+    AdScanCount* s = (AdScanCount*)ctx;
+    char key[NAME_LEN];
+    (void)phone;
+    (void)email;
+    makeSortKey(name, key);
+    int cmp = strcmp(key, s->key);
+    if (cmp > 0 || (cmp == 0 && strcmp(name, s->from) >= 0)) s->count++;
+}
+
+// A scan never walks a hash map. It reads the AVL half in order and merges
+// the array half, which never holds much more than AD_ARRAY_MAX contacts;
+// contacts still in a hash map half are left out until they move. A scan
+// on a settled hash map starts the move to the tree at once. Both halves
+// are disjoint, so the scan visits min(limit, their sum) contacts.
+static int adScan(char* from, int limit) {
+    if (adCur == AD_HASH && adOld == AD_NONE) {
+        adWantOrdered = 1;
+        adStartMigration(AD_TREE);
+    }
+    long count = 0;
+    if (adCur == AD_TREE || adOld == AD_TREE) count = treeScan(adAvl, from, limit);
+    if (adCur == AD_ARRAY || adOld == AD_ARRAY) {
+        AdScanCount s;
+        makeSortKey(from, s.key);
+        s.from = from;
+        s.count = 0;
+        arrStoreVisit(&adArr, adCountFrom, &s);
+        count += s.count;
+    }
+    adStep(1);
+    return (int)(count < limit ? count : limit);
+}
+
+static long adVisit(VisitFn fn, void* ctx) {
+    long count = adRepVisit(adCur, fn, ctx);
+    if (adOld != AD_NONE) count += adRepVisit(adOld, fn, ctx);
+    return count;
+}
+
+static void adDestroy(void) {
+    adRepDestroy(adCur);
+    if (adOld != AD_NONE) adRepDestroy(adOld);
+    adOld = AD_NONE;
+}
+
+// ---------------- Backend Table ----------------
+static const Backend backends[] = {
+    {"Array",      arrInit, arrInsert, arrSearch, arrGet, arrUpdate, arrRemove, NULL,    arrVisit, arrDestroy},
+    {"LinkedList", llInit,  llInsert,  llSearch,  llGet,  llUpdate,  llRemove,  NULL,    llVisit,  llDestroy},
+    {"HashMap",    hmInit,  hmInsert,  hmSearch,  hmGet,  hmUpdate,  hmRemove,  NULL,    hmVisit,  hmDestroy},
+    {"BST",        bstInit, bstInsert, bstSearch, bstGet, bstUpdate, bstRemove, bstScan, bstVisit, bstDestroy},
+    {"AVL",        avlInit, avlInsert, avlSearch, avlGet, avlUpdate, avlRemove, avlScan, avlVisit, avlDestroy},
+    {"SkipList",   slInit,  slInsert,  slSearch,  slGet,  slUpdate,  slRemove,  slScan,  slVisit,  slDestroy},
+    {"Splay",      spInit,  spInsert,  spSearch,  spGet,  spUpdate,  spRemove,  spScan,  spVisit,  spDestroy},
+    {"Cuckoo",     ckInit,  ckInsert,  ckSearch,  ckGet,  ckUpdate,  ckRemove,  NULL,    ckVisit,  ckDestroy},
+    {"Adaptive",   adInit,  adInsert,  adSearch,  adGet,  adUpdate,  adRemove,  adScan,  adVisit,  adDestroy},
+};
+#define NUM_BACKENDS ((int)(sizeof(backends) / sizeof(backends[0])))
+
+// Backend by case-insensitive name, or NULL
+static const Backend* findBackend(const char* name) {
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        const char* a = backends[i].name;
+        const char* b = name;
+        while (*a && *b && ((*a | 32) == (*b | 32))) { a++; b++; }
+        if (*a == '\0' && *b == '\0') return &backends[i];
+    }
+    return NULL;
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "trace.h"
+#include "filter.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
@@ -11,45 +13,180 @@ typedef struct Contact {
     char name[NAME_LEN];
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
+    char key[NAME_LEN];      // precomputed sort key (see makeSortKey)
     struct Contact* left;
     struct Contact* right;
 } Contact;
 
+#include "cache.h"
+
 Contact* root = NULL;
 
+// Base letters for the UTF-8 Latin-1 block U+00C0..U+00FF (second byte 0x80..0xBF)
+static const char foldLatin1[64] =
+    "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+    "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+// Build the sort key for a name: case-folded with accents stripped.
+// Computed once per node so comparisons stay a plain strcmp.
+void makeSortKey(const char* name, char* key) {
+    int len = 0;
+    const unsigned char* s = (const unsigned char*)name;
+    while (*s && len < NAME_LEN - 1) {
+        if (*s == 0xC3 && s[1] >= 0x80 && s[1] <= 0xBF) {
+            key[len++] = foldLatin1[s[1] - 0x80];
+            s += 2;
+        } else {
+            key[len++] = (*s >= 'A' && *s <= 'Z') ? *s - 'A' + 'a' : *s;
+            s++;
+        }
+    }
+    key[len] = '\0';
+}
+
+// Order by sort key, then by the exact name so "alice" and "Alice" can coexist
+int compareContact(const char* key, const char* name, Contact* node) {
+    int cmp = strcmp(key, node->key);
+    return cmp != 0 ? cmp : strcmp(name, node->name);
+}
+
 // Create a new contact node
-Contact* createContact(char* name, char* phone, char* email) {
+Contact* createContact(char* key, char* name, char* phone, char* email) {
     Contact* newContact = (Contact*)malloc(sizeof(Contact));
     strcpy(newContact->name, name);
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
+    strcpy(newContact->key, key);
     newContact->left = newContact->right = NULL;
     return newContact;
 }
 
-// Insert into BST (by name)
-Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
+// ---------------- Membership Filter ----------------
+// The filter itself is in filter.h; these hooks rebuild it from the tree.
+
+long countContacts(Contact* node) {
+    return node == NULL ? 0 : 1 + countContacts(node->left) + countContacts(node->right);
+}
+
+void hashNames(Contact* node, unsigned long long* keys, long* n) {
+    if (node == NULL) return;
+    hashNames(node->left, keys, n);
+    keys[(*n)++] = filterHash(node->name);
+    hashNames(node->right, keys, n);
+}
+
+// Hash of every name in the tree, in a new array; *n gets the count
+unsigned long long* collectNameHashes(Contact* tree, long* n) {
+    unsigned long long* keys = (unsigned long long*)malloc((countContacts(tree) + 1) * sizeof(unsigned long long));
+    *n = 0;
+    hashNames(tree, keys, n);
+    return keys;
+}
+
+void filterRebuild(Contact* tree) {
+    long n;
+    unsigned long long* keys = collectNameHashes(tree, &n);
+    filterBuild(keys, n);
+}
+
+// Called once an insert or delete has finished
+void filterMaintain(Contact* tree) {
+    if (filterStale()) filterRebuild(tree);
+}
+
+// Switch mode; the new filter is built from the tree
+void filterSetMode(Contact* tree, int mode) {
+    filterFree();
+    filterMode = mode;
+    if (mode != FILTER_OFF) filterRebuild(tree);
+}
+
+// Insert into BST (by sort key)
+// *result is set to the new or existing node, *created to whether it is new
+Contact* insertNode(Contact* node, char* key, char* name, char* phone, char* email,
+                    Contact** result, int* created) {
     if (node == NULL) {
-        printf("Contact added: %s\n", name);
-        return createContact(name, phone, email);
+        *result = createContact(key, name, phone, email);
+        *created = 1;
+        filterAdd(name);
+        return *result;
     }
-    int cmp = strcmp(name, node->name);
+    int cmp = compareContact(key, name, node);
     if (cmp < 0)
-        node->left = insertContact(node->left, name, phone, email);
+        node->left = insertNode(node->left, key, name, phone, email, result, created);
     else if (cmp > 0)
-        node->right = insertContact(node->right, name, phone, email);
+        node->right = insertNode(node->right, key, name, phone, email, result, created);
+    else
+        *result = node;
+    return node;
+}
+
+Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
+    char key[NAME_LEN];
+    Contact* result;
+    int created = 0;
+    makeSortKey(name, key);
+    node = insertNode(node, key, name, phone, email, &result, &created);
+    filterMaintain(node);
+    if (created)
+        printf("Contact added: %s\n", name);
     else
         printf("Contact already exists!\n");
     return node;
 }
 
-// Search by name
+// Find a contact or insert it, in one descent; *result gets the contact
+Contact* insertIfAbsent(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    char key[NAME_LEN];
+    int created = 0;
+    makeSortKey(name, key);
+    node = insertNode(node, key, name, phone, email, result, &created);
+    filterMaintain(node);
+    return node;
+}
+
+// Insert a contact or overwrite an existing one, in one descent
+Contact* upsertContact(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    node = insertIfAbsent(node, name, phone, email, result);
+    strcpy((*result)->phone, phone);
+    strcpy((*result)->email, email);
+    printf("Contact saved: %s\n", name);
+    return node;
+}
+
+// Search by exact name: names the filter rules out are not looked for, the
+// rest go through the front cache when it is on
 Contact* searchContact(Contact* node, char* name) {
-    if (node == NULL) return NULL;
-    int cmp = strcmp(name, node->name);
-    if (cmp == 0) return node;
-    else if (cmp < 0) return searchContact(node->left, name);
-    else return searchContact(node->right, name);
+    unsigned int h = 0;
+    if (!filterMayContain(name)) return NULL;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node != NULL) {
+        int cmp = compareContact(key, name, node);
+        if (cmp == 0) {
+            if (cacheOn) cacheAdmit(node, h);
+            return node;
+        }
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    filterFalsePositive();
+    return NULL;
+}
+
+// Search ignoring case and accents: same descent, comparing keys only
+Contact* searchContactIgnoreCase(Contact* node, char* name) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node != NULL) {
+        int cmp = strcmp(key, node->key);
+        if (cmp == 0) return node;
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    return NULL;
 }
 
 // Update a contact
@@ -70,19 +207,22 @@ Contact* findMin(Contact* node) {
     return node;
 }
 
-// Delete a contact by name
-Contact* deleteContact(Contact* node, char* name) {
+// Delete a contact by sort key and name
+Contact* deleteNode(Contact* node, char* key, char* name) {
     if (node == NULL) {
+        filterFalsePositive();
         printf("Contact not found.\n");
         return NULL;
     }
-    int cmp = strcmp(name, node->name);
+    int cmp = compareContact(key, name, node);
     if (cmp < 0) {
-        node->left = deleteContact(node->left, name);
+        node->left = deleteNode(node->left, key, name);
     } else if (cmp > 0) {
-        node->right = deleteContact(node->right, name);
+        node->right = deleteNode(node->right, key, name);
     } else {
-        // node found
+        // node found: it is freed or overwritten by its successor below
+        cacheInvalidate(node->name);
+        if (node->left == NULL || node->right == NULL) filterDelete();   // this node is freed
         if (node->left == NULL && node->right == NULL) {
             free(node);
             return NULL;
@@ -99,12 +239,25 @@ Contact* deleteContact(Contact* node, char* name) {
             strcpy(node->name, successor->name);
             strcpy(node->phone, successor->phone);
             strcpy(node->email, successor->email);
-            node->right = deleteContact(node->right, successor->name);
+            strcpy(node->key, successor->key);
+            node->right = deleteNode(node->right, successor->key, successor->name);
         }
     }
     return node;
 }
 
+Contact* deleteContact(Contact* node, char* name) {
+    char key[NAME_LEN];
+    if (!filterMayContain(name)) {
+        printf("Contact not found.\n");
+        return node;
+    }
+    makeSortKey(name, key);
+    node = deleteNode(node, key, name);
+    filterMaintain(node);
+    return node;
+}
+
 // In-order traversal (sorted by name)
 void displayContacts(Contact* node) {
     if (node != NULL) {
@@ -128,6 +281,9 @@ void freeContacts(Contact* node) {
 int main() {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
+    cacheClear();
+    filterSetMode(root, FILTER_BLOOM);
 
     while (1) {
         printf("\nContact Management System (BST)\n");
@@ -137,6 +293,12 @@ int main() {
         printf("4. Delete Contact\n");
         printf("5. Display All Contacts (Sorted)\n");
         printf("6. Exit\n");
+        printf("7. Search Contact (Ignore Case/Accents)\n");
+        printf("8. Insert or Update Contact\n");
+        printf("9. Front Cache Statistics\n");
+        printf("10. Toggle Front Cache\n");
+        printf("11. Membership Filter Statistics\n");
+        printf("12. Set Membership Filter (0 off, 1 Bloom, 2 xor)\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -149,12 +311,14 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
                 root = insertContact(root, name, phone, email);
                 break;
             case 2:
                 printf("Enter Name to Search: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
                 {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
                     Contact* c = searchContact(root, name);
                     if (c != NULL)
                         printf("Found: %s | Phone: %s | Email: %s\n",
@@ -170,11 +334,13 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter New Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
                 updateContact(name, phone, email);
                 break;
             case 4:
                 printf("Enter Name to Delete: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
                 root = deleteContact(root, name);
                 break;
             case 5:
@@ -185,8 +351,59 @@ int main() {
                 break;
             case 6:
                 freeContacts(root);
+                filterFree();
                 printf("Exiting...\n");
+                traceClose();
                 exit(0);
+            case 7:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    Contact* c = searchContactIgnoreCase(root, name);
+                    if (c != NULL)
+                        printf("Found: %s | Phone: %s | Email: %s\n",
+                               c->name, c->phone, c->email);
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                {
+                    Contact* c;
+                    traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                    root = upsertContact(root, name, phone, email, &c);
+                }
+                break;
+            case 9:
+                displayCacheStats();
+                break;
+            case 10:
+                cacheOn = !cacheOn;
+                cacheClear();
+                printf("Front cache %s.\n", cacheOn ? "enabled" : "disabled");
+                break;
+            case 11:
+                displayFilterStats();
+                break;
+            case 12:
+                printf("Filter mode: ");
+                {
+                    int mode;
+                    if (scanf("%d", &mode) == 1 && mode >= FILTER_OFF && mode <= FILTER_XOR) {
+                        filterSetMode(root, mode);
+                        printf("Membership filter %s.\n", filterModeNames[mode]);
+                    } else {
+                        printf("Invalid mode!\n");
+                    }
+                    getchar();
+                }
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
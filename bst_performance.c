@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "perfcount.h"
+#define FILTER_DEFAULT_MODE FILTER_OFF
+#include "filter.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
@@ -11,36 +14,162 @@ typedef struct Contact {
     char name[NAME_LEN];
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
+    char key[NAME_LEN];
     struct Contact* left;
     struct Contact* right;
 } Contact;
 
+#define CACHE_DEFAULT_ON 0   // off for the standard benchmark, toggled by the cache benchmark
+#include "cache.h"
+
 Contact* root = NULL;
 
+// ------------------- Collation Keys -------------------
+// Base letters for the UTF-8 Latin-1 block U+00C0..U+00FF (second byte 0x80..0xBF)
+static const char foldLatin1[64] =
+    "aaaaaaaceeeeiiiidnooooo*ouuuuyts"
+    "aaaaaaaceeeeiiiidnooooo/ouuuuyty";
+
+// Build the sort key for a name: case-folded with accents stripped.
+// Computed once per node so comparisons stay a plain strcmp.
+void makeSortKey(const char* name, char* key) {
+    int len = 0;
+    const unsigned char* s = (const unsigned char*)name;
+    while (*s && len < NAME_LEN - 1) {
+        if (*s == 0xC3 && s[1] >= 0x80 && s[1] <= 0xBF) {
+            key[len++] = foldLatin1[s[1] - 0x80];
+            s += 2;
+        } else {
+            key[len++] = (*s >= 'A' && *s <= 'Z') ? *s - 'A' + 'a' : *s;
+            s++;
+        }
+    }
+    key[len] = '\0';
+}
+
+// Order by sort key, then by the exact name so "alice" and "Alice" can coexist
+int compareContact(const char* key, const char* name, Contact* node) {
+    int cmp = strcmp(key, node->key);
+    return cmp != 0 ? cmp : strcmp(name, node->name);
+}
+
+// ---------------- Membership Filter ----------------
+// The filter itself is in filter.h; these hooks rebuild it from the tree.
+
+long countContacts(Contact* node) {
+    return node == NULL ? 0 : 1 + countContacts(node->left) + countContacts(node->right);
+}
+
+void hashNames(Contact* node, unsigned long long* keys, long* n) {
+    if (node == NULL) return;
+    hashNames(node->left, keys, n);
+    keys[(*n)++] = filterHash(node->name);
+    hashNames(node->right, keys, n);
+}
+
+// Hash of every name in the tree, in a new array; *n gets the count
+unsigned long long* collectNameHashes(Contact* tree, long* n) {
+    unsigned long long* keys = (unsigned long long*)malloc((countContacts(tree) + 1) * sizeof(unsigned long long));
+    *n = 0;
+    hashNames(tree, keys, n);
+    return keys;
+}
+
+void filterRebuild(Contact* tree) {
+    long n;
+    unsigned long long* keys = collectNameHashes(tree, &n);
+    filterBuild(keys, n);
+}
+
+// Called once an insert or delete has finished
+void filterMaintain(Contact* tree) {
+    if (filterStale()) filterRebuild(tree);
+}
+
+// Switch mode; the new filter is built from the tree
+void filterSetMode(Contact* tree, int mode) {
+    filterFree();
+    filterMode = mode;
+    if (mode != FILTER_OFF) filterRebuild(tree);
+}
+
 // ------------------- BST Operations -------------------
-Contact* createContact(char* name, char* phone, char* email) {
-    Contact* newContact = (Contact*)malloc(sizeof(Contact));
+Contact* createContact(char* key, char* name, char* phone, char* email) {
+    Contact* newContact = (Contact*)countedMalloc(sizeof(Contact));
     strcpy(newContact->name, name);
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
+    strcpy(newContact->key, key);
     newContact->left = newContact->right = NULL;
     return newContact;
 }
 
+Contact* insertNode(Contact* node, char* key, char* name, char* phone, char* email, Contact** result) {
+    if (node == NULL) {
+        filterAdd(name);
+        return *result = createContact(key, name, phone, email);
+    }
+    int cmp = compareContact(key, name, node);
+    if (cmp < 0) node->left = insertNode(node->left, key, name, phone, email, result);
+    else if (cmp > 0) node->right = insertNode(node->right, key, name, phone, email, result);
+    else *result = node;
+    return node;
+}
+
 Contact* insertContact(Contact* node, char* name, char* phone, char* email) {
-    if (node == NULL) return createContact(name, phone, email);
-    int cmp = strcmp(name, node->name);
-    if (cmp < 0) node->left = insertContact(node->left, name, phone, email);
-    else if (cmp > 0) node->right = insertContact(node->right, name, phone, email);
+    char key[NAME_LEN];
+    Contact* result;
+    makeSortKey(name, key);
+    node = insertNode(node, key, name, phone, email, &result);
+    filterMaintain(node);
+    return node;
+}
+
+Contact* insertIfAbsent(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    node = insertNode(node, key, name, phone, email, result);
+    filterMaintain(node);
+    return node;
+}
+
+Contact* upsertContact(Contact* node, char* name, char* phone, char* email, Contact** result) {
+    node = insertIfAbsent(node, name, phone, email, result);
+    strcpy((*result)->phone, phone);
+    strcpy((*result)->email, email);
     return node;
 }
 
 Contact* searchContact(Contact* node, char* name) {
-    if (node == NULL) return NULL;
-    int cmp = strcmp(name, node->name);
-    if (cmp == 0) return node;
-    else if (cmp < 0) return searchContact(node->left, name);
-    else return searchContact(node->right, name);
+    unsigned int h = 0;
+    if (!filterMayContain(name)) return NULL;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node) {
+        int cmp = compareContact(key, name, node);
+        if (cmp == 0) {
+            if (cacheOn) cacheAdmit(node, h);
+            return node;
+        }
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    filterFalsePositive();
+    return NULL;
+}
+
+Contact* searchContactIgnoreCase(Contact* node, char* name) {
+    char key[NAME_LEN];
+    makeSortKey(name, key);
+    while (node) {
+        int cmp = strcmp(key, node->key);
+        if (cmp == 0) return node;
+        node = (cmp < 0) ? node->left : node->right;
+    }
+    return NULL;
 }
 
 void updateContact(char* name, char* newPhone, char* newEmail) {
@@ -55,31 +184,46 @@ Contact* findMin(Contact* node) {
     return node;
 }
 
-Contact* deleteContact(Contact* node, char* name) {
-    if (!node) return NULL;
-    int cmp = strcmp(name, node->name);
-    if (cmp < 0) node->left = deleteContact(node->left, name);
-    else if (cmp > 0) node->right = deleteContact(node->right, name);
+Contact* deleteNode(Contact* node, char* key, char* name) {
+    if (!node) {
+        filterFalsePositive();
+        return NULL;
+    }
+    int cmp = compareContact(key, name, node);
+    if (cmp < 0) node->left = deleteNode(node->left, key, name);
+    else if (cmp > 0) node->right = deleteNode(node->right, key, name);
     else {
-        if (!node->left && !node->right) { free(node); return NULL; }
-        else if (!node->left) { Contact* temp = node->right; free(node); return temp; }
-        else if (!node->right) { Contact* temp = node->left; free(node); return temp; }
+        cacheInvalidate(node->name);   // freed or overwritten by its successor
+        if (!node->left || !node->right) filterDelete();
+        if (!node->left && !node->right) { countedFree(node, sizeof(Contact)); return NULL; }
+        else if (!node->left) { Contact* temp = node->right; countedFree(node, sizeof(Contact)); return temp; }
+        else if (!node->right) { Contact* temp = node->left; countedFree(node, sizeof(Contact)); return temp; }
         else {
             Contact* succ = findMin(node->right);
             strcpy(node->name, succ->name);
             strcpy(node->phone, succ->phone);
             strcpy(node->email, succ->email);
-            node->right = deleteContact(node->right, succ->name);
+            strcpy(node->key, succ->key);
+            node->right = deleteNode(node->right, succ->key, succ->name);
         }
     }
     return node;
 }
 
+Contact* deleteContact(Contact* node, char* name) {
+    char key[NAME_LEN];
+    if (!filterMayContain(name)) return node;
+    makeSortKey(name, key);
+    node = deleteNode(node, key, name);
+    filterMaintain(node);
+    return node;
+}
+
 void freeContacts(Contact* node) {
     if (!node) return;
     freeContacts(node->left);
     freeContacts(node->right);
-    free(node);
+    countedFree(node, sizeof(Contact));
 }
 
 // ------------------- Random Contact Generator -------------------
@@ -104,16 +248,15 @@ Contact generateContact() {
 //     int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
 //     srand(time(NULL));
 
-//     printf("DataStructure,Operation,Contacts,Time_ms\n");
+//     printf("DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes\n");
 
 //     for (int t = 0; t < num_tests; t++) {
 //         int n = test_sizes[t];
 //         freeContacts(root);
 //         root = NULL;
 
-//         Contact temp;
+//         Contact data[n];
 //         Contact* stored[n];
-
 //         // Insert
 //         clock_t start = clock();
 //         for (int i=0;i<n;i++){
@@ -159,46 +302,78 @@ void benchmarkBSTToCSV(const char* filename) {
         return;
     }
 
-    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms\n");
+    fputs(RESULT_CSV_HEADER, fp);
 
     for (int t = 0; t < num_tests; t++) {
         int n = test_sizes[t];
+        resetPeakRSS();
         freeContacts(root);
         root = NULL;
 
-        Contact temp;
+        Contact data[n];
         Contact* stored[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
 
-        // ---------- Insert ----------
-        clock_t start = clock();
+        // ---------- Insert + Search (two descents) ----------
+        clock_t start = startPhase();
         for (int i = 0; i < n; i++) {
-            temp = generateContact();
-            root = insertContact(root, temp.name, temp.phone, temp.email);
-            stored[i] = searchContact(root, temp.name);
+            root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(root, data[i].name);
         }
-        clock_t end = clock();
-        fprintf(fp, "BST,Insert,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "BST,InsertSearch", n, twoPass);
+        freeContacts(root);
+        root = NULL;
+
+        // ---------- Insert (insertIfAbsent, one descent) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            root = insertIfAbsent(root, data[i].name, data[i].phone, data[i].email, &stored[i]);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "BST,Insert", n, onePass);
+        printf("BST %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
 
         // ---------- Search ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             searchContact(root, stored[i]->name);
-        end = clock();
-        fprintf(fp, "BST,Search,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "BST,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Case-insensitive Search ----------
+        char (*folded)[NAME_LEN] = malloc(n * sizeof(*folded));
+        for (int i = 0; i < n; i++) makeSortKey(stored[i]->name, folded[i]);
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            searchContactIgnoreCase(root, folded[i]);
+        end = stopPhase();
+        writeResult(fp, "BST,CaseSearch", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        free(folded);
 
         // ---------- Update ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             updateContact(stored[i]->name, "1234567890", "newemail@test.com");
-        end = clock();
-        fprintf(fp, "BST,Update,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "BST,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            { Contact* c; root = upsertContact(root, stored[i]->name, "0987654321", "upsert@test.com", &c); }
+        end = stopPhase();
+        writeResult(fp, "BST,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
 
         // ---------- Delete ----------
-        start = clock();
+        // Delete by the generated names: deleting a two-child node copies its
+        // successor's fields and frees the successor, so stored[] can dangle
+        start = startPhase();
         for (int i = 0; i < n; i++)
-            root = deleteContact(root, stored[i]->name);
-        end = clock();
-        fprintf(fp, "BST,Delete,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+            root = deleteContact(root, data[i].name);
+        end = stopPhase();
+        writeResult(fp, "BST,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
     }
 
     fclose(fp);
@@ -206,6 +381,208 @@ void benchmarkBSTToCSV(const char* filename) {
 }
 
 
+// ---------------- Front Cache Benchmark ----------------
+// Lookups follow a Zipf distribution (s = 1) over the contacts. Ranks are
+// shuffled so the hot names are spread through the structure rather than
+// sitting in insertion order. Each lookup sequence runs with the cache off
+// and then on; the uniform pair shows what the cache costs without skew.
+#define CACHE_LOOKUPS 100000
+volatile long cacheSink;
+
+// Fill out[] with count indexes in [0, n): Zipf ranks through a random permutation
+void zipfIndexes(int n, int count, int* out) {
+    double* cdf = (double*)malloc(n * sizeof(double));
+    int* perm = (int*)malloc(n * sizeof(int));
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int k = 0; k < count; k++) {
+        double u = (double)rand() / ((double)RAND_MAX + 1) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        out[k] = perm[lo];
+    }
+    free(cdf);
+    free(perm);
+}
+
+void benchmarkFrontCacheToCSV(const char* filename) {
+    int sizes[] = {1000, 10000, 100000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Lookups,Time_ms,Hit_rate," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        freeContacts(root); root = NULL;
+        cacheOn = 0;
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+        }
+        int* zipf = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        int* uniform = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        zipfIndexes(n, CACHE_LOOKUPS, zipf);
+        for (int k = 0; k < CACHE_LOOKUPS; k++) uniform[k] = rand() % n;
+
+        const char* labels[] = {"BST" ",ZipfSearch", "BST" ",CachedZipfSearch",
+                                "BST" ",UniformSearch", "BST" ",CachedUniformSearch"};
+        int* order[] = {zipf, zipf, uniform, uniform};
+        for (int r = 0; r < 4; r++) {
+            cacheOn = r % 2;
+            cacheClear();
+            cacheHits = cacheMisses = 0;
+            clock_t start = startPhase();
+            for (int k = 0; k < CACHE_LOOKUPS; k++)
+                cacheSink += searchContact(root, data[order[r][k]].name) != NULL;
+            clock_t end = stopPhase();
+            double ms = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+            double hitRate = (double)cacheHits / CACHE_LOOKUPS;
+            fprintf(fp, "%s,%d,%d,%.3f,%.4f", labels[r], n, CACHE_LOOKUPS, ms, hitRate);
+            writeCounters(fp, CACHE_LOOKUPS);
+            fputc('\n', fp);
+            printf("%s %d: %.3f ms, hit rate %.1f%%\n", labels[r], n, ms, 100 * hitRate);
+        }
+
+        cacheOn = 0;
+        cacheClear();
+        free(data);
+        free(zipf);
+        free(uniform);
+    }
+
+    fclose(fp);
+    printf("Front cache benchmark written to %s\n", filename);
+}
+
+// ---------------- Membership Filter Benchmark ----------------
+// Each filter mode (off, Bloom, xor) builds the tree from the same contacts,
+// then looks up present names and names that were never inserted. A churn
+// phase deletes half the contacts and inserts as many new ones, which forces
+// rebuilds, before the absent names are looked up again. FP_rate_pct is the
+// share of absent names the filter let through to the tree.
+#define FILTER_LOOKUPS 200000
+volatile long filterSink;
+long phaseRejects, phaseFalsePositives, phaseRebuilds;
+
+clock_t startFilterPhase() {
+    phaseRejects = filterRejects;
+    phaseFalsePositives = filterFalsePositives;
+    phaseRebuilds = filterRebuilds;
+    return startPhase();
+}
+
+// One CSV row, from the filter counters' change over the phase
+void stopFilterPhase(FILE* fp, const char* op, int n, int ops, clock_t start) {
+    clock_t end = stopPhase();
+    double ms = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+    long r = filterRejects - phaseRejects, f = filterFalsePositives - phaseFalsePositives;
+    char rate[16] = "", bits[16] = "";
+    if (filterMode != FILTER_OFF && r + f > 0) snprintf(rate, sizeof(rate), "%.3f", 100.0 * f / (r + f));
+    if (filterMode != FILTER_OFF && filterNames > filterDeletes)
+        snprintf(bits, sizeof(bits), "%.2f", filterBitsPerName());
+    fprintf(fp, "BST,%s,%d,%s,%d,%.3f,%.1f,%s,%s,%ld", op, n, filterModeNames[filterMode], ops, ms,
+            ms * 1e6 / ops, rate, bits, filterRebuilds - phaseRebuilds);
+    writeCounters(fp, ops);
+    fputc('\n', fp);
+    printf("BST %-15s %7d %-5s %10.3f ms %10.1f ns/op  fp %s%%\n", op, n, filterModeNames[filterMode], ms,
+           ms * 1e6 / ops, rate);
+}
+
+void benchmarkFilterToCSV(const char* filename) {
+    int sizes[] = {10000, 100000, 1000000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Filter,Ops,Time_ms,Ns_per_op,FP_rate_pct,Filter_bits_per_contact,Rebuilds," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        Contact* fresh = (Contact*)malloc((n / 2) * sizeof(Contact));
+        Contact* absent = (Contact*)malloc(FILTER_LOOKUPS * sizeof(Contact));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+        for (int i = 0; i < n / 2; i++) fresh[i] = generateContact();
+        for (int k = 0; k < FILTER_LOOKUPS; k++) absent[k] = generateContact();
+
+        for (int mode = FILTER_OFF; mode <= FILTER_XOR; mode++) {
+            freeContacts(root); root = NULL;
+            filterSetMode(root, mode);
+            filterRejects = filterPasses = filterFalsePositives = filterRebuilds = 0;
+
+            // ---------- Insert (filter kept up to date, with its rebuilds) ----------
+            clock_t start = startFilterPhase();
+            for (int i = 0; i < n; i++) root = insertContact(root, data[i].name, data[i].phone, data[i].email);
+            stopFilterPhase(fp, "Insert", n, n, start);
+
+            // ---------- Lookups of present names (the filter's cost) ----------
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(root, data[k % n].name) != NULL;
+            stopFilterPhase(fp, "SearchHit", n, FILTER_LOOKUPS, start);
+
+            // ---------- Lookups of absent names (dedupe checks) ----------
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(root, absent[k].name) != NULL;
+            stopFilterPhase(fp, "SearchMiss", n, FILTER_LOOKUPS, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) updateContact(absent[k].name, "1234567890", "miss@test.com");
+            stopFilterPhase(fp, "UpdateMiss", n, FILTER_LOOKUPS, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) root = deleteContact(root, absent[k].name);
+            stopFilterPhase(fp, "DeleteMiss", n, FILTER_LOOKUPS, start);
+
+            // ---------- Churn: half the names replaced ----------
+            start = startFilterPhase();
+            for (int i = 0; i < n / 2; i++) {
+                root = deleteContact(root, data[2 * i].name);
+                root = insertContact(root, fresh[i].name, fresh[i].phone, fresh[i].email);
+            }
+            stopFilterPhase(fp, "Churn", n, n / 2 * 2, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(root, absent[k].name) != NULL;
+            stopFilterPhase(fp, "ChurnSearchMiss", n, FILTER_LOOKUPS, start);
+        }
+
+        freeContacts(root); root = NULL;
+        filterSetMode(root, FILTER_OFF);
+        free(data);
+        free(fresh);
+        free(absent);
+    }
+
+    fclose(fp);
+    printf("Membership filter benchmark written to %s\n", filename);
+}
+
 // ------------------- Display Contacts (In-order) -------------------
 void displayContacts(Contact* node) {
     if (node != NULL) {
@@ -217,15 +594,23 @@ void displayContacts(Contact* node) {
 }
 
 // ------------------- Main Menu -------------------
-int main() {
+int main(int argc, char** argv) {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
     srand(time(NULL));
+    cacheClear();
+
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchmarkBSTToCSV(argc > 2 ? argv[2] : "performance_bst.csv");
+        return 0;
+    }
 
     while(1){
         printf("\nContact Management System (BST)\n");
         printf("1. Insert Contact\n2. Search Contact\n3. Update Contact\n4. Delete Contact\n");
         printf("5. Display Contacts\n6. Benchmark Performance\n7. Exit\n");
+        printf("8. Front Cache Benchmark\n9. Membership Filter Benchmark\n");
         printf("Enter your choice: ");
         scanf("%d",&choice);
         getchar();
@@ -272,6 +657,12 @@ int main() {
                 freeContacts(root);
                 printf("Exiting...\n");
                 exit(0);
+            case 8:
+                benchmarkFrontCacheToCSV("performance_cache_bst.csv");
+                break;
+            case 9:
+                benchmarkFilterToCSV("performance_filter_bst.csv");
+                break;
             default:
                 printf("Invalid choice!\n");
         }
@@ -0,0 +1,129 @@
+// Front cache: a small CLOCK cache in front of a search, mapping a name hash
+// to its Contact*, so hot names skip the walk from the head or root. Used by
+// the linked list, the BST and the AVL tree.
+//
+// Include it where the Contact type (with its name field) is defined. The
+// program keeps the entries valid: updates change contacts in place, and any
+// contact a delete frees or overwrites is dropped with cacheInvalidate first,
+// so an entry never points at a stale node. cacheClear must run before the
+// first lookup. The cache starts on unless CACHE_DEFAULT_ON is defined as 0
+// before the include.
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdio.h>
+#include <string.h>
+
+#define CACHE_SLOTS 1024   // power of two, 24 bytes per entry
+
+#ifndef CACHE_DEFAULT_ON
+#define CACHE_DEFAULT_ON 1
+#endif
+
+typedef struct {
+    Contact* contact;    // NULL when the slot is empty
+    unsigned int hash;
+    int next;            // next slot in the same bucket, -1 at the end
+    int ref;             // CLOCK reference bit, set on every hit
+} CacheSlot;
+
+static CacheSlot cacheSlots[CACHE_SLOTS];
+static int cacheBuckets[CACHE_SLOTS];   // first slot per bucket, -1 when empty
+static int cacheHand = 0;
+static int cacheOn = CACHE_DEFAULT_ON;
+static long cacheHits = 0, cacheMisses = 0;
+
+// FNV-1a hash of a name
+static inline unsigned int nameHash(const char* s) {
+    unsigned int h = 2166136261u;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Empty the cache (counters are kept)
+static inline void cacheClear(void) {
+    for (int i = 0; i < CACHE_SLOTS; i++) {
+        cacheSlots[i].contact = NULL;
+        cacheBuckets[i] = -1;
+    }
+    cacheHand = 0;
+}
+
+// Slot holding name, or -1
+static inline int cacheFind(const char* name, unsigned int h) {
+    for (int i = cacheBuckets[h & (CACHE_SLOTS - 1)]; i >= 0; i = cacheSlots[i].next) {
+        if (cacheSlots[i].hash == h && strcmp(cacheSlots[i].contact->name, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Cached contact for name, or NULL on a miss; *h gets the hash for cacheAdmit
+static inline Contact* cacheLookup(const char* name, unsigned int* h) {
+    *h = nameHash(name);
+    int slot = cacheFind(name, *h);
+    if (slot < 0) {
+        cacheMisses++;
+        return NULL;
+    }
+    cacheHits++;
+    cacheSlots[slot].ref = 1;
+    return cacheSlots[slot].contact;
+}
+
+// Remove a filled slot from its bucket chain and mark it empty
+static inline void cacheUnlink(int slot) {
+    int* link = &cacheBuckets[cacheSlots[slot].hash & (CACHE_SLOTS - 1)];
+    while (*link != slot) {
+        link = &cacheSlots[*link].next;
+    }
+    *link = cacheSlots[slot].next;
+    cacheSlots[slot].contact = NULL;
+}
+
+// Add a contact found by a missed lookup. The hand sweeps the slots, giving
+// referenced entries a second chance (clearing their bit) until it reaches
+// an empty or unreferenced slot to reuse.
+static inline void cacheAdmit(Contact* c, unsigned int h) {
+    while (cacheSlots[cacheHand].contact != NULL && cacheSlots[cacheHand].ref) {
+        cacheSlots[cacheHand].ref = 0;
+        cacheHand = (cacheHand + 1) & (CACHE_SLOTS - 1);
+    }
+    int slot = cacheHand;
+    cacheHand = (cacheHand + 1) & (CACHE_SLOTS - 1);
+    if (cacheSlots[slot].contact != NULL) {
+        cacheUnlink(slot);
+    }
+    cacheSlots[slot].contact = c;
+    cacheSlots[slot].hash = h;
+    cacheSlots[slot].ref = 0;
+    cacheSlots[slot].next = cacheBuckets[h & (CACHE_SLOTS - 1)];
+    cacheBuckets[h & (CACHE_SLOTS - 1)] = slot;
+}
+
+// Drop the entry for name, if cached (the cache is emptied when turned off)
+static inline void cacheInvalidate(const char* name) {
+    if (!cacheOn) return;
+    int slot = cacheFind(name, nameHash(name));
+    if (slot >= 0) {
+        cacheUnlink(slot);
+    }
+}
+
+// Print hit/miss counters and occupancy
+static inline void displayCacheStats(void) {
+    int used = 0;
+    for (int i = 0; i < CACHE_SLOTS; i++) {
+        if (cacheSlots[i].contact != NULL) used++;
+    }
+    long lookups = cacheHits + cacheMisses;
+    printf("Front cache %s: %d/%d entries, %ld hits, %ld misses, hit rate %.1f%%\n",
+           cacheOn ? "on" : "off", used, CACHE_SLOTS, cacheHits, cacheMisses,
+           lookups > 0 ? 100.0 * cacheHits / lookups : 0.0);
+}
+
+#endif
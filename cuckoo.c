@@ -0,0 +1,390 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+#define SLOTS 4            // contacts per bucket
+#define MIN_BUCKETS 16     // power of two
+#define MAX_KICKS 500      // longest displacement path one insert may take
+#define STASH_SIZE 8       // contacts that found no bucket; a full stash grows the table
+
+// Bucketized cuckoo hashing: every contact lives in one of its two buckets
+// of SLOTS slots, or in a small stash. A lookup therefore reads at most two
+// 64-byte buckets (plus the stash while it is not empty) and compares names
+// only where the slot's 8-bit tag matches, whatever the load. The buckets
+// come from independent halves of one 64-bit hash; a displaced contact's
+// name is hashed again to find its other bucket. (Deriving that bucket from
+// the tag alone, as cuckoo filters do, would leave only 255 alternatives per
+// bucket, which caps the load of large tables.) Random-walk insertion with
+// up to 500 kicks fills about 96% of the slots before the stash overflows.
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+} Contact;
+
+typedef struct __attribute__((aligned(64))) {
+    unsigned char tag[SLOTS];   // 0 = empty slot
+    Contact* slot[SLOTS];
+} Bucket;
+
+Bucket* table = NULL;
+unsigned int bucketMask = 0;
+Contact* stash[STASH_SIZE];
+int stashCount = 0;
+long contactCount = 0;
+long kicks = 0;              // displacements since the start
+int longestPath = 0;         // longest displacement path of one insert
+int grows = 0;
+unsigned int kickSeed = 2463534242u;
+
+// FNV-1a with a final mix, so the tag (top byte) is as random as the bucket bits
+unsigned long long hashName(const char* s) {
+    unsigned long long h = 14695981039346656037ULL;
+    while (*s) h = (h ^ (unsigned char)*s++) * 1099511628211ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+unsigned char tagOf(unsigned long long h) {
+    unsigned char tag = (unsigned char)(h >> 56);
+    return tag ? tag : 1;
+}
+
+// The two buckets come from independent bits of the hash
+unsigned int firstBucket(unsigned long long h) { return (unsigned int)h & bucketMask; }
+unsigned int secondBucket(unsigned long long h) { return (unsigned int)(h >> 32) & bucketMask; }
+
+// The bucket of c other than b
+unsigned int altBucket(unsigned int b, Contact* c) {
+    unsigned long long h = hashName(c->name);
+    return firstBucket(h) == b ? secondBucket(h) : firstBucket(h);
+}
+
+void initTable(unsigned int buckets) {
+    table = (Bucket*)aligned_alloc(64, buckets * sizeof(Bucket));
+    memset(table, 0, buckets * sizeof(Bucket));
+    bucketMask = buckets - 1;
+    stashCount = 0;
+}
+
+// Create new contact
+Contact* createContact(char* name, char* phone, char* email) {
+    Contact* newContact = (Contact*)malloc(sizeof(Contact));
+    strcpy(newContact->name, name);
+    strcpy(newContact->phone, phone);
+    strcpy(newContact->email, email);
+    return newContact;
+}
+
+// Slot index of name in *bucket, or in the stash when *bucket is NULL; -1 if absent
+int findContact(const char* name, Bucket** bucket) {
+    unsigned long long h = hashName(name);
+    unsigned char tag = tagOf(h);
+    unsigned int b = firstBucket(h);
+    for (int pass = 0; pass < 2; pass++, b = secondBucket(h)) {
+        Bucket* bk = &table[b];
+        for (int i = 0; i < SLOTS; i++) {
+            if (bk->tag[i] == tag && strcmp(bk->slot[i]->name, name) == 0) {
+                *bucket = bk;
+                return i;
+            }
+        }
+    }
+    *bucket = NULL;
+    for (int i = 0; i < stashCount; i++)
+        if (strcmp(stash[i]->name, name) == 0) return i;
+    return -1;
+}
+
+// Put c in a free slot of bucket b; 0 if the bucket is full
+int putInBucket(unsigned int b, unsigned char tag, Contact* c) {
+    Bucket* bk = &table[b];
+    for (int i = 0; i < SLOTS; i++) {
+        if (bk->tag[i] == 0) {
+            bk->tag[i] = tag;
+            bk->slot[i] = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// xorshift32, for the victim slot of each kick
+unsigned int kickRandom() {
+    kickSeed ^= kickSeed << 13;
+    kickSeed ^= kickSeed >> 17;
+    kickSeed ^= kickSeed << 5;
+    return kickSeed;
+}
+
+// Store c in one of its buckets. When both are full, a random slot's contact
+// is evicted to its other bucket, and so on for at most MAX_KICKS steps; the
+// contact still homeless after that goes to the stash. Returns 0, with
+// nothing moved, only when the stash is full (the table must grow).
+int placeContact(Contact* c) {
+    unsigned long long h = hashName(c->name);
+    unsigned char tag = tagOf(h);
+    unsigned int b = firstBucket(h);
+    if (putInBucket(b, tag, c) || putInBucket(secondBucket(h), tag, c)) return 1;
+    if (stashCount == STASH_SIZE) return 0;
+
+    if (kickRandom() & 1) b = secondBucket(h);
+    for (int k = 1; k <= MAX_KICKS; k++) {
+        Bucket* bk = &table[b];
+        int i = kickRandom() % SLOTS;
+        Contact* victim = bk->slot[i];
+        unsigned char victimTag = bk->tag[i];
+        bk->slot[i] = c;
+        bk->tag[i] = tag;
+        c = victim;
+        tag = victimTag;
+        b = altBucket(b, c);
+        kicks++;
+        if (putInBucket(b, tag, c)) {
+            if (k > longestPath) longestPath = k;
+            return 1;
+        }
+    }
+    longestPath = MAX_KICKS;
+    stash[stashCount++] = c;
+    return 1;
+}
+
+// Rehash into a table twice the size (doubling again in the unlikely case
+// that the contacts do not fit)
+void growTable() {
+    Bucket* old = table;
+    unsigned int oldBuckets = bucketMask + 1, buckets = oldBuckets * 2;
+    Contact* oldStash[STASH_SIZE];
+    int oldStashCount = stashCount;
+    memcpy(oldStash, stash, sizeof(stash));
+
+    for (;;) {
+        int ok = 1;
+        initTable(buckets);
+        for (unsigned int b = 0; b < oldBuckets && ok; b++)
+            for (int i = 0; i < SLOTS && ok; i++)
+                if (old[b].tag[i] != 0) ok = placeContact(old[b].slot[i]);
+        for (int i = 0; i < oldStashCount && ok; i++) ok = placeContact(oldStash[i]);
+        if (ok) break;
+        free(table);
+        buckets *= 2;
+    }
+    free(old);
+    grows++;
+}
+
+// Move stashed contacts back to their buckets where a slot has come free
+void drainStash() {
+    for (int i = 0; i < stashCount; ) {
+        unsigned long long h = hashName(stash[i]->name);
+        unsigned char tag = tagOf(h);
+        if (putInBucket(firstBucket(h), tag, stash[i]) || putInBucket(secondBucket(h), tag, stash[i]))
+            stash[i] = stash[--stashCount];
+        else
+            i++;
+    }
+}
+
+// Find a contact or insert it; *created tells which
+Contact* insertIfAbsent(char* name, char* phone, char* email, int* created) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    *created = 0;
+    if (i >= 0) return bk ? bk->slot[i] : stash[i];
+    Contact* c = createContact(name, phone, email);
+    while (!placeContact(c)) growTable();
+    contactCount++;
+    *created = 1;
+    return c;
+}
+
+// Insert contact
+void insertContact(char* name, char* phone, char* email) {
+    int created;
+    insertIfAbsent(name, phone, email, &created);
+    if (created)
+        printf("Contact added: %s\n", name);
+    else
+        printf("Contact already exists!\n");
+}
+
+// Insert a contact or overwrite an existing one, with one lookup
+Contact* upsertContact(char* name, char* phone, char* email) {
+    int created;
+    Contact* c = insertIfAbsent(name, phone, email, &created);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    printf("Contact saved: %s\n", name);
+    return c;
+}
+
+// Search by name
+Contact* searchContact(char* name) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    if (i < 0) return NULL;
+    return bk ? bk->slot[i] : stash[i];
+}
+
+// Update contact
+void updateContact(char* name, char* newPhone, char* newEmail) {
+    Contact* c = searchContact(name);
+    if (c == NULL) {
+        printf("Contact not found.\n");
+        return;
+    }
+    if (newPhone != NULL) strcpy(c->phone, newPhone);
+    if (newEmail != NULL) strcpy(c->email, newEmail);
+    printf("Contact updated: %s\n", name);
+}
+
+// Delete contact
+void deleteContact(char* name) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    if (i < 0) {
+        printf("Contact not found.\n");
+        return;
+    }
+    Contact* c;
+    if (bk) {
+        c = bk->slot[i];
+        bk->tag[i] = 0;
+        bk->slot[i] = NULL;
+    } else {
+        c = stash[i];
+        stash[i] = stash[--stashCount];
+    }
+    free(c);
+    contactCount--;
+    if (stashCount > 0) drainStash();
+    printf("Contact deleted: %s\n", name);
+}
+
+// Display contacts (bucket order, then the stash)
+void displayContacts() {
+    for (unsigned int b = 0; b <= bucketMask; b++)
+        for (int i = 0; i < SLOTS; i++)
+            if (table[b].tag[i] != 0)
+                printf("Name: %s | Phone: %s | Email: %s\n", table[b].slot[i]->name,
+                       table[b].slot[i]->phone, table[b].slot[i]->email);
+    for (int i = 0; i < stashCount; i++)
+        printf("Name: %s | Phone: %s | Email: %s\n", stash[i]->name, stash[i]->phone, stash[i]->email);
+}
+
+void displayStats() {
+    unsigned int buckets = bucketMask + 1;
+    printf("Contacts: %ld | Buckets: %u x %d slots | Load: %.1f%%\n", contactCount, buckets, SLOTS,
+           100.0 * contactCount / ((double)buckets * SLOTS));
+    printf("Stash: %d/%d | Kicks: %ld | Longest kick path: %d | Grows: %d\n", stashCount, STASH_SIZE,
+           kicks, longestPath, grows);
+}
+
+// Free memory
+void freeContacts() {
+    for (unsigned int b = 0; b <= bucketMask; b++)
+        for (int i = 0; i < SLOTS; i++)
+            if (table[b].tag[i] != 0) free(table[b].slot[i]);
+    for (int i = 0; i < stashCount; i++) free(stash[i]);
+    free(table);
+    table = NULL;
+    contactCount = 0;
+}
+
+// Menu-driven program
+int main() {
+    int choice;
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    initTable(MIN_BUCKETS);
+    traceOpenFromEnv();
+
+    while (1) {
+        printf("\nContact Management System (Cuckoo Hash)\n");
+        printf("1. Insert Contact\n");
+        printf("2. Search Contact\n");
+        printf("3. Update Contact\n");
+        printf("4. Delete Contact\n");
+        printf("5. Display All Contacts\n");
+        printf("6. Exit\n");
+        printf("7. Show Table Statistics\n");
+        printf("8. Insert or Update Contact\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        getchar(); // consume newline
+
+        switch (choice) {
+            case 1:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
+                insertContact(name, phone, email);
+                break;
+            case 2:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
+                    Contact* c = searchContact(name);
+                    if (c != NULL)
+                        printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
+            case 3:
+                printf("Enter Name to Update: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter New Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter New Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
+                updateContact(name, phone, email);
+                break;
+            case 4:
+                printf("Enter Name to Delete: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
+                deleteContact(name);
+                break;
+            case 5:
+                if (contactCount == 0)
+                    printf("No contacts available.\n");
+                else
+                    displayContacts();
+                break;
+            case 6:
+                freeContacts();
+                printf("Exiting...\n");
+                traceClose();
+                exit(0);
+            case 7:
+                displayStats();
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
+            default:
+                printf("Invalid choice! Try again.\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,661 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "perfcount.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+#define SLOTS 4            // contacts per bucket
+#define MIN_BUCKETS 16     // power of two
+#define MAX_KICKS 500      // longest displacement path one insert may take
+#define STASH_SIZE 8       // contacts that found no bucket; a full stash grows the table
+#define TAIL_SLOTS (1 << 21)   // slots per table in the tail latency benchmark
+
+// Bucketized cuckoo hash (see cuckoo.c): two candidate 64-byte buckets of
+// SLOTS tagged slots per contact, plus a small stash
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+} Contact;
+
+typedef struct __attribute__((aligned(64))) {
+    unsigned char tag[SLOTS];   // 0 = empty slot
+    Contact* slot[SLOTS];
+} Bucket;
+
+Bucket* table = NULL;
+unsigned int bucketMask = 0;
+Contact* stash[STASH_SIZE];
+int stashCount = 0;
+long contactCount = 0;
+long kicks = 0;
+int longestPath = 0;
+int grows = 0;
+unsigned int kickSeed = 2463534242u;
+
+
+double wallMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// ---------------- Cuckoo Hash Table ----------------
+long probes = 0;   // buckets (or stash) read by lookups, for the tail benchmark
+
+// FNV-1a with a final mix, so the tag (top byte) is as random as the bucket bits
+unsigned long long hashName(const char* s) {
+    unsigned long long h = 14695981039346656037ULL;
+    while (*s) h = (h ^ (unsigned char)*s++) * 1099511628211ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+unsigned char tagOf(unsigned long long h) {
+    unsigned char tag = (unsigned char)(h >> 56);
+    return tag ? tag : 1;
+}
+
+// The two buckets come from independent bits of the hash
+unsigned int firstBucket(unsigned long long h) { return (unsigned int)h & bucketMask; }
+unsigned int secondBucket(unsigned long long h) { return (unsigned int)(h >> 32) & bucketMask; }
+
+// The bucket of c other than b
+unsigned int altBucket(unsigned int b, Contact* c) {
+    unsigned long long h = hashName(c->name);
+    return firstBucket(h) == b ? secondBucket(h) : firstBucket(h);
+}
+
+void initTable(unsigned int buckets) {
+    table = (Bucket*)countedAlignedAlloc(buckets * sizeof(Bucket));
+    memset(table, 0, buckets * sizeof(Bucket));
+    bucketMask = buckets - 1;
+    stashCount = 0;
+}
+
+Contact* createContact(char* name, char* phone, char* email) {
+    Contact* newContact = (Contact*)countedMalloc(sizeof(Contact));
+    strcpy(newContact->name, name);
+    strcpy(newContact->phone, phone);
+    strcpy(newContact->email, email);
+    return newContact;
+}
+
+// Slot index of name in *bucket, or in the stash when *bucket is NULL; -1 if absent
+int findContact(const char* name, Bucket** bucket) {
+    unsigned long long h = hashName(name);
+    unsigned char tag = tagOf(h);
+    unsigned int b = firstBucket(h);
+    for (int pass = 0; pass < 2; pass++, b = secondBucket(h)) {
+        Bucket* bk = &table[b];
+        probes++;
+        for (int i = 0; i < SLOTS; i++) {
+            if (bk->tag[i] == tag && strcmp(bk->slot[i]->name, name) == 0) {
+                *bucket = bk;
+                return i;
+            }
+        }
+    }
+    *bucket = NULL;
+    if (stashCount > 0) probes++;
+    for (int i = 0; i < stashCount; i++)
+        if (strcmp(stash[i]->name, name) == 0) return i;
+    return -1;
+}
+
+int putInBucket(unsigned int b, unsigned char tag, Contact* c) {
+    Bucket* bk = &table[b];
+    for (int i = 0; i < SLOTS; i++) {
+        if (bk->tag[i] == 0) {
+            bk->tag[i] = tag;
+            bk->slot[i] = c;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// xorshift32, for the victim slot of each kick
+unsigned int kickRandom() {
+    kickSeed ^= kickSeed << 13;
+    kickSeed ^= kickSeed >> 17;
+    kickSeed ^= kickSeed << 5;
+    return kickSeed;
+}
+
+// Random-walk displacement of at most MAX_KICKS steps, leftover to the stash;
+// 0 (nothing moved) only when the stash is full
+int placeContact(Contact* c) {
+    unsigned long long h = hashName(c->name);
+    unsigned char tag = tagOf(h);
+    unsigned int b = firstBucket(h);
+    if (putInBucket(b, tag, c) || putInBucket(secondBucket(h), tag, c)) return 1;
+    if (stashCount == STASH_SIZE) return 0;
+
+    if (kickRandom() & 1) b = secondBucket(h);
+    for (int k = 1; k <= MAX_KICKS; k++) {
+        Bucket* bk = &table[b];
+        int i = kickRandom() % SLOTS;
+        Contact* victim = bk->slot[i];
+        unsigned char victimTag = bk->tag[i];
+        bk->slot[i] = c;
+        bk->tag[i] = tag;
+        c = victim;
+        tag = victimTag;
+        b = altBucket(b, c);
+        kicks++;
+        if (putInBucket(b, tag, c)) {
+            if (k > longestPath) longestPath = k;
+            return 1;
+        }
+    }
+    longestPath = MAX_KICKS;
+    stash[stashCount++] = c;
+    return 1;
+}
+
+void growTable() {
+    Bucket* old = table;
+    unsigned int oldBuckets = bucketMask + 1, buckets = oldBuckets * 2;
+    Contact* oldStash[STASH_SIZE];
+    int oldStashCount = stashCount;
+    memcpy(oldStash, stash, sizeof(stash));
+
+    for (;;) {
+        int ok = 1;
+        initTable(buckets);
+        for (unsigned int b = 0; b < oldBuckets && ok; b++)
+            for (int i = 0; i < SLOTS && ok; i++)
+                if (old[b].tag[i] != 0) ok = placeContact(old[b].slot[i]);
+        for (int i = 0; i < oldStashCount && ok; i++) ok = placeContact(oldStash[i]);
+        if (ok) break;
+        countedFree(table, buckets * sizeof(Bucket));
+        buckets *= 2;
+    }
+    countedFree(old, oldBuckets * sizeof(Bucket));
+    grows++;
+}
+
+void drainStash() {
+    for (int i = 0; i < stashCount; ) {
+        unsigned long long h = hashName(stash[i]->name);
+        unsigned char tag = tagOf(h);
+        if (putInBucket(firstBucket(h), tag, stash[i]) || putInBucket(secondBucket(h), tag, stash[i]))
+            stash[i] = stash[--stashCount];
+        else
+            i++;
+    }
+}
+
+// ---------------- Core Operations ----------------
+Contact* insertIfAbsent(char* name, char* phone, char* email) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    if (i >= 0) return bk ? bk->slot[i] : stash[i];
+    Contact* c = createContact(name, phone, email);
+    while (!placeContact(c)) growTable();
+    contactCount++;
+    return c;
+}
+
+void insertContact(char* name, char* phone, char* email) {
+    insertIfAbsent(name, phone, email);
+}
+
+Contact* upsertContact(char* name, char* phone, char* email) {
+    Contact* contact = insertIfAbsent(name, phone, email);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    return contact;
+}
+
+Contact* searchContact(char* name) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    if (i < 0) return NULL;
+    return bk ? bk->slot[i] : stash[i];
+}
+
+void updateContact(char* name, char* newPhone, char* newEmail) {
+    Contact* contact = searchContact(name);
+    if (contact == NULL) return;
+    if (newPhone != NULL) strcpy(contact->phone, newPhone);
+    if (newEmail != NULL) strcpy(contact->email, newEmail);
+}
+
+void deleteContact(char* name) {
+    Bucket* bk;
+    int i = findContact(name, &bk);
+    if (i < 0) return;
+    Contact* c;
+    if (bk) {
+        c = bk->slot[i];
+        bk->tag[i] = 0;
+        bk->slot[i] = NULL;
+    } else {
+        c = stash[i];
+        stash[i] = stash[--stashCount];
+    }
+    countedFree(c, sizeof(Contact));
+    contactCount--;
+    if (stashCount > 0) drainStash();
+}
+
+void displayContacts() {
+    printf("\n--- Contact List ---\n");
+    for (unsigned int b = 0; b <= bucketMask; b++)
+        for (int i = 0; i < SLOTS; i++)
+            if (table[b].tag[i] != 0)
+                printf("Name: %s | Phone: %s | Email: %s\n", table[b].slot[i]->name,
+                       table[b].slot[i]->phone, table[b].slot[i]->email);
+    for (int i = 0; i < stashCount; i++)
+        printf("Name: %s | Phone: %s | Email: %s\n", stash[i]->name, stash[i]->phone, stash[i]->email);
+    if (contactCount == 0) printf("No contacts available.\n");
+    printf("---------------------\n");
+}
+
+// Free every contact and the table; initTable must follow
+void freeContacts() {
+    if (table == NULL) return;
+    for (unsigned int b = 0; b <= bucketMask; b++)
+        for (int i = 0; i < SLOTS; i++)
+            if (table[b].tag[i] != 0) countedFree(table[b].slot[i], sizeof(Contact));
+    for (int i = 0; i < stashCount; i++) countedFree(stash[i], sizeof(Contact));
+    countedFree(table, (bucketMask + 1) * sizeof(Bucket));
+    table = NULL;
+    stashCount = 0;
+    contactCount = 0;
+}
+
+// ---------------- Test Data ----------------
+void randomString(char *str, int length) {
+    static const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for (int i = 0; i < length - 1; i++)
+        str[i] = charset[rand() % (sizeof(charset) - 1)];
+    str[length - 1] = '\0';
+}
+
+Contact generateContact() {
+    Contact c;
+    randomString(c.name, 10);
+    randomString(c.phone, 10);
+    randomString(c.email, 15);
+    return c;
+}
+
+// ---------------- Benchmark (Cuckoo Hash to CSV) ----------------
+void benchmarkCuckooToCSV(const char* filename) {
+    int test_sizes[] = {100, 500, 1000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        resetPeakRSS();
+        freeContacts();  // start fresh
+        initTable(MIN_BUCKETS);
+
+        Contact data[n];
+        Contact* stored[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        // ---------- Insert + Search (two lookups) ----------
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++) {
+            insertContact(data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(data[i].name);
+        }
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "Cuckoo,InsertSearch", n, twoPass);
+        freeContacts();
+        initTable(MIN_BUCKETS);
+
+        // ---------- Insert (insertIfAbsent, one lookup) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            stored[i] = insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "Cuckoo,Insert", n, onePass);
+        printf("Cuckoo %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
+
+        // ---------- Search ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            searchContact(stored[i]->name);
+        end = stopPhase();
+        writeResult(fp, "Cuckoo,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Update ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            updateContact(stored[i]->name, "1234567890", "newemail@test.com");
+        end = stopPhase();
+        writeResult(fp, "Cuckoo,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            upsertContact(stored[i]->name, "0987654321", "upsert@test.com");
+        end = stopPhase();
+        writeResult(fp, "Cuckoo,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Delete ----------
+        // Contacts are freed as they go, so delete by the generated names
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            deleteContact(data[i].name);
+        end = stopPhase();
+        writeResult(fp, "Cuckoo,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+    }
+
+    fclose(fp);
+    printf("Cuckoo hash benchmark written to %s\n", filename);
+}
+
+// ---------------- Comparison Tables (tail latency benchmark) ----------------
+// The chained table of hashmap.c (djb2 over a prime number of buckets, new
+// contacts at the head of their chain) and a linear-probing table of
+// contact pointers (FNV-1a, as the array's name index), rebuilt here so the
+// three tables can be given the same number of slots.
+typedef struct ChainContact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct ChainContact* next;
+} ChainContact;
+
+ChainContact** chainTable = NULL;
+unsigned int chainSize = 0;
+Contact** probeTable = NULL;
+unsigned int probeMask = 0;
+
+unsigned long djb2(const char* str) {
+    unsigned long hash = 5381;
+    int c;
+    while ((c = *str++))
+        hash = ((hash << 5) + hash) + c; // hash * 33 + c
+    return hash;
+}
+
+unsigned int fnv32(const char* s) {
+    unsigned int h = 2166136261u;
+    while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+// Smallest prime >= n
+unsigned int nextPrime(unsigned int n) {
+    if (n < 3) return 3;
+    for (n |= 1; ; n += 2) {
+        int prime = 1;
+        for (unsigned int d = 3; d * d <= n; d += 2)
+            if (n % d == 0) { prime = 0; break; }
+        if (prime) return n;
+    }
+}
+
+void chainInsert(Contact* c) {
+    unsigned int b = djb2(c->name) % chainSize;
+    ChainContact* node = (ChainContact*)countedMalloc(sizeof(ChainContact));
+    strcpy(node->name, c->name);
+    strcpy(node->phone, c->phone);
+    strcpy(node->email, c->email);
+    node->next = chainTable[b];
+    chainTable[b] = node;
+}
+
+ChainContact* chainSearch(const char* name) {
+    ChainContact* node = chainTable[djb2(name) % chainSize];
+    probes++;   // bucket head
+    for (; node != NULL; node = node->next) {
+        probes++;
+        if (strcmp(node->name, name) == 0) return node;
+    }
+    return NULL;
+}
+
+void chainFree() {
+    for (unsigned int b = 0; b < chainSize; b++) {
+        ChainContact* node = chainTable[b];
+        while (node != NULL) {
+            ChainContact* next = node->next;
+            countedFree(node, sizeof(ChainContact));
+            node = next;
+        }
+    }
+    countedFree(chainTable, chainSize * sizeof(ChainContact*));
+    chainTable = NULL;
+}
+
+void probeInsert(Contact* c) {
+    unsigned int i = fnv32(c->name) & probeMask;
+    while (probeTable[i] != NULL) i = (i + 1) & probeMask;
+    probeTable[i] = createContact(c->name, c->phone, c->email);
+}
+
+Contact* probeSearch(const char* name) {
+    for (unsigned int i = fnv32(name) & probeMask; ; i = (i + 1) & probeMask) {
+        probes++;
+        if (probeTable[i] == NULL) return NULL;
+        if (strcmp(probeTable[i]->name, name) == 0) return probeTable[i];
+    }
+}
+
+void probeFree() {
+    for (unsigned int i = 0; i <= probeMask; i++)
+        if (probeTable[i] != NULL) countedFree(probeTable[i], sizeof(Contact));
+    countedFree(probeTable, (probeMask + 1) * sizeof(Contact*));
+    probeTable = NULL;
+}
+
+// ---------------- Benchmark (Tail Latency to CSV) ----------------
+// Cuckoo, chained and linear-probing tables with TAIL_SLOTS slots each
+// (chained: buckets) are filled to the same load, then every contact is
+// looked up once in random order (Search) and as many absent names are
+// looked up (SearchMiss). Each lookup is timed on its own. Probes count the
+// table positions read before the answer: buckets (and the stash) for
+// cuckoo, the bucket head and chain nodes for chaining, slots for probing.
+enum { TABLE_CUCKOO, TABLE_CHAINED, TABLE_PROBING, NUM_TABLES };
+const char* tableNames[NUM_TABLES] = {"Cuckoo", "Chained", "OpenAddressing"};
+
+int compareLatency(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+void writeTailRow(FILE* fp, const char* label, int n, double load, unsigned int* ns, int count,
+                  double ms, long totalProbes, long maxProbes) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) sum += ns[i];
+    qsort(ns, count, sizeof(unsigned int), compareLatency);
+    fprintf(fp, "%s,%d,%.1f,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%ld,%.1f\n", label, n, load, count, ms,
+            sum / count / 1000.0, ns[(long)count / 2] / 1000.0, ns[(long)count * 99 / 100] / 1000.0,
+            ns[(long)count * 999 / 1000] / 1000.0, ns[(long)count * 9999 / 10000] / 1000.0,
+            ns[count - 1] / 1000.0, (double)totalProbes / count, maxProbes, (double)liveBytes / n);
+    printf("%-30s load %4.1f%%: p99.99 %6.2f us, max %7.2f us, probes avg %.2f max %ld\n", label, load,
+           ns[(long)count * 9999 / 10000] / 1000.0, ns[count - 1] / 1000.0, (double)totalProbes / count,
+           maxProbes);
+}
+
+void benchmarkTailToCSV(const char* filename) {
+    int loads[] = {50, 75, 90, 95};
+    int num_loads = sizeof(loads)/sizeof(loads[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Load_pct,Lookups,Time_ms,Avg_us,P50_us,P99_us,P999_us,P9999_us,Max_us,Avg_probes,Max_probes,Bytes_per_contact\n");
+    freeContacts();
+
+    for (int l = 0; l < num_loads; l++) {
+        int n = (int)((long)TAIL_SLOTS * loads[l] / 100);
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        char (*missing)[NAME_LEN] = malloc((size_t)n * NAME_LEN);
+        int* order = (int*)malloc(n * sizeof(int));
+        unsigned int* ns = (unsigned int*)malloc(n * sizeof(unsigned int));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            randomString(missing[i], 11);   // one letter longer: never a stored name
+            order[i] = i;
+        }
+        for (int i = n - 1; i > 0; i--) {
+            int j = rand() % (i + 1);
+            int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+        }
+
+        for (int s = 0; s < NUM_TABLES; s++) {
+            double load = 100.0 * n / TAIL_SLOTS;
+            if (s == TABLE_CUCKOO) {
+                initTable(TAIL_SLOTS / SLOTS);
+                grows = 0;
+                for (int i = 0; i < n; i++) insertContact(data[i].name, data[i].phone, data[i].email);
+                load = 100.0 * n / ((bucketMask + 1.0) * SLOTS);
+                if (grows > 0) printf("Cuckoo grew %d times at %d%% load\n", grows, loads[l]);
+            } else if (s == TABLE_CHAINED) {
+                chainSize = nextPrime(TAIL_SLOTS);
+                chainTable = (ChainContact**)countedCalloc(chainSize, sizeof(ChainContact*));
+                for (int i = 0; i < n; i++) chainInsert(&data[i]);
+            } else {
+                probeMask = TAIL_SLOTS - 1;
+                probeTable = (Contact**)countedCalloc(TAIL_SLOTS, sizeof(Contact*));
+                for (int i = 0; i < n; i++) probeInsert(&data[i]);
+            }
+
+            for (int miss = 0; miss < 2; miss++) {
+                long totalProbes = 0, maxProbes = 0;
+                int found = 0;
+                struct timespec a, b;
+                double start = wallMs();
+                for (int i = 0; i < n; i++) {
+                    char* name = miss ? missing[i] : data[order[i]].name;
+                    long before = probes;
+                    clock_gettime(CLOCK_MONOTONIC, &a);
+                    if (s == TABLE_CUCKOO) found += searchContact(name) != NULL;
+                    else if (s == TABLE_CHAINED) found += chainSearch(name) != NULL;
+                    else found += probeSearch(name) != NULL;
+                    clock_gettime(CLOCK_MONOTONIC, &b);
+                    ns[i] = (unsigned int)((b.tv_sec - a.tv_sec) * 1000000000L + (b.tv_nsec - a.tv_nsec));
+                    totalProbes += probes - before;
+                    if (probes - before > maxProbes) maxProbes = probes - before;
+                }
+                double ms = wallMs() - start;
+                char label[64];
+                snprintf(label, sizeof(label), "%s,%s", tableNames[s], miss ? "SearchMiss" : "Search");
+                writeTailRow(fp, label, n, load, ns, n, ms, totalProbes, maxProbes);
+                if (found != (miss ? 0 : n)) printf("  %d/%d names found!\n", found, n);
+            }
+
+            if (s == TABLE_CUCKOO) freeContacts();
+            else if (s == TABLE_CHAINED) chainFree();
+            else probeFree();
+        }
+        free(data);
+        free(missing);
+        free(order);
+        free(ns);
+    }
+
+    initTable(MIN_BUCKETS);
+    fclose(fp);
+    printf("Tail latency benchmark written to %s\n", filename);
+}
+
+// ---------------- Main Menu ----------------
+int main(int argc, char** argv) {
+    int choice;
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    kickSeed ^= (unsigned int)time(NULL);
+    initTable(MIN_BUCKETS);
+
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchmarkCuckooToCSV(argc > 2 ? argv[2] : "performance_cuckoo.csv");
+        return 0;
+    }
+
+    while (1) {
+        printf("\nContact Management System (Cuckoo Hash)\n");
+        printf("1. Insert Contact\n");
+        printf("2. Search Contact\n");
+        printf("3. Update Contact\n");
+        printf("4. Delete Contact\n");
+        printf("5. Display All Contacts\n");
+        printf("6. Benchmark Performance\n");
+        printf("7. Exit\n");
+        printf("8. Tail Latency Benchmark\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        getchar(); // consume newline
+
+        switch (choice) {
+            case 1:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                insertContact(name, phone, email);
+                break;
+            case 2:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    Contact* c = searchContact(name);
+                    if (c) printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+                    else printf("Contact not found.\n");
+                }
+                break;
+            case 3:
+                printf("Enter Name to Update: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter New Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter New Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                updateContact(name, phone, email);
+                break;
+            case 4:
+                printf("Enter Name to Delete: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                deleteContact(name);
+                break;
+            case 5:
+                displayContacts();
+                break;
+            case 6:
+                benchmarkCuckooToCSV("performance_cuckoo.csv");
+                freeContacts();
+                initTable(MIN_BUCKETS);
+                break;
+            case 7:
+                freeContacts();
+                exit(0);
+            case 8:
+                benchmarkTailToCSV("performance_cuckoo_tail.csv");
+                break;
+            default:
+                printf("Invalid choice! Try again.\n");
+        }
+    }
+    return 0;
+}
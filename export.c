@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "backends.h"
+
+// Streaming export engine: every backend's contacts serialized as CSV or JSON
+// Lines into one large reusable buffer, flushed with write(2) whenever less
+// than one worst-case record of space is left. Fields are copied with memcpy
+// unless they contain a character that needs escaping, which is found with
+// strcspn (CSV) or a 256-entry table (JSON). The benchmark compares it with
+// the per-contact printf of displayContacts and reports MB/s.
+
+#define EXPORT_BUFFER (1 << 20)
+#define RECORD_MAX ((NAME_LEN + PHONE_LEN + EMAIL_LEN) * 6 + 64)   // every byte as \u00XX
+#define LINEAR_LOAD_CAP 50000   // Array and LinkedList loads are quadratic
+
+enum { FMT_CSV, FMT_JSONL };
+static const char* formatNames[] = {"CSV", "JSONL"};
+
+typedef struct {
+    int fd;
+    char* buf;
+    size_t len;
+    long long bytes;    // flushed so far
+    int failed;
+} ExportWriter;
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// ---------------- Writer ----------------
+static void writerFlush(ExportWriter* w) {
+    size_t off = 0;
+    while (off < w->len && !w->failed) {
+        ssize_t r = write(w->fd, w->buf + off, w->len - off);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            perror("write");
+            w->failed = 1;
+        } else {
+            off += r;
+        }
+    }
+    w->bytes += off;
+    w->len = 0;
+}
+
+// Room for one more record of any content
+static char* writerReserve(ExportWriter* w) {
+    if (EXPORT_BUFFER - w->len < RECORD_MAX) writerFlush(w);
+    return w->buf + w->len;
+}
+
+static void writerPut(ExportWriter* w, const char* s) {
+    size_t n = strlen(s);
+    if (EXPORT_BUFFER - w->len < n) writerFlush(w);
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+// ---------------- CSV ----------------
+// Quoted only when the field holds a comma, quote or line break
+static char* csvField(char* p, const char* s) {
+    size_t n = strcspn(s, ",\"\r\n");
+    if (s[n] == '\0') {
+        memcpy(p, s, n);
+        return p + n;
+    }
+    *p++ = '"';
+    for (; *s; s++) {
+        if (*s == '"') *p++ = '"';
+        *p++ = *s;
+    }
+    *p++ = '"';
+    return p;
+}
+
+static void exportCsv(void* ctx, const char* name, const char* phone, const char* email) {
+    ExportWriter* w = (ExportWriter*)ctx;
+    char* p = writerReserve(w);
+    p = csvField(p, name);
+    *p++ = ',';
+    p = csvField(p, phone);
+    *p++ = ',';
+    p = csvField(p, email);
+    *p++ = '\n';
+    w->len = p - w->buf;
+}
+
+// ---------------- JSON Lines ----------------
+// Escape for every byte: 0 = copy, 'u' = \u00XX, else the letter after '\'
+static char jsonEscape[256];
+
+static void initJsonEscape(void) {
+    for (int c = 0; c < 0x20; c++) jsonEscape[c] = 'u';
+    jsonEscape['"'] = '"';
+    jsonEscape['\\'] = '\\';
+    jsonEscape['\b'] = 'b';
+    jsonEscape['\f'] = 'f';
+    jsonEscape['\n'] = 'n';
+    jsonEscape['\r'] = 'r';
+    jsonEscape['\t'] = 't';
+}
+
+static char* jsonString(char* p, const char* s) {
+    static const char hex[] = "0123456789abcdef";
+    *p++ = '"';
+    for (;;) {
+        const char* run = s;
+        while (*s && !jsonEscape[(unsigned char)*s]) s++;
+        memcpy(p, run, s - run);
+        p += s - run;
+        if (*s == '\0') break;
+        char e = jsonEscape[(unsigned char)*s];
+        *p++ = '\\';
+        if (e == 'u') {
+            memcpy(p, "u00", 3);
+            p[3] = hex[(unsigned char)*s >> 4];
+            p[4] = hex[*s & 15];
+            p += 5;
+        } else {
+            *p++ = e;
+        }
+        s++;
+    }
+    *p++ = '"';
+    return p;
+}
+
+static void exportJson(void* ctx, const char* name, const char* phone, const char* email) {
+    ExportWriter* w = (ExportWriter*)ctx;
+    char* p = writerReserve(w);
+    memcpy(p, "{\"name\":", 8);
+    p = jsonString(p + 8, name);
+    memcpy(p, ",\"phone\":", 9);
+    p = jsonString(p + 9, phone);
+    memcpy(p, ",\"email\":", 9);
+    p = jsonString(p + 9, email);
+    *p++ = '}';
+    *p++ = '\n';
+    w->len = p - w->buf;
+}
+
+// Export every contact of b to fd; returns bytes written, -1 on error
+static long long exportBackend(const Backend* b, int fd, int format, char* buf) {
+    ExportWriter w = {fd, buf, 0, 0, 0};
+    if (format == FMT_CSV) writerPut(&w, "name,phone,email\n");
+    b->visit(format == FMT_CSV ? exportCsv : exportJson, &w);
+    writerFlush(&w);
+    return w.failed ? -1 : w.bytes;
+}
+
+// ---------------- printf Baseline ----------------
+typedef struct {
+    FILE* out;
+    long long bytes;
+} PrintfTarget;
+
+static void exportPrintf(void* ctx, const char* name, const char* phone, const char* email) {
+    PrintfTarget* t = (PrintfTarget*)ctx;
+    t->bytes += fprintf(t->out, "Name: %s | Phone: %s | Email: %s\n", name, phone, email);
+}
+
+// ---------------- Test Data ----------------
+static void randomString(char* str, int length) {
+    static const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for (int i = 0; i < length - 1; i++)
+        str[i] = charset[rand() % (sizeof(charset) - 1)];
+    str[length - 1] = '\0';
+}
+
+// Random contacts; one in 64 names is "Last, \"Nick\"" so both escape paths run
+static long loadContacts(const Backend* b, long count) {
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN], last[16], nick[8];
+    long created = 0;
+    b->init((int)count);
+    for (long i = 0; i < count; i++) {
+        if (i % 64 == 0) {
+            randomString(last, 13);
+            randomString(nick, 6);
+            snprintf(name, sizeof(name), "%s, \"%s\"", last, nick);
+        } else {
+            randomString(name, 13);
+        }
+        randomString(phone, 11);
+        randomString(email, 16);
+        strcat(email, "@example.com");
+        created += b->insert(name, phone, email) == 1;
+    }
+    return created;
+}
+
+// ---------------- Benchmark ----------------
+static void writeRow(FILE* fp, const char* backend, const char* method, long contacts, long long bytes, double ms) {
+    double mbs = ms > 0 ? bytes / 1048576.0 / (ms / 1000.0) : 0;
+    fprintf(fp, "%s,%s,%ld,%lld,%.3f,%.1f\n", backend, method, contacts, bytes, ms, mbs);
+    fprintf(stderr, "  %-9s %10lld bytes in %9.1f ms: %8.1f MB/s\n", method, bytes, ms, mbs);
+}
+
+// printf baseline, CSV and JSON Lines for one loaded backend, each written to target
+static void benchmarkBackend(FILE* fp, const Backend* b, long contacts, const char* target, char* buf) {
+    int fd = open(target, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(target);
+        return;
+    }
+    static char stdioBuf[BUFSIZ];
+    PrintfTarget t = {fdopen(dup(fd), "w"), 0};
+    setvbuf(t.out, stdioBuf, _IOFBF, sizeof(stdioBuf));   // displayContacts' default buffering
+    double start = nowMs();
+    b->visit(exportPrintf, &t);
+    fflush(t.out);
+    double ms = nowMs() - start;
+    writeRow(fp, b->name, "printf", contacts, t.bytes, ms);
+    fclose(t.out);
+
+    for (int format = FMT_CSV; format <= FMT_JSONL; format++) {
+        if (ftruncate(fd, 0) == 0) lseek(fd, 0, SEEK_SET);
+        start = nowMs();
+        long long bytes = exportBackend(b, fd, format, buf);
+        ms = nowMs() - start;
+        writeRow(fp, b->name, formatNames[format], contacts, bytes, ms);
+    }
+    close(fd);
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [-b backend|all] [-n contacts] [-o target] [-F csv|jsonl] [-f results.csv]\n", prog);
+    printf("  -b NAME   Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo, Adaptive or all (default all)\n");
+    printf("  -n N      contacts loaded per backend (default 1000000; Array/LinkedList capped at %d)\n", LINEAR_LOAD_CAP);
+    printf("  -o PATH   where exports are written (default /dev/null, - for stdout)\n");
+    printf("  -F FMT    export once in this format instead of benchmarking, e.g. -o - | gzip\n");
+    printf("  -f FILE   benchmark results (default performance_export.csv)\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "all";
+    const char* target = "/dev/null";
+    const char* csvFile = "performance_export.csv";
+    long contacts = 1000000;
+    int format = -1, opt;
+
+    while ((opt = getopt(argc, argv, "b:n:o:F:f:h")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 'n': contacts = atol(optarg); break;
+            case 'o': target = optarg; break;
+            case 'F':
+                if (strcasecmp(optarg, "csv") == 0) format = FMT_CSV;
+                else if (strcasecmp(optarg, "jsonl") == 0) format = FMT_JSONL;
+                else { usage(argv[0]); return 1; }
+                break;
+            case 'f': csvFile = optarg; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    int all = strcasecmp(backendName, "all") == 0;
+    if (contacts < 1 || (!all && !findBackend(backendName))) { usage(argv[0]); return 1; }
+    initJsonEscape();
+    srand(time(NULL));
+    char* buf = (char*)malloc(EXPORT_BUFFER);
+
+    // One export, e.g. into a pipe
+    if (format >= 0) {
+        if (all) { usage(argv[0]); return 1; }
+        const Backend* b = findBackend(backendName);
+        loadContacts(b, contacts);
+        int fd = strcmp(target, "-") == 0 ? STDOUT_FILENO : open(target, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) { perror(target); return 1; }
+        double start = nowMs();
+        long long bytes = exportBackend(b, fd, format, buf);
+        double ms = nowMs() - start;
+        fprintf(stderr, "%s: %ld contacts, %lld bytes of %s in %.1f ms: %.1f MB/s\n", b->name, contacts,
+                bytes, formatNames[format], ms, bytes / 1048576.0 / (ms / 1000.0));
+        b->destroy();
+        return bytes < 0;
+    }
+
+    if (strcmp(target, "-") == 0) target = "/dev/stdout";
+    FILE* fp = fopen(csvFile, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", csvFile);
+        return 1;
+    }
+    fprintf(fp, "DataStructure,Method,Contacts,Bytes,Time_ms,MB_s\n");
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        const Backend* b = &backends[i];
+        if (!all && b != findBackend(backendName)) continue;
+        long n = contacts;
+        if ((b->insert == arrInsert || b->insert == llInsert) && n > LINEAR_LOAD_CAP) n = LINEAR_LOAD_CAP;
+        fprintf(stderr, "%s: loading %ld contacts\n", b->name, n);
+        n = loadContacts(b, n);
+        benchmarkBackend(fp, b, n, target, buf);
+        b->destroy();
+    }
+    fclose(fp);
+    free(buf);
+    fprintf(stderr, "Export benchmark written to %s\n", csvFile);
+    return 0;
+}
@@ -0,0 +1,283 @@
+// Membership filter: an approximate set of the stored names, checked before
+// a search, update or delete so that most misses never walk the structure.
+// It answers "maybe" for every stored name and "no" for 99% or more of the
+// others. Used by the linked list and the BST.
+//
+// Bloom mode: a blocked Bloom filter. A name hashes to one 64-byte block and
+// sets FILTER_K of its 512 bits, so a query reads a single cache line. It is
+// sized at FILTER_BITS bits per name for twice the names present when built.
+// Xor mode: the names present at the last rebuild go into an xor filter (an
+// 8-bit fingerprint per 1.23 names, about 0.4% false positives, three reads).
+// An xor filter is static, so names inserted since then go into a smaller
+// Bloom filter checked next to it. That one is only filled to half its size,
+// so it adds little to the false positives.
+//
+// Neither filter can remove a name: a deleted name keeps its bits and only
+// raises the false-positive rate. The program rebuilds the filter from its
+// names (filterBuild) once filterStale says so: after a quarter of the names
+// have been deleted, or once the Bloom filter is full (half full in xor mode).
+//
+// The starting mode is FILTER_DEFAULT_MODE; define it before including this
+// header to change it.
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILTER_BITS 10          // Bloom bits per name
+#define FILTER_K 7              // bits set per name, 9 hash bits each
+#define FILTER_MIN_NAMES 1024   // smallest Bloom capacity
+
+enum { FILTER_OFF, FILTER_BLOOM, FILTER_XOR };
+static const char* filterModeNames[] = {"off", "Bloom", "xor"};
+
+#ifndef FILTER_DEFAULT_MODE
+#define FILTER_DEFAULT_MODE FILTER_BLOOM
+#endif
+
+typedef struct __attribute__((aligned(64))) {
+    unsigned long long word[8];
+} BloomBlock;
+
+static int filterMode = FILTER_DEFAULT_MODE;
+static BloomBlock* bloom = NULL;
+static unsigned long bloomBlocks = 0;
+static long bloomCapacity = 0;          // names the Bloom filter is sized for
+static long bloomNames = 0;             // names added to it
+static long bloomLimit = 0;             // names it takes before a rebuild
+static unsigned char* xorFingerprints = NULL;
+static unsigned long xorSegment = 0;    // fingerprints per segment (3 segments)
+static unsigned long long xorSeed = 0;
+static long filterNames = 0;            // names at the last rebuild plus inserts since
+static long filterDeletes = 0;          // deletes since the last rebuild
+static long filterRejects = 0, filterPasses = 0, filterFalsePositives = 0, filterRebuilds = 0;
+
+static inline unsigned long long mix64(unsigned long long h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// FNV-1a 64 of a name, finalized so every bit depends on every byte
+static inline unsigned long long filterHash(const char* s) {
+    unsigned long long h = 14695981039346656037ULL;
+    while (*s) h = (h ^ (unsigned char)*s++) * 1099511628211ULL;
+    return mix64(h);
+}
+
+// ---------------- Bloom ----------------
+// Empty Bloom filter with room for capacity names
+static inline void bloomReset(long capacity) {
+    free(bloom);
+    bloomBlocks = (capacity * FILTER_BITS + 511) / 512;
+    bloom = (BloomBlock*)aligned_alloc(64, bloomBlocks * sizeof(BloomBlock));
+    memset(bloom, 0, bloomBlocks * sizeof(BloomBlock));
+    bloomCapacity = capacity;
+    bloomNames = 0;
+}
+
+// The low half of the hash picks the block, a remix of it the bits
+static inline BloomBlock* bloomBlock(unsigned long long h) {
+    return &bloom[((h & 0xffffffffULL) * bloomBlocks) >> 32];
+}
+
+static inline void bloomAdd(unsigned long long h) {
+    BloomBlock* b = bloomBlock(h);
+    unsigned long long bits = mix64(h);
+    for (int i = 0; i < FILTER_K; i++, bits >>= 9) {
+        b->word[(bits >> 6) & 7] |= 1ULL << (bits & 63);
+    }
+    bloomNames++;
+}
+
+static inline int bloomMayContain(unsigned long long h) {
+    BloomBlock* b = bloomBlock(h);
+    unsigned long long bits = mix64(h);
+    for (int i = 0; i < FILTER_K; i++, bits >>= 9) {
+        if (!(b->word[(bits >> 6) & 7] & (1ULL << (bits & 63)))) return 0;
+    }
+    return 1;
+}
+
+// ---------------- Xor ----------------
+// Fingerprint position of a hash in segment j
+static inline unsigned long xorSlot(unsigned long long h, int j) {
+    unsigned long long r = j == 0 ? h : (h << (21 * j)) | (h >> (64 - 21 * j));
+    return (unsigned long)(((r & 0xffffffffULL) * xorSegment) >> 32) + j * xorSegment;
+}
+
+static inline unsigned char xorFingerprint(unsigned long long h) {
+    return (unsigned char)(h ^ (h >> 32));
+}
+
+static inline int xorMayContain(unsigned long long h) {
+    h = mix64(h + xorSeed);
+    return (xorFingerprint(h) ^ xorFingerprints[xorSlot(h, 0)] ^ xorFingerprints[xorSlot(h, 1)] ^
+            xorFingerprints[xorSlot(h, 2)]) == 0;
+}
+
+// Xor filter over n distinct name hashes. Peeling: a slot only one name maps
+// to is that name's own; remove the name and repeat. If some names are left,
+// try another seed (rarely needed at 1.23 slots per name). The fingerprints
+// are then assigned in reverse peel order, so each name's three bytes xor to
+// its fingerprint.
+static inline void xorBuild(unsigned long long* keys, long n) {
+    xorSegment = (32 + (unsigned long)(1.23 * n) + 2) / 3;
+    unsigned long slots = 3 * xorSegment;
+    unsigned int* count = (unsigned int*)malloc(slots * sizeof(unsigned int));
+    unsigned long long* mask = (unsigned long long*)malloc(slots * sizeof(unsigned long long));
+    unsigned long* queue = (unsigned long*)malloc(slots * sizeof(unsigned long));
+    unsigned long long* peeledKey = (unsigned long long*)malloc((n + 1) * sizeof(unsigned long long));
+    unsigned long* peeledSlot = (unsigned long*)malloc((n + 1) * sizeof(unsigned long));
+    long peeled;
+
+    do {
+        xorSeed = mix64(xorSeed + 0x9e3779b97f4a7c15ULL);
+        memset(count, 0, slots * sizeof(unsigned int));
+        memset(mask, 0, slots * sizeof(unsigned long long));
+        for (long i = 0; i < n; i++) {
+            unsigned long long h = mix64(keys[i] + xorSeed);
+            for (int j = 0; j < 3; j++) {
+                unsigned long s = xorSlot(h, j);
+                count[s]++;
+                mask[s] ^= keys[i];
+            }
+        }
+        long queued = 0;
+        for (unsigned long s = 0; s < slots; s++) {
+            if (count[s] == 1) queue[queued++] = s;
+        }
+        peeled = 0;
+        while (queued > 0) {
+            unsigned long s = queue[--queued];
+            if (count[s] != 1) continue;
+            unsigned long long key = mask[s];
+            peeledKey[peeled] = key;
+            peeledSlot[peeled++] = s;
+            unsigned long long h = mix64(key + xorSeed);
+            for (int j = 0; j < 3; j++) {
+                unsigned long t = xorSlot(h, j);
+                count[t]--;
+                mask[t] ^= key;
+                if (count[t] == 1) queue[queued++] = t;
+            }
+        }
+    } while (peeled < n);
+
+    free(xorFingerprints);
+    xorFingerprints = (unsigned char*)calloc(slots, 1);
+    for (long i = n - 1; i >= 0; i--) {
+        unsigned long long h = mix64(peeledKey[i] + xorSeed);
+        unsigned char f = xorFingerprint(h);
+        for (int j = 0; j < 3; j++) {
+            unsigned long t = xorSlot(h, j);
+            if (t != peeledSlot[i]) f ^= xorFingerprints[t];
+        }
+        xorFingerprints[peeledSlot[i]] = f;
+    }
+    free(count);
+    free(mask);
+    free(queue);
+    free(peeledKey);
+    free(peeledSlot);
+}
+
+static inline int compareHash(const void* a, const void* b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+// ---------------- Filter ----------------
+// Build the filter for the current mode from the filterHash of every stored
+// name; keys is a malloc'd array of n hashes and is freed here
+static inline void filterBuild(unsigned long long* keys, long n) {
+    free(xorFingerprints);
+    xorFingerprints = NULL;
+    if (filterMode == FILTER_XOR) {
+        // Duplicate names would never peel
+        qsort(keys, n, sizeof(unsigned long long), compareHash);
+        long unique = 0;
+        for (long i = 0; i < n; i++) {
+            if (unique == 0 || keys[i] != keys[unique - 1]) keys[unique++] = keys[i];
+        }
+        xorBuild(keys, unique);
+        bloomReset(n / 2 > FILTER_MIN_NAMES ? n / 2 : FILTER_MIN_NAMES);
+        bloomLimit = bloomCapacity / 2;
+    } else {
+        bloomReset(2 * n > FILTER_MIN_NAMES ? 2 * n : FILTER_MIN_NAMES);
+        bloomLimit = bloomCapacity;
+        for (long i = 0; i < n; i++) bloomAdd(keys[i]);
+    }
+    free(keys);
+    filterNames = n;
+    filterDeletes = 0;
+    filterRebuilds++;
+}
+
+// Record a new name (its bits are set at once; a rebuild waits for filterStale)
+static inline void filterAdd(const char* name) {
+    if (filterMode == FILTER_OFF) return;
+    bloomAdd(filterHash(name));
+    filterNames++;
+}
+
+// Record a removed name; its bits stay set until the next rebuild
+static inline void filterDelete(void) {
+    filterDeletes++;
+}
+
+// 1 when deleted names or a full Bloom filter have raised the false-positive
+// rate enough to rebuild; checked once an insert or delete has finished
+static inline int filterStale(void) {
+    if (filterMode == FILTER_OFF) return 0;
+    return bloomNames > bloomLimit || filterDeletes * 4 > filterNames;
+}
+
+// 0 if name is certainly absent; counts the answer
+static inline int filterMayContain(const char* name) {
+    if (filterMode == FILTER_OFF) return 1;
+    unsigned long long h = filterHash(name);
+    int maybe = (xorFingerprints != NULL && xorMayContain(h)) || (bloomNames > 0 && bloomMayContain(h));
+    if (maybe) filterPasses++;
+    else filterRejects++;
+    return maybe;
+}
+
+// A name the filter let through was not found
+static inline void filterFalsePositive(void) {
+    if (filterMode != FILTER_OFF) filterFalsePositives++;
+}
+
+static inline void filterFree(void) {
+    free(bloom);
+    free(xorFingerprints);
+    bloom = NULL;
+    xorFingerprints = NULL;
+    bloomBlocks = 0;
+    bloomCapacity = bloomNames = bloomLimit = filterNames = filterDeletes = 0;
+}
+
+// Bloom and xor bits over the names still stored
+static inline double filterBitsPerName(void) {
+    long names = filterNames - filterDeletes;
+    double bits = 8.0 * bloomBlocks * sizeof(BloomBlock) + (xorFingerprints ? 8.0 * 3 * xorSegment : 0);
+    return names > 0 ? bits / names : 0.0;
+}
+
+// False positives are absent names the filter let through
+static inline void displayFilterStats(void) {
+    long absent = filterRejects + filterFalsePositives;
+    printf("Membership filter %s: %ld names, %ld deleted since rebuild, %.1f bits per name, %ld rebuilds\n",
+           filterModeNames[filterMode], filterNames - filterDeletes, filterDeletes, filterBitsPerName(),
+           filterRebuilds);
+    printf("%ld rejected, %ld passed, %ld false positives (%.2f%% of absent names)\n",
+           filterRejects, filterPasses, filterFalsePositives,
+           absent > 0 ? 100.0 * filterFalsePositives / absent : 0.0);
+}
+
+#endif
@@ -7,7 +7,10 @@ csv_files = {
     "LinkedList": "performance_ll.csv",
     "HashMap": "performance_hashmap.csv",
     "BST": "performance_bst.csv",
-    "AVL": "performance_avl.csv"
+    "AVL": "performance_avl.csv",
+    "SkipList": "performance_skiplist.csv",
+    "Splay": "performance_splay.csv",
+    "Cuckoo": "performance_cuckoo.csv"
 }
 
 # Read all CSVs into a single DataFrame
@@ -1,11 +1,23 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "trace.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
 #define EMAIL_LEN 50
-#define TABLE_SIZE 101   // prime number for better distribution
+#define TABLE_SIZE 101   // initial buckets, prime for better distribution
+#define MAX_LOAD 1        // grow when contacts exceed buckets * MAX_LOAD
+#define MIGRATE_BUCKETS 4 // old buckets moved per operation while growing
+#define TRIGRAM_BITS 16
+#define TRIGRAM_BUCKETS (1 << TRIGRAM_BITS)
+#define FUZZY_MAX_DIST 2
+#define FUZZY_TOP_K 5
+#define FUZZY_LONG_LIST 64   // posting lists over contactCount / 64 are skipped when possible
+#define BATCH_LANES 16    // lookups kept in flight by searchMany
+#define BATCH_MAX_NAMES 64   // names per "Search Several Contacts" request
 
 // Contact structure (node in chaining linked list)
 typedef struct Contact {
@@ -13,18 +25,292 @@ typedef struct Contact {
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
     struct Contact* next;
+    int* gramPos;               // slot in each of its trigrams' posting lists (trigram index only)
 } Contact;
 
-// Hash table (array of pointers to Contact)
-Contact* hashTable[TABLE_SIZE];
+// Hash table (array of pointers to Contact), doubled when it gets full
+Contact** hashTable = NULL;
+unsigned int tableSize = 0;
+long contactCount = 0;
 
-// Hash function (djb2 algorithm)
-unsigned int hash(char* str) {
+// Hash function (djb2 algorithm), before reduction to a bucket
+unsigned long hashName(char* str) {
     unsigned long hash = 5381;
     int c;
     while ((c = *str++))
         hash = ((hash << 5) + hash) + c; // hash * 33 + c
-    return hash % TABLE_SIZE;
+    return hash;
+}
+
+// Smallest prime >= n
+unsigned int nextPrime(unsigned int n) {
+    if (n < 3) return 3;
+    for (n |= 1; ; n += 2) {
+        int prime = 1;
+        for (unsigned int d = 3; d * d <= n; d += 2)
+            if (n % d == 0) { prime = 0; break; }
+        if (prime) return n;
+    }
+}
+
+// ---------------- Incremental Resizing ----------------
+// Growing allocates a table about twice the size and keeps the old one
+// alongside it. Every operation then moves MIGRATE_BUCKETS old buckets, in
+// index order, into the new table, so no single insert pays for rehashing
+// everything. Because buckets move in order, a name whose old bucket is below
+// migrateIndex is in the new table and any other name is still in the old
+// one: each lookup probes exactly one of the two tables.
+Contact** oldTable = NULL;        // table being drained, NULL when not growing
+unsigned int oldSize = 0;
+unsigned int migrateIndex = 0;    // old buckets below this have been moved
+
+void initTable(unsigned int size) {
+    hashTable = (Contact**)calloc(size, sizeof(Contact*));
+    tableSize = size;
+}
+
+// Bucket that holds name, or will hold it once inserted
+Contact** bucketFor(char* name) {
+    unsigned long h = hashName(name);
+    if (oldTable != NULL && h % oldSize >= migrateIndex) return &oldTable[h % oldSize];
+    return &hashTable[h % tableSize];
+}
+
+void migrateBuckets(unsigned int count) {
+    while (oldTable != NULL && count-- > 0) {
+        Contact* c = oldTable[migrateIndex];
+        while (c != NULL) {
+            Contact* next = c->next;
+            unsigned int index = hashName(c->name) % tableSize;
+            c->next = hashTable[index];
+            hashTable[index] = c;
+            c = next;
+        }
+        oldTable[migrateIndex++] = NULL;
+        if (migrateIndex == oldSize) {
+            free(oldTable);
+            oldTable = NULL;
+        }
+    }
+}
+
+// Move whatever is left, for walks over every bucket
+void finishResize() {
+    if (oldTable != NULL) migrateBuckets(oldSize - migrateIndex);
+}
+
+// Start growing once the load factor is exceeded (calloc'd, so a large new
+// table is zeroed page by page as it is touched instead of all at once)
+void maybeGrow() {
+    if (oldTable != NULL || contactCount <= (long)tableSize * MAX_LOAD) return;
+    oldTable = hashTable;
+    oldSize = tableSize;
+    migrateIndex = 0;
+    initTable(nextPrime(tableSize * 2));
+}
+
+// Trigram index for typo-tolerant search.
+// Every name is lower-cased, padded as "$$name$" and split into trigrams.
+// Each trigram hashes to a posting list of contacts containing it. A name
+// within edit distance k of the query shares at least T - 3k of the query's
+// T trigrams, so only contacts reaching that count are verified with the
+// bit-parallel (Myers) edit distance.
+typedef struct {
+    Contact* contact;
+    int gram;          // which of the contact's trigrams, to find its gramPos entry
+} Posting;
+
+typedef struct {
+    Posting* items;
+    int count;
+    int capacity;
+} PostingList;
+
+PostingList trigramIndex[TRIGRAM_BUCKETS];
+int trigramIndexOn = 1;
+
+// Lower-case and pad a name; returns the padded length
+int padName(const char* name, char* out) {
+    int len = 0;
+    out[len++] = '$';
+    out[len++] = '$';
+    for (; *name && len < NAME_LEN + 2; name++)
+        out[len++] = (*name >= 'A' && *name <= 'Z') ? *name - 'A' + 'a' : *name;
+    out[len++] = '$';
+    return len;
+}
+
+unsigned int trigramHash(const char* s) {
+    unsigned int h = ((unsigned char)s[0] << 16) | ((unsigned char)s[1] << 8) | (unsigned char)s[2];
+    h *= 2654435761u;
+    return h >> (32 - TRIGRAM_BITS);
+}
+
+// Distinct trigram buckets of a name; returns how many were written
+int nameTrigrams(const char* name, unsigned int* out) {
+    char padded[NAME_LEN + 4];
+    int len = padName(name, padded);
+    int n = 0;
+    for (int i = 0; i + 3 <= len; i++) {
+        unsigned int h = trigramHash(padded + i);
+        int seen = 0;
+        for (int j = 0; j < n; j++)
+            if (out[j] == h) { seen = 1; break; }
+        if (!seen) out[n++] = h;
+    }
+    return n;
+}
+
+void indexContact(Contact* c) {
+    unsigned int grams[NAME_LEN + 2];
+    int n = nameTrigrams(c->name, grams);
+    c->gramPos = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        PostingList* list = &trigramIndex[grams[i]];
+        if (list->count == list->capacity) {
+            list->capacity = list->capacity ? list->capacity * 2 : 4;
+            list->items = (Posting*)realloc(list->items, list->capacity * sizeof(Posting));
+        }
+        c->gramPos[i] = list->count;
+        list->items[list->count++] = (Posting){c, i};
+    }
+}
+
+// Swap-remove from each list at the recorded slot; the contact moved into
+// that slot gets its own record updated, so no list is searched
+void unindexContact(Contact* c) {
+    if (c->gramPos == NULL) return;
+    unsigned int grams[NAME_LEN + 2];
+    int n = nameTrigrams(c->name, grams);
+    for (int i = 0; i < n; i++) {
+        PostingList* list = &trigramIndex[grams[i]];
+        Posting last = list->items[--list->count];
+        list->items[c->gramPos[i]] = last;
+        last.contact->gramPos[last.gram] = c->gramPos[i];
+    }
+    free(c->gramPos);
+    c->gramPos = NULL;
+}
+
+void freeTrigramIndex() {
+    for (int i = 0; i < TRIGRAM_BUCKETS; i++) {
+        free(trigramIndex[i].items);
+        trigramIndex[i].items = NULL;
+        trigramIndex[i].count = trigramIndex[i].capacity = 0;
+    }
+}
+
+// Edit distance between query and name (case-insensitive), using Myers'
+// bit-vector algorithm; gives up and returns maxDist + 1 once the distance
+// can no longer come back under maxDist. Names fit in one 64-bit word.
+int boundedEditDistance(const char* query, const char* name, int maxDist) {
+    unsigned long long peq[256] = {0};
+    int m = 0;
+    for (; query[m]; m++) {
+        unsigned char ch = query[m];
+        if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+        peq[ch] |= 1ULL << m;
+    }
+    int n = strlen(name);
+    if (m == 0) return n <= maxDist ? n : maxDist + 1;
+    if (abs(m - n) > maxDist) return maxDist + 1;
+
+    unsigned long long pv = ~0ULL, mv = 0, last = 1ULL << (m - 1);
+    int score = m;
+    for (int j = 0; j < n; j++) {
+        unsigned char ch = name[j];
+        if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+        unsigned long long eq = peq[ch];
+        unsigned long long xv = eq | mv;
+        unsigned long long xh = (((eq & pv) + pv) ^ pv) | eq;
+        unsigned long long ph = mv | ~(xh | pv);
+        unsigned long long mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score - (n - j - 1) > maxDist) return maxDist + 1;
+    }
+    return score;
+}
+
+// Insert a match into results/dists, kept sorted by distance, at most k long
+void addMatch(Contact* c, int d, int k, Contact** results, int* dists, int* found) {
+    int pos = *found < k ? (*found)++ : k;
+    while (pos > 0 && dists[pos - 1] > d) {
+        if (pos < k) { results[pos] = results[pos - 1]; dists[pos] = dists[pos - 1]; }
+        pos--;
+    }
+    if (pos < k) { results[pos] = c; dists[pos] = d; }
+}
+
+// Find up to k contacts within maxDist edits of query, closest first.
+// Returns the number of matches written to results/dists.
+int fuzzySearch(char* query, int maxDist, int k, Contact** results, int* dists) {
+    unsigned int grams[NAME_LEN + 2];
+    int t = nameTrigrams(query, grams);
+    int need = t - 3 * maxDist;
+    int found = 0;
+
+    // Too short for the trigram filter: every contact is a candidate
+    if (need < 1) {
+        finishResize();
+        for (unsigned int i = 0; i < tableSize; i++)
+            for (Contact* c = hashTable[i]; c != NULL; c = c->next) {
+                int d = boundedEditDistance(query, c->name, maxDist);
+                if (d <= maxDist) addMatch(c, d, k, results, dists, &found);
+            }
+        return found;
+    }
+
+    // Skip the longest lists (padded prefixes such as "$$a" hold about 1/26 of
+    // all names) while they exceed contactCount / FUZZY_LONG_LIST. A match can
+    // miss at most one hit per skipped list, so need drops by one for each and
+    // the results are unchanged; only fewer postings are counted.
+    int skipped[NAME_LEN + 2] = {0};
+    long longList = contactCount / FUZZY_LONG_LIST;
+    while (need > 1) {
+        int longest = -1;
+        for (int i = 0; i < t; i++)
+            if (!skipped[i] && (longest < 0 || trigramIndex[grams[i]].count > trigramIndex[grams[longest]].count))
+                longest = i;
+        if (trigramIndex[grams[longest]].count <= longList) break;
+        skipped[longest] = 1;
+        need--;
+    }
+
+    // Count trigram hits per candidate in a small open-addressed table
+    int total = 0;
+    for (int i = 0; i < t; i++)
+        if (!skipped[i]) total += trigramIndex[grams[i]].count;
+    int cap = 16;
+    while (cap < 2 * total) cap <<= 1;
+    Contact** keys = (Contact**)calloc(cap, sizeof(Contact*));
+    unsigned char* counts = (unsigned char*)calloc(cap, 1);
+
+    for (int i = 0; i < t; i++) {
+        if (skipped[i]) continue;
+        PostingList* list = &trigramIndex[grams[i]];
+        for (int j = 0; j < list->count; j++) {
+            Contact* c = list->items[j].contact;
+            unsigned int slot = (unsigned int)(((unsigned long)c >> 4) * 2654435761u) & (cap - 1);
+            while (keys[slot] != NULL && keys[slot] != c) slot = (slot + 1) & (cap - 1);
+            keys[slot] = c;
+            counts[slot]++;
+        }
+    }
+
+    for (int s = 0; s < cap; s++) {
+        if (keys[s] == NULL || counts[s] < need) continue;
+        int d = boundedEditDistance(query, keys[s]->name, maxDist);
+        if (d <= maxDist) addMatch(keys[s], d, k, results, dists, &found);
+    }
+
+    free(keys);
+    free(counts);
+    return found;
 }
 
 // Create a new contact node
@@ -34,25 +320,30 @@ Contact* createContact(char* name, char* phone, char* email) {
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
     newContact->next = NULL;
+    newContact->gramPos = NULL;
     return newContact;
 }
 
 // Insert a contact into the hash table
 void insertContact(char* name, char* phone, char* email) {
-    unsigned int index = hash(name);
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
     Contact* newContact = createContact(name, phone, email);
 
     // Insert at head of linked list (separate chaining)
-    newContact->next = hashTable[index];
-    hashTable[index] = newContact;
+    newContact->next = *bucket;
+    *bucket = newContact;
+    contactCount++;
+    if (trigramIndexOn) indexContact(newContact);
+    maybeGrow();
 
     printf("Contact added: %s\n", name);
 }
 
 // Search for a contact by name
 Contact* searchContact(char* name) {
-    unsigned int index = hash(name);
-    Contact* temp = hashTable[index];
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact* temp = *bucketFor(name);
     while (temp != NULL) {
         if (strcmp(temp->name, name) == 0)
             return temp;
@@ -61,6 +352,78 @@ Contact* searchContact(char* name) {
     return NULL;
 }
 
+// Look up count names at once; results[i] gets the contact or NULL.
+// All bucket heads are hashed and prefetched first, then BATCH_LANES chain
+// walks are interleaved (AMAC): each pass compares one node per lane and
+// prefetches that lane's next node, so misses on different chains overlap
+// instead of stalling one lookup at a time. While the table grows each name
+// is resolved to its old or new bucket with bucketFor; nothing migrates
+// during the batch, so a batch never pays for moving buckets.
+void searchMany(char** names, int count, Contact** results) {
+    Contact*** slots = (Contact***)malloc((count > 0 ? count : 1) * sizeof(Contact**));
+    for (int i = 0; i < count; i++) {
+        slots[i] = bucketFor(names[i]);
+        __builtin_prefetch(slots[i]);
+    }
+
+    Contact* cur[BATCH_LANES];
+    int who[BATCH_LANES];
+    int next = 0, active = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (next < count) {
+            who[l] = next;
+            cur[l] = *slots[next++];
+            __builtin_prefetch(cur[l]);
+            active++;
+        } else {
+            who[l] = -1;
+        }
+    }
+
+    while (active > 0) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (who[l] < 0) continue;
+            Contact* c = cur[l];
+            if (c != NULL && strcmp(c->name, names[who[l]]) != 0) {
+                cur[l] = c->next;
+                __builtin_prefetch(cur[l]);
+                continue;
+            }
+            // lane finished: record the result and start the next lookup
+            results[who[l]] = c;
+            if (next < count) {
+                who[l] = next;
+                cur[l] = *slots[next++];
+                __builtin_prefetch(cur[l]);
+            } else {
+                who[l] = -1;
+                active--;
+            }
+        }
+    }
+    free(slots);
+}
+
+// Search a comma-separated list of names in one batch
+void displayManyContacts(char* line) {
+    char* names[BATCH_MAX_NAMES];
+    Contact* results[BATCH_MAX_NAMES];
+    int count = 0;
+    for (char* tok = strtok(line, ","); tok != NULL && count < BATCH_MAX_NAMES; tok = strtok(NULL, ",")) {
+        while (*tok == ' ') tok++;
+        if (*tok == 0) continue;
+        traceRecord(TRACE_SEARCH, tok, NULL, NULL, 0);
+        names[count++] = tok;
+    }
+    searchMany(names, count, results);
+    for (int i = 0; i < count; i++) {
+        if (results[i] != NULL)
+            printf("Found: %s | Phone: %s | Email: %s\n", results[i]->name, results[i]->phone, results[i]->email);
+        else
+            printf("Not found: %s\n", names[i]);
+    }
+}
+
 // Update a contact
 void updateContact(char* name, char* newPhone, char* newEmail) {
     Contact* contact = searchContact(name);
@@ -73,10 +436,37 @@ void updateContact(char* name, char* newPhone, char* newEmail) {
     printf("Contact updated: %s\n", name);
 }
 
+// Find a contact or add it to its bucket, in one probe of the chain
+Contact* insertIfAbsent(char* name, char* phone, char* email) {
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
+    for (Contact* temp = *bucket; temp != NULL; temp = temp->next) {
+        if (strcmp(temp->name, name) == 0)
+            return temp;
+    }
+    Contact* newContact = createContact(name, phone, email);
+    newContact->next = *bucket;
+    *bucket = newContact;
+    contactCount++;
+    if (trigramIndexOn) indexContact(newContact);
+    maybeGrow();
+    return newContact;
+}
+
+// Insert a contact or overwrite an existing one, in one probe of the chain
+Contact* upsertContact(char* name, char* phone, char* email) {
+    Contact* contact = insertIfAbsent(name, phone, email);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    printf("Contact saved: %s\n", name);
+    return contact;
+}
+
 // Delete a contact by name
 void deleteContact(char* name) {
-    unsigned int index = hash(name);
-    Contact* temp = hashTable[index];
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
+    Contact* temp = *bucket;
     Contact* prev = NULL;
 
     while (temp != NULL && strcmp(temp->name, name) != 0) {
@@ -90,12 +480,14 @@ void deleteContact(char* name) {
     }
 
     if (prev == NULL) {
-        hashTable[index] = temp->next; // remove head
+        *bucket = temp->next; // remove head
     } else {
         prev->next = temp->next;
     }
 
+    if (trigramIndexOn) unindexContact(temp);
     free(temp);
+    contactCount--;
     printf("Contact deleted: %s\n", name);
 }
 
@@ -103,7 +495,8 @@ void deleteContact(char* name) {
 void displayContacts() {
     printf("\n--- Contact List ---\n");
     int empty = 1;
-    for (int i = 0; i < TABLE_SIZE; i++) {
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++) {
         Contact* temp = hashTable[i];
         while (temp != NULL) {
             printf("Name: %s | Phone: %s | Email: %s\n",
@@ -116,23 +509,314 @@ void displayContacts() {
     printf("---------------------\n");
 }
 
+// ---------------- Sorted Export ----------------
+// Contacts are gathered into an array of pointers and sorted by name with an
+// MSD radix sort: one counting pass per byte position splits a range into 256
+// buckets (bucket 0 holds names that end there, already in order) and each
+// bucket is sorted on the next byte. Ranges under RADIX_CUTOFF fall back to
+// insertion sort on the remaining suffix. The first-byte buckets are
+// independent, so worker threads claim them from a shared counter.
+#define RADIX_CUTOFF 32
+#define MAX_SORT_THREADS 64
+
+void insertionSortNames(Contact** a, int n, int depth) {
+    for (int i = 1; i < n; i++) {
+        Contact* c = a[i];
+        int j = i;
+        while (j > 0 && strcmp(a[j - 1]->name + depth, c->name + depth) > 0) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = c;
+    }
+}
+
+// Distribute a[0..n) by the byte at depth; bucket b ends up in [start[b], start[b+1])
+void radixPass(Contact** a, Contact** tmp, int n, int depth, int* start) {
+    int count[256] = {0};
+    int pos[256];
+    for (int i = 0; i < n; i++) count[(unsigned char)a[i]->name[depth]]++;
+    start[0] = 0;
+    for (int b = 0; b < 256; b++) start[b + 1] = start[b] + count[b];
+    memcpy(pos, start, sizeof(pos));
+    for (int i = 0; i < n; i++) tmp[pos[(unsigned char)a[i]->name[depth]]++] = a[i];
+    memcpy(a, tmp, n * sizeof(Contact*));
+}
+
+void msdRadixSort(Contact** a, Contact** tmp, int n, int depth) {
+    if (n < RADIX_CUTOFF) {
+        insertionSortNames(a, n, depth);
+        return;
+    }
+    if (depth >= NAME_LEN - 1) return;
+    int start[257];
+    radixPass(a, tmp, n, depth, start);
+    for (int b = 1; b < 256; b++)
+        if (start[b + 1] - start[b] > 1)
+            msdRadixSort(a + start[b], tmp + start[b], start[b + 1] - start[b], depth + 1);
+}
+
+typedef struct {
+    Contact** a;
+    Contact** tmp;
+    int* start;     // first-byte bucket bounds
+    int next;       // next bucket to claim
+} SortJob;
+
+void* radixSortWorker(void* arg) {
+    SortJob* job = (SortJob*)arg;
+    int b;
+    while ((b = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < 256) {
+        int lo = job->start[b], len = job->start[b + 1] - lo;
+        if (b > 0 && len > 1) msdRadixSort(job->a + lo, job->tmp + lo, len, 1);
+    }
+    return NULL;
+}
+
+// Sort a[0..n) by name using up to threads workers
+void sortByName(Contact** a, int n, int threads) {
+    Contact** tmp = (Contact**)malloc((n > 0 ? n : 1) * sizeof(Contact*));
+    if (threads > MAX_SORT_THREADS) threads = MAX_SORT_THREADS;
+    if (threads <= 1 || n < RADIX_CUTOFF) {
+        msdRadixSort(a, tmp, n, 0);
+        free(tmp);
+        return;
+    }
+    int start[257];
+    radixPass(a, tmp, n, 0, start);
+    SortJob job = {a, tmp, start, 0};
+    pthread_t tids[MAX_SORT_THREADS];
+    for (int t = 0; t < threads; t++) pthread_create(&tids[t], NULL, radixSortWorker, &job);
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    free(tmp);
+}
+
+// Every contact in name order; the caller frees the array
+Contact** sortedContacts(int* count) {
+    int n = 0;
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++)
+        for (Contact* temp = hashTable[i]; temp != NULL; temp = temp->next) n++;
+    Contact** all = (Contact**)malloc((n > 0 ? n : 1) * sizeof(Contact*));
+    n = 0;
+    for (unsigned int i = 0; i < tableSize; i++)
+        for (Contact* temp = hashTable[i]; temp != NULL; temp = temp->next) all[n++] = temp;
+    sortByName(all, n, (int)sysconf(_SC_NPROCESSORS_ONLN));
+    *count = n;
+    return all;
+}
+
+void displaySortedContacts() {
+    int n;
+    Contact** all = sortedContacts(&n);
+    printf("\n--- Contact List (by name) ---\n");
+    for (int i = 0; i < n; i++)
+        printf("Name: %s | Phone: %s | Email: %s\n", all[i]->name, all[i]->phone, all[i]->email);
+    if (n == 0) printf("No contacts available.\n");
+    printf("---------------------\n");
+    free(all);
+}
+
+// ---------------- Parallel Bulk Build ----------------
+// Builds the table from n contacts with `threads` workers and no locks.
+// Partition p owns the bucket range [p*tableSize/threads, (p+1)*tableSize/threads),
+// i.e. it is chosen by the high part of the bucket index.
+//   1. Hash: each worker hashes its slice of the input and counts how many
+//      contacts land in each partition.
+//   2. Scatter: prefix sums over the (worker, partition) counts give every
+//      worker a private output range per partition, so grouping the input by
+//      partition needs no atomics.
+//   3. Insert: worker p links partition p into its own buckets.
+// The trigram index is shared by all buckets, so it is filled afterwards on
+// the calling thread.
+#define MAX_BUILD_THREADS 64
+
+typedef struct {
+    int id, threads, phase;
+    Contact* data;
+    int n;
+    unsigned int* slots;   // bucket of every input contact
+    int* order;            // input indexes grouped by partition
+    long* cursor;          // [worker][partition] counts, then write positions
+    long* partStart;       // first position of each partition in order
+    long added;
+} BuildWorker;
+
+int partitionOf(unsigned int slot, int threads) {
+    return (int)((unsigned long long)slot * threads / tableSize);
+}
+
+void* bulkBuildWorker(void* arg) {
+    BuildWorker* w = (BuildWorker*)arg;
+    int from = (int)((long)w->n * w->id / w->threads);
+    int to = (int)((long)w->n * (w->id + 1) / w->threads);
+    long* mine = w->cursor + (long)w->id * w->threads;
+
+    if (w->phase == 1) {
+        for (int i = from; i < to; i++) {
+            w->slots[i] = hashName(w->data[i].name) % tableSize;
+            mine[partitionOf(w->slots[i], w->threads)]++;
+        }
+    } else if (w->phase == 2) {
+        for (int i = from; i < to; i++)
+            w->order[mine[partitionOf(w->slots[i], w->threads)]++] = i;
+    } else {
+        for (long k = w->partStart[w->id]; k < w->partStart[w->id + 1]; k++) {
+            Contact* src = &w->data[w->order[k]];
+            unsigned int index = w->slots[w->order[k]];
+            Contact* temp = hashTable[index];
+            while (temp != NULL && strcmp(temp->name, src->name) != 0) temp = temp->next;
+            if (temp != NULL) continue;   // duplicate name: first one wins, as with insertIfAbsent
+            Contact* c = createContact(src->name, src->phone, src->email);
+            c->next = hashTable[index];
+            hashTable[index] = c;
+            w->added++;
+        }
+    }
+    return NULL;
+}
+
+// Run one phase on every worker and wait for all of them
+void runBuildPhase(BuildWorker* workers, int threads, int phase) {
+    pthread_t tids[MAX_BUILD_THREADS];
+    for (int t = 0; t < threads; t++) {
+        workers[t].phase = phase;
+        pthread_create(&tids[t], NULL, bulkBuildWorker, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+}
+
+// Replace the empty table with one sized for n and fill it from data;
+// returns the number of contacts added (duplicate names are skipped)
+long bulkBuild(Contact* data, int n, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > MAX_BUILD_THREADS) threads = MAX_BUILD_THREADS;
+    finishResize();
+    free(hashTable);
+    initTable(nextPrime(n > TABLE_SIZE ? n : TABLE_SIZE));
+
+    unsigned int* slots = (unsigned int*)malloc((n > 0 ? n : 1) * sizeof(unsigned int));
+    int* order = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    long* cursor = (long*)calloc((size_t)threads * threads, sizeof(long));
+    long partStart[MAX_BUILD_THREADS + 1];
+    BuildWorker workers[MAX_BUILD_THREADS];
+    for (int t = 0; t < threads; t++)
+        workers[t] = (BuildWorker){t, threads, 0, data, n, slots, order, cursor, partStart, 0};
+
+    runBuildPhase(workers, threads, 1);
+
+    // Counts -> write positions: partition-major, then worker, keeping input order
+    long pos = 0;
+    for (int p = 0; p < threads; p++) {
+        partStart[p] = pos;
+        for (int t = 0; t < threads; t++) {
+            long count = cursor[(long)t * threads + p];
+            cursor[(long)t * threads + p] = pos;
+            pos += count;
+        }
+    }
+    partStart[threads] = pos;
+
+    runBuildPhase(workers, threads, 2);
+    runBuildPhase(workers, threads, 3);
+
+    long added = 0;
+    for (int t = 0; t < threads; t++) added += workers[t].added;
+    contactCount += added;
+    if (trigramIndexOn) {
+        for (unsigned int i = 0; i < tableSize; i++)
+            for (Contact* c = hashTable[i]; c != NULL; c = c->next) indexContact(c);
+    }
+    free(slots);
+    free(order);
+    free(cursor);
+    return added;
+}
+
+// Load name,phone,email lines from a CSV file. An empty store is built with
+// bulkBuild on every core; otherwise the contacts are added one by one.
+void loadContactsFromFile(char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (fp == NULL) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+    int n = 0, capacity = 1024;
+    Contact* data = (Contact*)malloc(capacity * sizeof(Contact));
+    char line[NAME_LEN + PHONE_LEN + EMAIL_LEN + 8];
+    int first = 1;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "\r\n")] = 0;
+        char* phone = strchr(line, ',');
+        char* email = phone ? strchr(phone + 1, ',') : NULL;
+        if (email == NULL) continue;
+        *phone++ = 0;
+        *email++ = 0;
+        if (first && strcmp(line, "name") == 0) { first = 0; continue; }   // header row
+        first = 0;
+        if (line[0] == 0 || strlen(line) >= NAME_LEN || strlen(phone) >= PHONE_LEN || strlen(email) >= EMAIL_LEN)
+            continue;
+        if (n == capacity) data = (Contact*)realloc(data, (capacity *= 2) * sizeof(Contact));
+        strcpy(data[n].name, line);
+        strcpy(data[n].phone, phone);
+        strcpy(data[n].email, email);
+        traceRecord(TRACE_INSERT, line, phone, email, 0);
+        n++;
+    }
+    fclose(fp);
+
+    long added = 0;
+    if (contactCount == 0) {
+        added = bulkBuild(data, n, (int)sysconf(_SC_NPROCESSORS_ONLN));
+    } else {
+        for (int i = 0; i < n; i++) {
+            long before = contactCount;
+            insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+            added += contactCount - before;
+        }
+    }
+    free(data);
+    printf("Loaded %ld contacts from %s (%d lines read)\n", added, filename, n);
+}
+
 // Free all memory
 void freeContacts() {
-    for (int i = 0; i < TABLE_SIZE; i++) {
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++) {
         Contact* temp = hashTable[i];
         while (temp != NULL) {
             Contact* next = temp->next;
+            free(temp->gramPos);
             free(temp);
             temp = next;
         }
         hashTable[i] = NULL;
     }
+    contactCount = 0;
+    freeTrigramIndex();
+}
+
+// Print the closest names to a query
+void displayFuzzyMatches(char* name) {
+    Contact* results[FUZZY_TOP_K];
+    int dists[FUZZY_TOP_K];
+    int found = fuzzySearch(name, FUZZY_MAX_DIST, FUZZY_TOP_K, results, dists);
+    if (found == 0) {
+        printf("No similar contacts found.\n");
+        return;
+    }
+    for (int i = 0; i < found; i++)
+        printf("Name: %s | Phone: %s | Email: %s (distance %d)\n",
+               results[i]->name, results[i]->phone, results[i]->email, dists[i]);
 }
 
 // Menu-driven program
 int main() {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    char line[BATCH_MAX_NAMES * NAME_LEN];
+    traceOpenFromEnv();
+    initTable(TABLE_SIZE);
 
     while (1) {
         printf("\nContact Management System (Hash Map)\n");
@@ -142,6 +826,11 @@ int main() {
         printf("4. Delete Contact\n");
         printf("5. Display All Contacts\n");
         printf("6. Exit\n");
+        printf("7. Fuzzy Search Contact\n");
+        printf("8. Insert or Update Contact\n");
+        printf("9. Display Contacts Sorted by Name\n");
+        printf("10. Load Contacts from CSV File\n");
+        printf("11. Search Several Contacts\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -154,18 +843,22 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
                 insertContact(name, phone, email);
                 break;
             case 2:
                 printf("Enter Name to Search: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
                 {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
                     Contact* c = searchContact(name);
                     if (c != NULL)
                         printf("Found: %s | Phone: %s | Email: %s\n",
                                c->name, c->phone, c->email);
-                    else
-                        printf("Contact not found.\n");
+                    else {
+                        printf("Contact not found. Did you mean:\n");
+                        displayFuzzyMatches(name);
+                    }
                 }
                 break;
             case 3:
@@ -175,11 +868,13 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter New Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
                 updateContact(name, phone, email);
                 break;
             case 4:
                 printf("Enter Name to Delete: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
                 deleteContact(name);
                 break;
             case 5:
@@ -188,7 +883,36 @@ int main() {
             case 6:
                 freeContacts();
                 printf("Exiting...\n");
+                traceClose();
                 exit(0);
+            case 7:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                displayFuzzyMatches(name);
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
+            case 9:
+                displaySortedContacts();
+                break;
+            case 10:
+                printf("Enter File Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                loadContactsFromFile(name);
+                break;
+            case 11:
+                printf("Enter Names, Separated by Commas: ");
+                fgets(line, sizeof(line), stdin); line[strcspn(line, "\n")] = 0;
+                displayManyContacts(line);
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
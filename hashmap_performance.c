@@ -2,50 +2,362 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "perfcount.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
 #define EMAIL_LEN 50
 #define TABLE_SIZE 101   // prime number for better distribution
+#define TRIGRAM_BITS 16
+#define TRIGRAM_BUCKETS (1 << TRIGRAM_BITS)
+#define FUZZY_MAX_DIST 2
+#define FUZZY_TOP_K 5
+#define FUZZY_LONG_LIST 64   // posting lists over contactCount / 64 are skipped when possible
+#define FUZZY_QUERIES 1000
+#define BATCH_LANES 16    // lookups kept in flight by searchMany
+#define BATCH_SIZE 256    // names per searchMany call in the benchmark
+#define MAX_LOAD 1        // grow when contacts exceed buckets * MAX_LOAD
+#define MIGRATE_BUCKETS 4 // old buckets moved per operation while growing
 
 typedef struct Contact {
     char name[NAME_LEN];
     char phone[PHONE_LEN];
     char email[EMAIL_LEN];
     struct Contact* next;
+    int* gramPos;               // slot in each of its trigrams' posting lists (trigram index only)
 } Contact;
 
-Contact* hashTable[TABLE_SIZE] = {NULL};
+// Bucket array; TABLE_SIZE buckets unless a benchmark sizes it for its data
+Contact** hashTable = NULL;
+unsigned int tableSize = 0;
+long contactCount = 0;
+
+// Wall-clock milliseconds, for phases that run on several threads
+double wallMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
 
 // ---------------- Hash Functions ----------------
-unsigned int hash(char* str) {
+unsigned long hashName(char* str) {
     unsigned long hash = 5381;
     int c;
     while ((c = *str++))
         hash = ((hash << 5) + hash) + c; // hash * 33 + c
-    return hash % TABLE_SIZE;
+    return hash;
+}
+
+unsigned int hash(char* str) {
+    return hashName(str) % tableSize;
+}
+
+// Smallest prime >= n, for sizing the table to the data
+unsigned int nextPrime(unsigned int n) {
+    if (n < 3) return 3;
+    for (n |= 1; ; n += 2) {
+        int prime = 1;
+        for (unsigned int d = 3; d * d <= n; d += 2)
+            if (n % d == 0) { prime = 0; break; }
+        if (prime) return n;
+    }
+}
+
+// Replace the (empty) table with one of the given size
+void initTable(unsigned int size) {
+    countedFree(hashTable, tableSize * sizeof(Contact*));
+    hashTable = (Contact**)countedMalloc(size * sizeof(Contact*));
+    memset(hashTable, 0, size * sizeof(Contact*));
+    tableSize = size;
+}
+
+// ---------------- Resizing ----------------
+// Off by default so the fixed-size benchmarks stay comparable. Growing
+// allocates a table about twice the size; RESIZE_FULL rehashes everything at
+// once, RESIZE_INCREMENTAL keeps the old table alongside and every operation
+// moves MIGRATE_BUCKETS old buckets, in index order, into the new one.
+// Because buckets move in order, a name whose old bucket is below
+// migrateIndex is in the new table and any other name is still in the old
+// one: each lookup probes exactly one of the two tables.
+enum { RESIZE_NONE, RESIZE_FULL, RESIZE_INCREMENTAL };
+int resizeMode = RESIZE_NONE;
+Contact** oldTable = NULL;        // table being drained, NULL when not growing
+unsigned int oldSize = 0;
+unsigned int migrateIndex = 0;    // old buckets below this have been moved
+int resizes = 0;
+
+// Bucket that holds name, or will hold it once inserted
+Contact** bucketFor(char* name) {
+    unsigned long h = hashName(name);
+    if (oldTable != NULL && h % oldSize >= migrateIndex) return &oldTable[h % oldSize];
+    return &hashTable[h % tableSize];
+}
+
+void migrateBuckets(unsigned int count) {
+    while (oldTable != NULL && count-- > 0) {
+        Contact* c = oldTable[migrateIndex];
+        while (c != NULL) {
+            Contact* next = c->next;
+            unsigned int index = hashName(c->name) % tableSize;
+            c->next = hashTable[index];
+            hashTable[index] = c;
+            c = next;
+        }
+        oldTable[migrateIndex++] = NULL;
+        if (migrateIndex == oldSize) {
+            countedFree(oldTable, oldSize * sizeof(Contact*));
+            oldTable = NULL;
+        }
+    }
+}
+
+// Move whatever is left, for walks over every bucket
+void finishResize() {
+    if (oldTable != NULL) migrateBuckets(oldSize - migrateIndex);
+}
+
+void maybeGrow() {
+    if (resizeMode == RESIZE_NONE || oldTable != NULL || contactCount <= (long)tableSize * MAX_LOAD) return;
+    oldTable = hashTable;
+    oldSize = tableSize;
+    migrateIndex = 0;
+    tableSize = nextPrime(tableSize * 2);
+    hashTable = (Contact**)countedCalloc(tableSize, sizeof(Contact*));
+    resizes++;
+    if (resizeMode == RESIZE_FULL) finishResize();
 }
 
 Contact* createContact(char* name, char* phone, char* email) {
-    Contact* newContact = (Contact*)malloc(sizeof(Contact));
+    Contact* newContact = (Contact*)countedMalloc(sizeof(Contact));
     strcpy(newContact->name, name);
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
     newContact->next = NULL;
+    newContact->gramPos = NULL;
     return newContact;
 }
 
+// ---------------- Trigram Index (fuzzy search) ----------------
+// Every name is lower-cased, padded as "$$name$" and split into trigrams.
+// Each trigram hashes to a posting list of contacts containing it. A name
+// within edit distance k of the query shares at least T - 3k of the query's
+// T trigrams, so only contacts reaching that count are verified with the
+// bit-parallel (Myers) edit distance.
+typedef struct {
+    Contact* contact;
+    int gram;          // which of the contact's trigrams, to find its gramPos entry
+} Posting;
+
+typedef struct {
+    Posting* items;
+    int count;
+    int capacity;
+} PostingList;
+
+PostingList trigramIndex[TRIGRAM_BUCKETS];
+int trigramIndexOn = 1;
+
+// Lower-case and pad a name; returns the padded length
+int padName(const char* name, char* out) {
+    int len = 0;
+    out[len++] = '$';
+    out[len++] = '$';
+    for (; *name && len < NAME_LEN + 2; name++)
+        out[len++] = (*name >= 'A' && *name <= 'Z') ? *name - 'A' + 'a' : *name;
+    out[len++] = '$';
+    return len;
+}
+
+unsigned int trigramHash(const char* s) {
+    unsigned int h = ((unsigned char)s[0] << 16) | ((unsigned char)s[1] << 8) | (unsigned char)s[2];
+    h *= 2654435761u;
+    return h >> (32 - TRIGRAM_BITS);
+}
+
+// Distinct trigram buckets of a name; returns how many were written
+int nameTrigrams(const char* name, unsigned int* out) {
+    char padded[NAME_LEN + 4];
+    int len = padName(name, padded);
+    int n = 0;
+    for (int i = 0; i + 3 <= len; i++) {
+        unsigned int h = trigramHash(padded + i);
+        int seen = 0;
+        for (int j = 0; j < n; j++)
+            if (out[j] == h) { seen = 1; break; }
+        if (!seen) out[n++] = h;
+    }
+    return n;
+}
+
+void indexContact(Contact* c) {
+    unsigned int grams[NAME_LEN + 2];
+    int n = nameTrigrams(c->name, grams);
+    c->gramPos = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        PostingList* list = &trigramIndex[grams[i]];
+        if (list->count == list->capacity) {
+            list->capacity = list->capacity ? list->capacity * 2 : 4;
+            list->items = (Posting*)realloc(list->items, list->capacity * sizeof(Posting));
+        }
+        c->gramPos[i] = list->count;
+        list->items[list->count++] = (Posting){c, i};
+    }
+}
+
+// Swap-remove from each list at the recorded slot; the contact moved into
+// that slot gets its own record updated, so no list is searched
+void unindexContact(Contact* c) {
+    if (c->gramPos == NULL) return;
+    unsigned int grams[NAME_LEN + 2];
+    int n = nameTrigrams(c->name, grams);
+    for (int i = 0; i < n; i++) {
+        PostingList* list = &trigramIndex[grams[i]];
+        Posting last = list->items[--list->count];
+        list->items[c->gramPos[i]] = last;
+        last.contact->gramPos[last.gram] = c->gramPos[i];
+    }
+    free(c->gramPos);
+    c->gramPos = NULL;
+}
+
+void freeTrigramIndex() {
+    for (int i = 0; i < TRIGRAM_BUCKETS; i++) {
+        free(trigramIndex[i].items);
+        trigramIndex[i].items = NULL;
+        trigramIndex[i].count = trigramIndex[i].capacity = 0;
+    }
+}
+
+// Edit distance between query and name (case-insensitive), using Myers'
+// bit-vector algorithm; gives up and returns maxDist + 1 once the distance
+// can no longer come back under maxDist. Names fit in one 64-bit word.
+int boundedEditDistance(const char* query, const char* name, int maxDist) {
+    unsigned long long peq[256] = {0};
+    int m = 0;
+    for (; query[m]; m++) {
+        unsigned char ch = query[m];
+        if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+        peq[ch] |= 1ULL << m;
+    }
+    int n = strlen(name);
+    if (m == 0) return n <= maxDist ? n : maxDist + 1;
+    if (abs(m - n) > maxDist) return maxDist + 1;
+
+    unsigned long long pv = ~0ULL, mv = 0, last = 1ULL << (m - 1);
+    int score = m;
+    for (int j = 0; j < n; j++) {
+        unsigned char ch = name[j];
+        if (ch >= 'A' && ch <= 'Z') ch = ch - 'A' + 'a';
+        unsigned long long eq = peq[ch];
+        unsigned long long xv = eq | mv;
+        unsigned long long xh = (((eq & pv) + pv) ^ pv) | eq;
+        unsigned long long ph = mv | ~(xh | pv);
+        unsigned long long mh = pv & xh;
+        if (ph & last) score++;
+        else if (mh & last) score--;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        if (score - (n - j - 1) > maxDist) return maxDist + 1;
+    }
+    return score;
+}
+
+// Insert a match into results/dists, kept sorted by distance, at most k long
+void addMatch(Contact* c, int d, int k, Contact** results, int* dists, int* found) {
+    int pos = *found < k ? (*found)++ : k;
+    while (pos > 0 && dists[pos - 1] > d) {
+        if (pos < k) { results[pos] = results[pos - 1]; dists[pos] = dists[pos - 1]; }
+        pos--;
+    }
+    if (pos < k) { results[pos] = c; dists[pos] = d; }
+}
+
+// Find up to k contacts within maxDist edits of query, closest first.
+// Returns the number of matches written to results/dists.
+int fuzzySearch(char* query, int maxDist, int k, Contact** results, int* dists) {
+    unsigned int grams[NAME_LEN + 2];
+    int t = nameTrigrams(query, grams);
+    int need = t - 3 * maxDist;
+    int found = 0;
+
+    // Too short for the trigram filter: every contact is a candidate
+    if (need < 1) {
+        finishResize();
+        for (unsigned int i = 0; i < tableSize; i++)
+            for (Contact* c = hashTable[i]; c != NULL; c = c->next) {
+                int d = boundedEditDistance(query, c->name, maxDist);
+                if (d <= maxDist) addMatch(c, d, k, results, dists, &found);
+            }
+        return found;
+    }
+
+    // Skip the longest lists (padded prefixes such as "$$a" hold about 1/26 of
+    // all names) while they exceed contactCount / FUZZY_LONG_LIST. A match can
+    // miss at most one hit per skipped list, so need drops by one for each and
+    // the results are unchanged; only fewer postings are counted.
+    int skipped[NAME_LEN + 2] = {0};
+    long longList = contactCount / FUZZY_LONG_LIST;
+    while (need > 1) {
+        int longest = -1;
+        for (int i = 0; i < t; i++)
+            if (!skipped[i] && (longest < 0 || trigramIndex[grams[i]].count > trigramIndex[grams[longest]].count))
+                longest = i;
+        if (trigramIndex[grams[longest]].count <= longList) break;
+        skipped[longest] = 1;
+        need--;
+    }
+
+    // Count trigram hits per candidate in a small open-addressed table
+    int total = 0;
+    for (int i = 0; i < t; i++)
+        if (!skipped[i]) total += trigramIndex[grams[i]].count;
+    int cap = 16;
+    while (cap < 2 * total) cap <<= 1;
+    Contact** keys = (Contact**)calloc(cap, sizeof(Contact*));
+    unsigned char* counts = (unsigned char*)calloc(cap, 1);
+
+    for (int i = 0; i < t; i++) {
+        if (skipped[i]) continue;
+        PostingList* list = &trigramIndex[grams[i]];
+        for (int j = 0; j < list->count; j++) {
+            Contact* c = list->items[j].contact;
+            unsigned int slot = (unsigned int)(((unsigned long)c >> 4) * 2654435761u) & (cap - 1);
+            while (keys[slot] != NULL && keys[slot] != c) slot = (slot + 1) & (cap - 1);
+            keys[slot] = c;
+            counts[slot]++;
+        }
+    }
+
+    for (int s = 0; s < cap; s++) {
+        if (keys[s] == NULL || counts[s] < need) continue;
+        int d = boundedEditDistance(query, keys[s]->name, maxDist);
+        if (d <= maxDist) addMatch(keys[s], d, k, results, dists, &found);
+    }
+
+    free(keys);
+    free(counts);
+    return found;
+}
+
 // ---------------- Core Operations ----------------
 void insertContact(char* name, char* phone, char* email) {
-    unsigned int index = hash(name);
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
     Contact* newContact = createContact(name, phone, email);
-    newContact->next = hashTable[index];
-    hashTable[index] = newContact;
+    newContact->next = *bucket;
+    *bucket = newContact;
+    contactCount++;
+    if (trigramIndexOn) indexContact(newContact);
+    maybeGrow();
 }
 
 Contact* searchContact(char* name) {
-    unsigned int index = hash(name);
-    Contact* temp = hashTable[index];
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact* temp = *bucketFor(name);
     while (temp != NULL) {
         if (strcmp(temp->name, name) == 0) return temp;
         temp = temp->next;
@@ -60,9 +372,83 @@ void updateContact(char* name, char* newPhone, char* newEmail) {
     if (newEmail != NULL) strcpy(contact->email, newEmail);
 }
 
+// Look up count names at once; results[i] gets the contact or NULL.
+// All bucket heads are hashed and prefetched first, then BATCH_LANES chain
+// walks are interleaved (AMAC): each pass compares one node per lane and
+// prefetches that lane's next node, so misses on different chains overlap
+// instead of stalling one lookup at a time. While the table grows each name
+// is resolved to its old or new bucket with bucketFor; nothing migrates
+// during the batch, so a batch never pays for moving buckets.
+void searchMany(char** names, int count, Contact** results) {
+    Contact*** slots = (Contact***)malloc((count > 0 ? count : 1) * sizeof(Contact**));
+    for (int i = 0; i < count; i++) {
+        slots[i] = bucketFor(names[i]);
+        __builtin_prefetch(slots[i]);
+    }
+
+    Contact* cur[BATCH_LANES];
+    int who[BATCH_LANES];
+    int next = 0, active = 0;
+    for (int l = 0; l < BATCH_LANES; l++) {
+        if (next < count) {
+            who[l] = next;
+            cur[l] = *slots[next++];
+            __builtin_prefetch(cur[l]);
+            active++;
+        } else {
+            who[l] = -1;
+        }
+    }
+
+    while (active > 0) {
+        for (int l = 0; l < BATCH_LANES; l++) {
+            if (who[l] < 0) continue;
+            Contact* c = cur[l];
+            if (c != NULL && strcmp(c->name, names[who[l]]) != 0) {
+                cur[l] = c->next;
+                __builtin_prefetch(cur[l]);
+                continue;
+            }
+            // lane finished: record the result and start the next lookup
+            results[who[l]] = c;
+            if (next < count) {
+                who[l] = next;
+                cur[l] = *slots[next++];
+                __builtin_prefetch(cur[l]);
+            } else {
+                who[l] = -1;
+                active--;
+            }
+        }
+    }
+    free(slots);
+}
+
+Contact* insertIfAbsent(char* name, char* phone, char* email) {
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
+    for (Contact* temp = *bucket; temp != NULL; temp = temp->next)
+        if (strcmp(temp->name, name) == 0) return temp;
+    Contact* newContact = createContact(name, phone, email);
+    newContact->next = *bucket;
+    *bucket = newContact;
+    contactCount++;
+    if (trigramIndexOn) indexContact(newContact);
+    maybeGrow();
+    return newContact;
+}
+
+Contact* upsertContact(char* name, char* phone, char* email) {
+    Contact* contact = insertIfAbsent(name, phone, email);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    return contact;
+}
+
 void deleteContact(char* name) {
-    unsigned int index = hash(name);
-    Contact* temp = hashTable[index];
+    migrateBuckets(MIGRATE_BUCKETS);
+    Contact** bucket = bucketFor(name);
+    Contact* temp = *bucket;
     Contact* prev = NULL;
 
     while (temp != NULL && strcmp(temp->name, name) != 0) {
@@ -70,15 +456,18 @@ void deleteContact(char* name) {
         temp = temp->next;
     }
     if (temp == NULL) return;
-    if (prev == NULL) hashTable[index] = temp->next;
+    if (prev == NULL) *bucket = temp->next;
     else prev->next = temp->next;
-    free(temp);
+    if (trigramIndexOn) unindexContact(temp);
+    countedFree(temp, sizeof(Contact));
+    contactCount--;
 }
 
 void displayContacts() {
     printf("\n--- Contact List ---\n");
     int empty = 1;
-    for (int i = 0; i < TABLE_SIZE; i++) {
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++) {
         Contact* temp = hashTable[i];
         while (temp != NULL) {
             printf("Name: %s | Phone: %s | Email: %s\n",
@@ -92,15 +481,316 @@ void displayContacts() {
 }
 
 void freeContacts() {
-    for (int i = 0; i < TABLE_SIZE; i++) {
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++) {
         Contact* temp = hashTable[i];
         while (temp != NULL) {
             Contact* next = temp->next;
-            free(temp);
+            free(temp->gramPos);
+            countedFree(temp, sizeof(Contact));
             temp = next;
         }
         hashTable[i] = NULL;
     }
+    contactCount = 0;
+    freeTrigramIndex();
+}
+
+// ---------------- Sorted Export ----------------
+// Contacts are gathered into an array of pointers and sorted by name with an
+// MSD radix sort: one counting pass per byte position splits a range into 256
+// buckets (bucket 0 holds names that end there, already in order) and each
+// bucket is sorted on the next byte. Ranges under RADIX_CUTOFF fall back to
+// insertion sort on the remaining suffix. The first-byte buckets are
+// independent, so worker threads claim them from a shared counter.
+#define RADIX_CUTOFF 32
+#define MAX_SORT_THREADS 64
+
+void insertionSortNames(Contact** a, int n, int depth) {
+    for (int i = 1; i < n; i++) {
+        Contact* c = a[i];
+        int j = i;
+        while (j > 0 && strcmp(a[j - 1]->name + depth, c->name + depth) > 0) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = c;
+    }
+}
+
+// Distribute a[0..n) by the byte at depth; bucket b ends up in [start[b], start[b+1])
+void radixPass(Contact** a, Contact** tmp, int n, int depth, int* start) {
+    int count[256] = {0};
+    int pos[256];
+    for (int i = 0; i < n; i++) count[(unsigned char)a[i]->name[depth]]++;
+    start[0] = 0;
+    for (int b = 0; b < 256; b++) start[b + 1] = start[b] + count[b];
+    memcpy(pos, start, sizeof(pos));
+    for (int i = 0; i < n; i++) tmp[pos[(unsigned char)a[i]->name[depth]]++] = a[i];
+    memcpy(a, tmp, n * sizeof(Contact*));
+}
+
+void msdRadixSort(Contact** a, Contact** tmp, int n, int depth) {
+    if (n < RADIX_CUTOFF) {
+        insertionSortNames(a, n, depth);
+        return;
+    }
+    if (depth >= NAME_LEN - 1) return;
+    int start[257];
+    radixPass(a, tmp, n, depth, start);
+    for (int b = 1; b < 256; b++)
+        if (start[b + 1] - start[b] > 1)
+            msdRadixSort(a + start[b], tmp + start[b], start[b + 1] - start[b], depth + 1);
+}
+
+typedef struct {
+    Contact** a;
+    Contact** tmp;
+    int* start;     // first-byte bucket bounds
+    int next;       // next bucket to claim
+} SortJob;
+
+void* radixSortWorker(void* arg) {
+    SortJob* job = (SortJob*)arg;
+    int b;
+    while ((b = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < 256) {
+        int lo = job->start[b], len = job->start[b + 1] - lo;
+        if (b > 0 && len > 1) msdRadixSort(job->a + lo, job->tmp + lo, len, 1);
+    }
+    return NULL;
+}
+
+// Sort a[0..n) by name using up to threads workers
+void sortByName(Contact** a, int n, int threads) {
+    Contact** tmp = (Contact**)malloc((n > 0 ? n : 1) * sizeof(Contact*));
+    if (threads > MAX_SORT_THREADS) threads = MAX_SORT_THREADS;
+    if (threads <= 1 || n < RADIX_CUTOFF) {
+        msdRadixSort(a, tmp, n, 0);
+        free(tmp);
+        return;
+    }
+    int start[257];
+    radixPass(a, tmp, n, 0, start);
+    SortJob job = {a, tmp, start, 0};
+    pthread_t tids[MAX_SORT_THREADS];
+    for (int t = 0; t < threads; t++) pthread_create(&tids[t], NULL, radixSortWorker, &job);
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    free(tmp);
+}
+
+// Every contact in name order; the caller frees the array
+Contact** sortedContacts(int* count, int threads) {
+    int n = 0;
+    finishResize();
+    for (unsigned int i = 0; i < tableSize; i++)
+        for (Contact* temp = hashTable[i]; temp != NULL; temp = temp->next) n++;
+    Contact** all = (Contact**)malloc((n > 0 ? n : 1) * sizeof(Contact*));
+    n = 0;
+    for (unsigned int i = 0; i < tableSize; i++)
+        for (Contact* temp = hashTable[i]; temp != NULL; temp = temp->next) all[n++] = temp;
+    sortByName(all, n, threads);
+    *count = n;
+    return all;
+}
+
+void writeContactLine(FILE* out, Contact* c) {
+    fputs(c->name, out);
+    fputc(',', out);
+    fputs(c->phone, out);
+    fputc(',', out);
+    fputs(c->email, out);
+    fputc('\n', out);
+}
+
+// Stream every contact as name,phone,email lines in name order
+int exportSorted(FILE* out, int threads) {
+    int n;
+    Contact** all = sortedContacts(&n, threads);
+    for (int i = 0; i < n; i++) writeContactLine(out, all[i]);
+    free(all);
+    return n;
+}
+
+// Baseline for the export benchmark: copy the table into an AVL tree of
+// contact pointers and walk it in order, as producing sorted output required
+// before sortedContacts existed.
+typedef struct ExportNode {
+    Contact* contact;
+    struct ExportNode* left;
+    struct ExportNode* right;
+    int height;
+} ExportNode;
+
+int exportHeight(ExportNode* n) { return n ? n->height : 0; }
+
+void exportFix(ExportNode* n) {
+    int l = exportHeight(n->left), r = exportHeight(n->right);
+    n->height = (l > r ? l : r) + 1;
+}
+
+ExportNode* exportRotate(ExportNode* n, int toRight) {
+    ExportNode* up = toRight ? n->left : n->right;
+    if (toRight) { n->left = up->right; up->right = n; }
+    else { n->right = up->left; up->left = n; }
+    exportFix(n);
+    exportFix(up);
+    return up;
+}
+
+ExportNode* exportInsert(ExportNode* node, Contact* c) {
+    if (node == NULL) {
+        node = (ExportNode*)countedMalloc(sizeof(ExportNode));
+        node->contact = c;
+        node->left = node->right = NULL;
+        node->height = 1;
+        return node;
+    }
+    if (strcmp(c->name, node->contact->name) < 0) node->left = exportInsert(node->left, c);
+    else node->right = exportInsert(node->right, c);
+    exportFix(node);
+    int balance = exportHeight(node->left) - exportHeight(node->right);
+    if (balance > 1) {
+        if (strcmp(c->name, node->left->contact->name) >= 0) node->left = exportRotate(node->left, 0);
+        return exportRotate(node, 1);
+    }
+    if (balance < -1) {
+        if (strcmp(c->name, node->right->contact->name) < 0) node->right = exportRotate(node->right, 1);
+        return exportRotate(node, 0);
+    }
+    return node;
+}
+
+void exportWalk(FILE* out, ExportNode* node) {
+    if (node == NULL) return;
+    exportWalk(out, node->left);
+    writeContactLine(out, node->contact);
+    exportWalk(out, node->right);
+}
+
+void exportFree(ExportNode* node) {
+    if (node == NULL) return;
+    exportFree(node->left);
+    exportFree(node->right);
+    countedFree(node, sizeof(ExportNode));
+}
+
+// ---------------- Parallel Bulk Build ----------------
+// Builds the table from n contacts with `threads` workers and no locks.
+// Partition p owns the bucket range [p*tableSize/threads, (p+1)*tableSize/threads),
+// i.e. it is chosen by the high part of the bucket index.
+//   1. Hash: each worker hashes its slice of the input and counts how many
+//      contacts land in each partition.
+//   2. Scatter: prefix sums over the (worker, partition) counts give every
+//      worker a private output range per partition, so grouping the input by
+//      partition needs no atomics.
+//   3. Insert: worker p links partition p into its own buckets, allocating
+//      from malloc's per-thread arenas and keeping its byte counts locally.
+// Stitching is then only adding those counts to the global accounting, since
+// the bucket ranges are disjoint and already in place.
+#define MAX_BUILD_THREADS 64
+
+typedef struct {
+    int id, threads, phase;
+    Contact* data;
+    int n;
+    unsigned int* slots;   // bucket of every input contact
+    int* order;            // input indexes grouped by partition
+    long* cursor;          // [worker][partition] counts, then write positions
+    long* partStart;       // first position of each partition in order
+    size_t bytes, usable;
+    long allocs;
+} BuildWorker;
+
+int partitionOf(unsigned int slot, int threads) {
+    return (int)((unsigned long long)slot * threads / tableSize);
+}
+
+void* bulkBuildWorker(void* arg) {
+    BuildWorker* w = (BuildWorker*)arg;
+    int from = (int)((long)w->n * w->id / w->threads);
+    int to = (int)((long)w->n * (w->id + 1) / w->threads);
+    long* mine = w->cursor + (long)w->id * w->threads;
+
+    if (w->phase == 1) {
+        for (int i = from; i < to; i++) {
+            w->slots[i] = hash(w->data[i].name);
+            mine[partitionOf(w->slots[i], w->threads)]++;
+        }
+    } else if (w->phase == 2) {
+        for (int i = from; i < to; i++)
+            w->order[mine[partitionOf(w->slots[i], w->threads)]++] = i;
+    } else {
+        for (long k = w->partStart[w->id]; k < w->partStart[w->id + 1]; k++) {
+            Contact* src = &w->data[w->order[k]];
+            unsigned int index = w->slots[w->order[k]];
+            Contact* temp = hashTable[index];
+            while (temp != NULL && strcmp(temp->name, src->name) != 0) temp = temp->next;
+            if (temp != NULL) continue;   // duplicate name: first one wins, as with insertIfAbsent
+            Contact* c = (Contact*)malloc(sizeof(Contact));
+            memcpy(c, src, sizeof(Contact));
+            c->gramPos = NULL;
+            c->next = hashTable[index];
+            hashTable[index] = c;
+            w->bytes += sizeof(Contact);
+            w->usable += malloc_usable_size(c);
+            w->allocs++;
+        }
+    }
+    return NULL;
+}
+
+// Run one phase on every worker and wait for all of them
+void runBuildPhase(BuildWorker* workers, int threads, int phase) {
+    pthread_t tids[MAX_BUILD_THREADS];
+    for (int t = 0; t < threads; t++) {
+        workers[t].phase = phase;
+        pthread_create(&tids[t], NULL, bulkBuildWorker, &workers[t]);
+    }
+    for (int t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+}
+
+// Replace the (empty) table with one sized for n and fill it from data.
+// The trigram index is not maintained.
+void bulkBuild(Contact* data, int n, int threads) {
+    if (threads < 1) threads = 1;
+    if (threads > MAX_BUILD_THREADS) threads = MAX_BUILD_THREADS;
+    initTable(nextPrime(n));
+
+    unsigned int* slots = (unsigned int*)malloc(n * sizeof(unsigned int));
+    int* order = (int*)malloc(n * sizeof(int));
+    long* cursor = (long*)calloc((size_t)threads * threads, sizeof(long));
+    long partStart[MAX_BUILD_THREADS + 1];
+    BuildWorker workers[MAX_BUILD_THREADS];
+    for (int t = 0; t < threads; t++)
+        workers[t] = (BuildWorker){t, threads, 0, data, n, slots, order, cursor, partStart, 0, 0, 0};
+
+    runBuildPhase(workers, threads, 1);
+
+    // Counts -> write positions: partition-major, then worker, keeping input order
+    long pos = 0;
+    for (int p = 0; p < threads; p++) {
+        partStart[p] = pos;
+        for (int t = 0; t < threads; t++) {
+            long count = cursor[(long)t * threads + p];
+            cursor[(long)t * threads + p] = pos;
+            pos += count;
+        }
+    }
+    partStart[threads] = pos;
+
+    runBuildPhase(workers, threads, 2);
+    runBuildPhase(workers, threads, 3);
+
+    // Stitch: fold the per-worker allocation counts into the accounting
+    for (int t = 0; t < threads; t++) {
+        liveBytes += workers[t].bytes;
+        liveUsable += workers[t].usable;
+        liveAllocs += workers[t].allocs;
+        contactCount += workers[t].allocs;
+    }
+    free(slots);
+    free(order);
+    free(cursor);
 }
 
 // ---------------- Random Contact Generator ----------------
@@ -125,7 +815,7 @@ Contact generateContact() {
 //     int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
 //     srand(time(NULL));
 
-//     printf("DataStructure,Operation,Contacts,Time_ms\n");
+//     printf("DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes\n");
 
 //     for (int t = 0; t < num_tests; t++) {
 //         int n = test_sizes[t];
@@ -178,55 +868,468 @@ void benchmarkHashMapToCSV(const char* filename) {
         return;
     }
 
-    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms\n");
+    fputs(RESULT_CSV_HEADER, fp);
+    trigramIndexOn = 0;  // plain hash map, comparable with the other backends
 
     for (int t = 0; t < num_tests; t++) {
         int n = test_sizes[t];
+        resetPeakRSS();
         freeContacts();  // start fresh
+        initTable(TABLE_SIZE);
 
-        Contact temp;
+        Contact data[n];
         Contact* stored[n];  // store pointers for search/update/delete
+        for (int i = 0; i < n; i++) data[i] = generateContact();
 
-        // ---------- Insert ----------
-        clock_t start = clock();
+        // ---------- Insert + Search (two probes) ----------
+        clock_t start = startPhase();
         for (int i = 0; i < n; i++) {
-            temp = generateContact();
-            insertContact(temp.name, temp.phone, temp.email);
-            stored[i] = searchContact(temp.name); // store reference
+            insertContact(data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(data[i].name); // store reference
         }
-        clock_t end = clock();
-        fprintf(fp, "HashMap,Insert,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "HashMap,InsertSearch", n, twoPass);
+        freeContacts();
+
+        // ---------- Insert (insertIfAbsent, one probe) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            stored[i] = insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "HashMap,Insert", n, onePass);
+        printf("HashMap %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
 
         // ---------- Search ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             searchContact(stored[i]->name);
-        end = clock();
-        fprintf(fp, "HashMap,Search,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "HashMap,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
 
         // ---------- Update ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             updateContact(stored[i]->name, "1234567890", "newemail@test.com");
-        end = clock();
-        fprintf(fp, "HashMap,Update,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "HashMap,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            upsertContact(stored[i]->name, "0987654321", "upsert@test.com");
+        end = stopPhase();
+        writeResult(fp, "HashMap,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
 
         // ---------- Delete ----------
-        start = clock();
+        start = startPhase();
         for (int i = 0; i < n; i++)
             deleteContact(stored[i]->name);
-        end = clock();
-        fprintf(fp, "HashMap,Delete,%d,%.3f\n", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+        end = stopPhase();
+        writeResult(fp, "HashMap,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
     }
 
     fclose(fp);
+    trigramIndexOn = 1;
     printf("Hash Map benchmark written to %s\n", filename);
 }
 
+// Apply one random substitution, deletion or insertion to a name
+void addTypo(char* name) {
+    static const char charset[] = "abcdefghijklmnopqrstuvwxyz";
+    int len = strlen(name);
+    int pos = rand() % len;
+    switch (rand() % 3) {
+        case 0: name[pos] = charset[rand() % 26]; break;
+        case 1: memmove(name + pos, name + pos + 1, len - pos); break;
+        default:
+            memmove(name + pos + 1, name + pos, len - pos + 1);
+            name[pos] = charset[rand() % 26];
+    }
+}
+
+// ---------------- Benchmark (Fuzzy Search to CSV) ----------------
+// IndexedInsert = n inserts with the trigram index maintained,
+// ExactSearch / FuzzySearch = FUZZY_QUERIES lookups of one-typo names.
+void benchmarkFuzzyToCSV(const char* filename) {
+    int test_sizes[] = {10000, 100000, 1000000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+    trigramIndexOn = 1;
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        resetPeakRSS();
+        freeContacts();
+        initTable(TABLE_SIZE);
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        char (*queries)[NAME_LEN] = malloc(FUZZY_QUERIES * sizeof(*queries));
+        int* targets = (int*)malloc(FUZZY_QUERIES * sizeof(int));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+        for (int q = 0; q < FUZZY_QUERIES; q++) {
+            targets[q] = rand() % n;
+            strcpy(queries[q], data[targets[q]].name);
+            addTypo(queries[q]);
+        }
+
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++)
+            insertContact(data[i].name, data[i].phone, data[i].email);
+        clock_t end = stopPhase();
+        writeResult(fp, "HashMap,IndexedInsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        int exactHits = 0;
+        start = startPhase();
+        for (int q = 0; q < FUZZY_QUERIES; q++)
+            if (searchContact(queries[q]) != NULL) exactHits++;
+        end = stopPhase();
+        writeResult(fp, "HashMap,ExactSearch", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        int fuzzyHits = 0;
+        Contact* results[FUZZY_TOP_K];
+        int dists[FUZZY_TOP_K];
+        start = startPhase();
+        for (int q = 0; q < FUZZY_QUERIES; q++) {
+            int found = fuzzySearch(queries[q], FUZZY_MAX_DIST, FUZZY_TOP_K, results, dists);
+            for (int r = 0; r < found; r++)
+                if (strcmp(results[r]->name, data[targets[q]].name) == 0) { fuzzyHits++; break; }
+        }
+        end = stopPhase();
+        double ms = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "HashMap,FuzzySearch", n, ms);
+        printf("%d contacts: exact found %d/%d, fuzzy found %d/%d, %.3f ms per fuzzy lookup\n",
+               n, exactHits, FUZZY_QUERIES, fuzzyHits, FUZZY_QUERIES, ms / FUZZY_QUERIES);
+
+        free(data);
+        free(queries);
+        free(targets);
+    }
+
+    freeContacts();
+    fclose(fp);
+    printf("Fuzzy search benchmark written to %s\n", filename);
+}
+
+// ---------------- Benchmark (Batched Lookups to CSV) ----------------
+// Table sized to the data (load factor ~1), n lookups in random order:
+// SearchOne = one searchContact at a time, SearchMany = BATCH_SIZE per call.
+void benchmarkSearchManyToCSV(const char* filename) {
+    int test_sizes[] = {100000, 1000000, 4000000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+    trigramIndexOn = 0;
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        resetPeakRSS();
+        freeContacts();
+        initTable(nextPrime(n));
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        char** queries = (char**)malloc(n * sizeof(char*));
+        Contact** results = (Contact**)malloc(n * sizeof(Contact*));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        }
+        for (int i = 0; i < n; i++) queries[i] = data[rand() % n].name;
+
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++)
+            results[i] = searchContact(queries[i]);
+        clock_t end = stopPhase();
+        double oneMs = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "HashMap,SearchOne", n, oneMs);
+
+        start = startPhase();
+        for (int i = 0; i < n; i += BATCH_SIZE)
+            searchMany(queries + i, (n - i < BATCH_SIZE) ? n - i : BATCH_SIZE, results + i);
+        end = stopPhase();
+        double manyMs = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "HashMap,SearchMany", n, manyMs);
+
+        int found = 0;
+        for (int i = 0; i < n; i++) found += results[i] != NULL;
+        printf("%d contacts: %.2f M lookups/s one at a time, %.2f M lookups/s batched (%d/%d found)\n",
+               n, n / oneMs / 1000, n / manyMs / 1000, found, n);
+
+        free(data);
+        free(queries);
+        free(results);
+    }
+
+    freeContacts();
+    initTable(TABLE_SIZE);
+    trigramIndexOn = 1;
+    fclose(fp);
+    printf("Batched lookup benchmark written to %s\n", filename);
+}
+
+// ---------------- Benchmark (Parallel Bulk Build to CSV) ----------------
+// SerialBuild = insertIfAbsent into a table sized to the data, one contact at
+// a time; BulkBuild_<T>T = bulkBuild with T workers. Times are wall clock
+// (clock() would add up the CPU time of every worker). The counters follow
+// the calling thread only, so they are left empty for the threaded rows.
+void benchmarkBulkBuildToCSV(const char* filename) {
+    int test_sizes[] = {1000000, 4000000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int maxThreads = cores < 2 ? 2 : (cores > MAX_BUILD_THREADS ? MAX_BUILD_THREADS : (int)cores);
+    int threadCounts[8], numCounts = 0;   // powers of two below maxThreads, then maxThreads
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts[numCounts++] = threads;
+    threadCounts[numCounts++] = maxThreads;
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+    trigramIndexOn = 0;
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        resetPeakRSS();
+        freeContacts();
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        initTable(nextPrime(n));
+        double start = wallMs();
+        startPhase();
+        for (int i = 0; i < n; i++)
+            insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        stopPhase();
+        double serialMs = wallMs() - start;
+        writeResult(fp, "HashMap,SerialBuild", n, serialMs);
+        printf("%d contacts: serial build %.1f ms\n", n, serialMs);
+
+        for (int k = 0; k < numCounts; k++) {
+            int threads = threadCounts[k];
+            freeContacts();
+            start = wallMs();
+            startPhase();
+            bulkBuild(data, n, threads);
+            stopPhase();
+            double ms = wallMs() - start;
+            if (threads > 1)
+                discardCounters();
+            char label[64];
+            snprintf(label, sizeof(label), "HashMap,BulkBuild_%dT", threads);
+            writeResult(fp, label, n, ms);
+            int found = 0;
+            for (int i = 0; i < n; i += 97) found += searchContact(data[i].name) != NULL;
+            printf("%d contacts: bulk build with %d threads %.1f ms (%.2fx serial), %ld nodes, %d/%d sampled found\n",
+                   n, threads, ms, serialMs / ms, liveAllocs - 1, found, (n + 96) / 97);
+        }
+        free(data);
+    }
+
+    freeContacts();
+    initTable(TABLE_SIZE);
+    trigramIndexOn = 1;
+    fclose(fp);
+    printf("Bulk build benchmark written to %s\n", filename);
+}
+
+// ---------------- Benchmark (Sorted Export to CSV) ----------------
+// Every variant writes all n contacts in name order to /dev/null through a
+// 1 MB stdio buffer: AVLExport builds an AVL of pointers and walks it,
+// RadixExport_<T>T gathers the table and radix-sorts it with T threads.
+// Wall clock times; the counters are left empty for the threaded rows.
+void benchmarkSortedExportToCSV(const char* filename) {
+    int test_sizes[] = {1000000, 4000000, 10000000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int threadCounts[2] = {1, cores < 2 ? 2 : (cores > MAX_SORT_THREADS ? MAX_SORT_THREADS : (int)cores)};
+    static char outBuf[1 << 20];
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    FILE* out = fopen("/dev/null", "w");
+    if (!fp || !out) {
+        printf("Cannot open file %s\n", fp ? "/dev/null" : filename);
+        if (fp) fclose(fp);
+        return;
+    }
+    setvbuf(out, outBuf, _IOFBF, sizeof(outBuf));
+
+    fputs(RESULT_CSV_HEADER, fp);
+    trigramIndexOn = 0;
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        resetPeakRSS();
+        freeContacts();
+        initTable(nextPrime(n));
+        for (int i = 0; i < n; i++) {
+            Contact c = generateContact();
+            insertContact(c.name, c.phone, c.email);
+        }
+
+        double start = wallMs();
+        startPhase();
+        ExportNode* root = NULL;
+        for (unsigned int i = 0; i < tableSize; i++)
+            for (Contact* c = hashTable[i]; c != NULL; c = c->next) root = exportInsert(root, c);
+        exportWalk(out, root);
+        fflush(out);
+        stopPhase();
+        double avlMs = wallMs() - start;
+        writeResult(fp, "HashMap,AVLExport", n, avlMs);
+        exportFree(root);
+        printf("%d contacts: AVL build + walk %.1f ms\n", n, avlMs);
+
+        for (int k = 0; k < 2; k++) {
+            int threads = threadCounts[k];
+            start = wallMs();
+            startPhase();
+            exportSorted(out, threads);
+            fflush(out);
+            stopPhase();
+            double ms = wallMs() - start;
+            if (threads > 1)
+                discardCounters();
+            char label[64];
+            snprintf(label, sizeof(label), "HashMap,RadixExport_%dT", threads);
+            writeResult(fp, label, n, ms);
+
+            int count, sorted = 1;
+            Contact** all = sortedContacts(&count, threads);
+            for (int i = 1; i < count; i++)
+                if (strcmp(all[i - 1]->name, all[i]->name) > 0) { sorted = 0; break; }
+            free(all);
+            printf("%d contacts: radix export with %d threads %.1f ms (%.2fx AVL), %s\n",
+                   n, threads, ms, avlMs / ms, sorted ? "sorted" : "NOT SORTED");
+        }
+    }
+
+    freeContacts();
+    initTable(TABLE_SIZE);
+    trigramIndexOn = 1;
+    fclose(out);
+    fclose(fp);
+    printf("Sorted export benchmark written to %s\n", filename);
+}
+
+// ---------------- Benchmark (Resizing Latency to CSV) ----------------
+// The table starts at TABLE_SIZE buckets and grows while n contacts are
+// inserted, once with stop-the-world rehashing and once incrementally; then
+// every contact is searched. Each operation is timed on its own, so the tail
+// columns show the stall a full rehash puts on one unlucky insert.
+int compareLatency(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+void writeLatencyRow(FILE* fp, const char* label, int n, unsigned int* ns, double ms) {
+    double sum = 0;
+    for (int i = 0; i < n; i++) sum += ns[i];
+    qsort(ns, n, sizeof(unsigned int), compareLatency);
+    fprintf(fp, "%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%d\n", label, n, ms, sum / n / 1000.0,
+            ns[(long)n * 99 / 100] / 1000.0, ns[(long)n * 999 / 1000] / 1000.0, ns[n - 1] / 1000.0, resizes);
+    printf("%-32s %d: p99.9 %.2f us, max %.2f us, %d resizes\n", label, n,
+           ns[(long)n * 999 / 1000] / 1000.0, ns[n - 1] / 1000.0, resizes);
+}
+
+void benchmarkResizeToCSV(const char* filename) {
+    int test_sizes[] = {1000000, 4000000};
+    int num_tests = sizeof(test_sizes)/sizeof(test_sizes[0]);
+    int modes[] = {RESIZE_FULL, RESIZE_INCREMENTAL};
+    const char* modeNames[] = {"StopTheWorld", "Incremental"};
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms,Avg_us,P99_us,P999_us,Max_us,Resizes\n");
+    trigramIndexOn = 0;
+
+    for (int t = 0; t < num_tests; t++) {
+        int n = test_sizes[t];
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        unsigned int* ns = (unsigned int*)malloc(n * sizeof(unsigned int));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        for (int m = 0; m < 2; m++) {
+            freeContacts();
+            initTable(TABLE_SIZE);
+            resizeMode = modes[m];
+            resizes = 0;
+            struct timespec a, b;
+            char label[64];
+
+            double start = wallMs();
+            for (int i = 0; i < n; i++) {
+                clock_gettime(CLOCK_MONOTONIC, &a);
+                insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+                clock_gettime(CLOCK_MONOTONIC, &b);
+                ns[i] = (unsigned int)((b.tv_sec - a.tv_sec) * 1000000000L + (b.tv_nsec - a.tv_nsec));
+            }
+            double ms = wallMs() - start;
+            snprintf(label, sizeof(label), "HashMap,Insert_%s", modeNames[m]);
+            writeLatencyRow(fp, label, n, ns, ms);
+
+            int found = 0;
+            start = wallMs();
+            for (int i = 0; i < n; i++) {
+                clock_gettime(CLOCK_MONOTONIC, &a);
+                found += searchContact(data[i].name) != NULL;
+                clock_gettime(CLOCK_MONOTONIC, &b);
+                ns[i] = (unsigned int)((b.tv_sec - a.tv_sec) * 1000000000L + (b.tv_nsec - a.tv_nsec));
+            }
+            ms = wallMs() - start;
+            snprintf(label, sizeof(label), "HashMap,Search_%s", modeNames[m]);
+            writeLatencyRow(fp, label, n, ns, ms);
+            if (found != n) printf("  only %d/%d contacts found!\n", found, n);
+        }
+        free(data);
+        free(ns);
+    }
+
+    freeContacts();
+    resizeMode = RESIZE_NONE;
+    initTable(TABLE_SIZE);
+    trigramIndexOn = 1;
+    fclose(fp);
+    printf("Resize latency benchmark written to %s\n", filename);
+}
+
 // ---------------- Main Menu ----------------
-int main() {
+int main(int argc, char** argv) {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    initTable(TABLE_SIZE);
+
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchmarkHashMapToCSV(argc > 2 ? argv[2] : "performance_hashmap.csv");
+        return 0;
+    }
 
     while (1) {
         printf("\nContact Management System (Hash Map)\n");
@@ -237,6 +1340,11 @@ int main() {
         printf("5. Display All Contacts\n");
         printf("6. Benchmark Performance\n");
         printf("7. Exit\n");
+        printf("8. Fuzzy Search Benchmark\n");
+        printf("9. Batched Lookup Benchmark\n");
+        printf("10. Parallel Bulk Build Benchmark\n");
+        printf("11. Sorted Export Benchmark\n");
+        printf("12. Resize Latency Benchmark\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -281,6 +1389,26 @@ int main() {
                 freeContacts();
                 printf("Exiting...\n");
                 exit(0);
+            case 8:
+                printf("Running fuzzy search benchmark...\n");
+                benchmarkFuzzyToCSV("performance_fuzzy.csv");
+                break;
+            case 9:
+                printf("Running batched lookup benchmark...\n");
+                benchmarkSearchManyToCSV("performance_searchmany.csv");
+                break;
+            case 10:
+                printf("Running bulk build benchmark...\n");
+                benchmarkBulkBuildToCSV("performance_bulkbuild.csv");
+                break;
+            case 11:
+                printf("Running sorted export benchmark...\n");
+                benchmarkSortedExportToCSV("performance_sortedexport.csv");
+                break;
+            case 12:
+                printf("Running resize latency benchmark...\n");
+                benchmarkResizeToCSV("performance_resize.csv");
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
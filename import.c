@@ -0,0 +1,374 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "backends.h"
+
+// Bulk importer for CSV (name,phone,email) and vCard address books.
+// The file is mmapped and cut into one chunk per thread, each boundary moved
+// forward to the next record start. Threads parse their chunk in parallel
+// into field spans that point back into the mapping (no copies), using a
+// 16-byte SSE2 delimiter scan where available. The spans are then fed, in
+// file order, to insertIfAbsent of the chosen backend. Parse and insert are
+// timed and reported separately.
+//
+// Limits: CSV fields may be quoted with "" escapes but must not contain
+// newlines (the chunker splits on them); vCard folded lines are not joined.
+
+#define MAX_THREADS 64
+#define FMT_CSV 0
+#define FMT_VCARD 1
+
+typedef struct {
+    const char* field[3];   // name, phone, email
+    int len[3];
+    char escaped[3];        // the field needs unescaping ("" in CSV, \x in vCard)
+} Record;
+
+typedef struct {
+    const char* begin;
+    const char* end;
+    int format;
+    Record* records;
+    long count, capacity;
+} Chunk;
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// ---------------- Delimiter Scan ----------------
+// Next ',' or '\n' at or after p (end if none)
+static const char* scanCsv(const char* p, const char* end) {
+#ifdef __SSE2__
+    const __m128i comma = _mm_set1_epi8(','), nl = _mm_set1_epi8('\n');
+    while (p + 16 <= end) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, nl)));
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != ',' && *p != '\n') p++;
+    return p;
+}
+
+// Next c at or after p (end if none)
+static const char* scanByte(const char* p, const char* end, char c) {
+    const char* q = memchr(p, c, end - p);   // glibc's memchr is already vectorized
+    return q ? q : end;
+}
+
+// ---------------- Parsing ----------------
+static Record* newRecord(Chunk* c) {
+    if (c->count == c->capacity) {
+        c->capacity = c->capacity ? c->capacity * 2 : 65536;
+        c->records = (Record*)realloc(c->records, c->capacity * sizeof(Record));
+    }
+    Record* r = &c->records[c->count++];
+    memset(r, 0, sizeof(*r));
+    return r;
+}
+
+static void parseCsv(Chunk* c) {
+    const char* p = c->begin;
+    const char* end = c->end;
+    while (p < end) {
+        Record* r = newRecord(c);
+        for (int f = 0; p < end && *p != '\n'; f++) {
+            const char* start;
+            int len, escaped = 0;
+            if (*p == '"') {
+                // quoted: "" is an escaped quote, the field ends at a lone quote
+                start = ++p;
+                for (;;) {
+                    p = scanByte(p, end, '"');
+                    if (p + 1 < end && p[1] == '"') { escaped = 1; p += 2; continue; }
+                    break;
+                }
+                len = (int)(p - start);
+                if (p < end) p++;
+                p = scanCsv(p, end);
+            } else {
+                start = p;
+                p = scanCsv(p, end);
+                len = (int)(p - start);
+            }
+            if (len > 0 && start[len - 1] == '\r') len--;
+            if (f < 3) { r->field[f] = start; r->len[f] = len; r->escaped[f] = escaped; }
+            if (p < end && *p == ',') p++;
+        }
+        if (p < end) p++;   // the newline
+        if (r->len[0] == 0) c->count--;   // blank line
+    }
+}
+
+// vCard property name match at the start of a line, allowing ;TYPE=... parameters
+static const char* vcardValue(const char* line, const char* eol, const char* prop) {
+    int n = (int)strlen(prop);
+    if (eol - line <= n || strncasecmp(line, prop, n) != 0 || (line[n] != ':' && line[n] != ';')) return NULL;
+    const char* colon = memchr(line + n, ':', eol - line - n);
+    return colon ? colon + 1 : NULL;
+}
+
+static void parseVcard(Chunk* c) {
+    const char* p = c->begin;
+    const char* end = c->end;
+    Record* r = NULL;
+    while (p < end) {
+        const char* eol = scanByte(p, end, '\n');
+        const char* stop = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+        const char* v;
+        if (stop - p >= 11 && strncasecmp(p, "BEGIN:VCARD", 11) == 0) {
+            r = newRecord(c);
+        } else if (r && stop - p >= 9 && strncasecmp(p, "END:VCARD", 9) == 0) {
+            if (r->len[0] == 0) c->count--;
+            r = NULL;
+        } else if (r) {
+            int f = -1;
+            if ((v = vcardValue(p, stop, "FN"))) f = 0;
+            else if ((v = vcardValue(p, stop, "TEL"))) f = 1;
+            else if ((v = vcardValue(p, stop, "EMAIL"))) f = 2;
+            if (f >= 0 && r->field[f] == NULL) {
+                r->field[f] = v;
+                r->len[f] = (int)(stop - v);
+                r->escaped[f] = memchr(v, '\\', stop - v) != NULL;
+            }
+        }
+        p = eol + 1;
+    }
+    if (r && r->len[0] == 0) c->count--;   // truncated last card
+}
+
+static void* parseChunk(void* arg) {
+    Chunk* c = (Chunk*)arg;
+    if (c->format == FMT_VCARD) parseVcard(c);
+    else parseCsv(c);
+    return NULL;
+}
+
+// Move p forward to the start of the next record
+static const char* recordStart(const char* p, const char* begin, const char* end, int format) {
+    if (p <= begin) return begin;
+    if (format == FMT_CSV) {
+        if (p[-1] == '\n') return p;
+        p = scanByte(p, end, '\n');
+        return p < end ? p + 1 : end;
+    }
+    while (p < end) {
+        if ((p == begin || p[-1] == '\n') && end - p >= 11 && strncasecmp(p, "BEGIN:VCARD", 11) == 0) return p;
+        p = scanByte(p, end, '\n');
+        if (p < end) p++;
+    }
+    return end;
+}
+
+// A CSV header row has exactly "name" (quoted or not) as its first field, so
+// a first contact called "Name..." or "names" is still read as a record
+static int isCsvHeader(const char* p, const char* end) {
+    int quoted = p < end && *p == '"';
+    p += quoted;
+    if (end - p < 4 || strncasecmp(p, "name", 4) != 0) return 0;
+    p += 4;
+    if (quoted) {
+        if (p == end || *p != '"') return 0;
+        p++;
+    }
+    return p == end || *p == ',' || *p == '\r' || *p == '\n';
+}
+
+// ---------------- Insert ----------------
+// Copy a field into a NUL-terminated buffer, undoing CSV/vCard escapes;
+// 0 if it does not fit, as hashmap.c's loader rejects over-long fields
+static int copyField(char* out, int size, const char* s, int len, int escaped, int format) {
+    int n = 0;
+    for (int i = 0; i < len; i++) {
+        if (n == size - 1) return 0;
+        char ch = s[i];
+        if (escaped && format == FMT_CSV && ch == '"' && i + 1 < len && s[i + 1] == '"') i++;
+        else if (escaped && format == FMT_VCARD && ch == '\\' && i + 1 < len) {
+            ch = s[++i];
+            if (ch == 'n' || ch == 'N') ch = ' ';
+        }
+        out[n++] = ch;
+    }
+    out[n] = '\0';
+    return 1;
+}
+
+// Batched insert: every chunk's records, in file order. A record with a
+// field too long for its buffer is skipped and counted in *tooLong.
+static long insertAll(const Backend* b, Chunk* chunks, int nchunks, int format, long* tooLong) {
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    long created = 0;
+    *tooLong = 0;
+    for (int t = 0; t < nchunks; t++) {
+        for (long i = 0; i < chunks[t].count; i++) {
+            Record* r = &chunks[t].records[i];
+            if (!copyField(name, NAME_LEN, r->field[0], r->len[0], r->escaped[0], format) ||
+                !copyField(phone, PHONE_LEN, r->field[1], r->len[1], r->escaped[1], format) ||
+                !copyField(email, EMAIL_LEN, r->field[2], r->len[2], r->escaped[2], format)) {
+                (*tooLong)++;
+                continue;
+            }
+            created += b->insert(name, phone, email) == 1;
+        }
+    }
+    return created;
+}
+
+// ---------------- Test Data ----------------
+static void randomString(char* str, int length) {
+    static const char charset[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for (int i = 0; i < length - 1; i++)
+        str[i] = charset[rand() % (sizeof(charset) - 1)];
+    str[length - 1] = '\0';
+}
+
+// Write count random contacts as CSV, or as vCard for a .vcf/.vcard name
+static int generateFile(const char* filename, long count) {
+    const char* dot = strrchr(filename, '.');
+    int vcard = dot && (strcasecmp(dot, ".vcf") == 0 || strcasecmp(dot, ".vcard") == 0);
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return 1;
+    }
+    static char buf[1 << 20];
+    setvbuf(fp, buf, _IOFBF, sizeof(buf));
+    char name[16], phone[11], email[16];
+    srand(time(NULL));
+    if (!vcard) fprintf(fp, "name,phone,email\n");
+    for (long i = 0; i < count; i++) {
+        randomString(name, 13);
+        randomString(phone, 11);
+        randomString(email, 16);
+        if (vcard)
+            fprintf(fp, "BEGIN:VCARD\r\nVERSION:3.0\r\nFN:%s\r\nTEL;TYPE=CELL:%s\r\nEMAIL:%s@example.com\r\nEND:VCARD\r\n",
+                    name, phone, email);
+        else
+            fprintf(fp, "%s,%s,%s@example.com\n", name, phone, email);
+    }
+    fclose(fp);
+    printf("Wrote %ld contacts to %s\n", count, filename);
+    return 0;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s FILE [-b backend] [-t threads] [-o results.csv]\n", prog);
+    printf("       %s -g COUNT FILE      write COUNT random contacts (vCard for .vcf)\n", prog);
+    printf("  -b NAME   Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo or Adaptive (default HashMap)\n");
+    printf("  -t N      parser threads (default: online CPUs)\n");
+    printf("  -o FILE   append a result row (default performance_import.csv)\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "HashMap";
+    const char* resultFile = "performance_import.csv";
+    long generate = 0;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:t:o:g:h")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 't': threads = atoi(optarg); break;
+            case 'o': resultFile = optarg; break;
+            case 'g': generate = atol(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind >= argc) { usage(argv[0]); return 1; }
+    const char* filename = argv[optind];
+    if (generate > 0) return generateFile(filename, generate);
+
+    const Backend* b = findBackend(backendName);
+    if (!b) {
+        printf("Unknown backend %s\n", backendName);
+        return 1;
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+
+    int fd = open(filename, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        printf("Cannot read %s\n", filename);
+        return 1;
+    }
+    size_t size = st.st_size;
+    const char* data = (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+    madvise((void*)data, size, MADV_SEQUENTIAL);
+    const char* end = data + size;
+
+    // Format from the first non-blank bytes; skip a CSV header row
+    const char* begin = data;
+    int format = (size >= 11 && strncasecmp(data, "BEGIN:VCARD", 11) == 0) ? FMT_VCARD : FMT_CSV;
+    if (format == FMT_CSV && isCsvHeader(data, end))
+        begin = recordStart(data + 1, data, end, FMT_CSV);
+
+    // ---------- Parse ----------
+    double t0 = nowMs();
+    Chunk chunks[MAX_THREADS];
+    pthread_t tids[MAX_THREADS];
+    const char* cut = begin;
+    for (int t = 0; t < threads; t++) {
+        const char* next = t == threads - 1 ? end
+                         : recordStart(begin + (end - begin) * (t + 1) / threads, begin, end, format);
+        if (next < cut) next = cut;
+        chunks[t] = (Chunk){cut, next, format, NULL, 0, 0};
+        cut = next;
+        pthread_create(&tids[t], NULL, parseChunk, &chunks[t]);
+    }
+    long total = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+        total += chunks[t].count;
+    }
+    double parseMs = nowMs() - t0;
+
+    // ---------- Insert ----------
+    t0 = nowMs();
+    b->init((int)(total > 0 ? total : 1));
+    long tooLong;
+    long created = insertAll(b, chunks, threads, format, &tooLong);
+    double insertMs = nowMs() - t0;
+
+    double mb = size / 1048576.0;
+    printf("%s: %ld records (%.1f MB) parsed by %d threads in %.1f ms: %.0f MB/s, %.0f records/s\n",
+           format == FMT_VCARD ? "vCard" : "CSV", total, mb, threads, parseMs,
+           mb / (parseMs / 1000.0), total / (parseMs / 1000.0));
+    printf("%s: %ld contacts inserted (%ld duplicates, %ld skipped with over-long fields) in %.1f ms: %.0f contacts/s\n",
+           b->name, created, total - created - tooLong, tooLong, insertMs, total / (insertMs / 1000.0));
+
+    int newFile = access(resultFile, F_OK) != 0;
+    FILE* fp = fopen(resultFile, "a");
+    if (fp) {
+        if (newFile)
+            fprintf(fp, "DataStructure,Format,Contacts,Threads,File_MB,Parse_ms,Parse_MB_s,Parse_records_s,Insert_ms,Insert_contacts_s\n");
+        fprintf(fp, "%s,%s,%ld,%d,%.1f,%.3f,%.1f,%.0f,%.3f,%.0f\n", b->name,
+                format == FMT_VCARD ? "vCard" : "CSV", total, threads, mb, parseMs,
+                mb / (parseMs / 1000.0), total / (parseMs / 1000.0), insertMs, total / (insertMs / 1000.0));
+        fclose(fp);
+    }
+
+    b->destroy();
+    for (int t = 0; t < threads; t++) free(chunks[t].records);
+    munmap((void*)data, size);
+    close(fd);
+    return 0;
+}
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "trace.h"
+#include "filter.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
@@ -14,6 +16,8 @@ typedef struct Contact {
     struct Contact* next;
 } Contact;
 
+#include "cache.h"
+
 Contact* head = NULL;  // head pointer of linked list
 
 // Function to create a new contact node
@@ -26,6 +30,38 @@ Contact* createContact(char* name, char* phone, char* email) {
     return newContact;
 }
 
+// ---------------- Membership Filter ----------------
+// The filter itself is in filter.h; these hooks rebuild it from the list.
+
+// Hash of every name in the list, in a new array; *n gets the count
+unsigned long long* collectNameHashes(long* n) {
+    long count = 0;
+    for (Contact* c = head; c != NULL; c = c->next) count++;
+    unsigned long long* keys = (unsigned long long*)malloc((count + 1) * sizeof(unsigned long long));
+    count = 0;
+    for (Contact* c = head; c != NULL; c = c->next) keys[count++] = filterHash(c->name);
+    *n = count;
+    return keys;
+}
+
+void filterRebuild() {
+    long n;
+    unsigned long long* keys = collectNameHashes(&n);
+    filterBuild(keys, n);
+}
+
+// Called once an insert or delete has finished
+void filterMaintain() {
+    if (filterStale()) filterRebuild();
+}
+
+// Switch mode; the new filter is built from the list
+void filterSetMode(int mode) {
+    filterFree();
+    filterMode = mode;
+    if (mode != FILTER_OFF) filterRebuild();
+}
+
 // Insert a new contact at the end
 void insertContact(char* name, char* phone, char* email) {
     Contact* newContact = createContact(name, phone, email);
@@ -38,18 +74,29 @@ void insertContact(char* name, char* phone, char* email) {
         }
         temp->next = newContact;
     }
+    filterAdd(name);
+    filterMaintain();
     printf("Contact added: %s\n", name);
 }
 
-// Search for a contact by name
+// Search for a contact by name: names the filter rules out are not looked
+// for, the rest go through the front cache when it is on
 Contact* searchContact(char* name) {
+    unsigned int h = 0;
+    if (!filterMayContain(name)) return NULL;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
     Contact* temp = head;
     while (temp != NULL) {
         if (strcmp(temp->name, name) == 0) {
+            if (cacheOn) cacheAdmit(temp, h);
             return temp;
         }
         temp = temp->next;
     }
+    filterFalsePositive();
     return NULL;
 }
 
@@ -65,17 +112,53 @@ void updateContact(char* name, char* newPhone, char* newEmail) {
     printf("Contact updated: %s\n", name);
 }
 
+// Find a contact or append it at the end, in one pass over the list
+Contact* insertIfAbsent(char* name, char* phone, char* email) {
+    Contact* temp = head;
+    Contact* last = NULL;
+    while (temp != NULL) {
+        if (strcmp(temp->name, name) == 0) {
+            return temp;
+        }
+        last = temp;
+        temp = temp->next;
+    }
+    Contact* newContact = createContact(name, phone, email);
+    if (last == NULL) {
+        head = newContact;
+    } else {
+        last->next = newContact;
+    }
+    filterAdd(name);
+    filterMaintain();
+    return newContact;
+}
+
+// Insert a contact or overwrite an existing one, in one pass over the list
+Contact* upsertContact(char* name, char* phone, char* email) {
+    Contact* contact = insertIfAbsent(name, phone, email);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    printf("Contact saved: %s\n", name);
+    return contact;
+}
+
 // Delete a contact by name
 void deleteContact(char* name) {
     Contact* temp = head;
     Contact* prev = NULL;
 
+    if (!filterMayContain(name)) {
+        printf("Contact not found.\n");
+        return;
+    }
     while (temp != NULL && strcmp(temp->name, name) != 0) {
         prev = temp;
         temp = temp->next;
     }
 
     if (temp == NULL) {
+        filterFalsePositive();
         printf("Contact not found.\n");
         return;
     }
@@ -86,7 +169,10 @@ void deleteContact(char* name) {
         prev->next = temp->next;
     }
 
+    cacheInvalidate(name);
     free(temp);
+    filterDelete();
+    filterMaintain();
     printf("Contact deleted: %s\n", name);
 }
 
@@ -113,12 +199,18 @@ void freeContacts() {
         free(temp);
         temp = next;
     }
+    head = NULL;
+    cacheClear();
+    filterFree();
 }
 
 // Menu-driven program
 int main() {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
+    cacheClear();
+    filterSetMode(FILTER_BLOOM);
 
     while (1) {
         printf("\nContact Management System (Linked List)\n");
@@ -128,6 +220,11 @@ int main() {
         printf("4. Delete Contact\n");
         printf("5. Display All Contacts\n");
         printf("6. Exit\n");
+        printf("7. Insert or Update Contact\n");
+        printf("8. Front Cache Statistics\n");
+        printf("9. Toggle Front Cache\n");
+        printf("10. Membership Filter Statistics\n");
+        printf("11. Set Membership Filter (0 off, 1 Bloom, 2 xor)\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -140,12 +237,14 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
                 insertContact(name, phone, email);
                 break;
             case 2:
                 printf("Enter Name to Search: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
                 Contact* c;
+                traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
                 c = searchContact(name);
                 if (c != NULL)
                     printf("Found: %s | Phone: %s | Email: %s\n",
@@ -160,11 +259,13 @@ int main() {
                 fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
                 printf("Enter New Email: ");
                 fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
                 updateContact(name, phone, email);
                 break;
             case 4:
                 printf("Enter Name to Delete: ");
                 fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
                 deleteContact(name);
                 break;
             case 5:
@@ -173,7 +274,42 @@ int main() {
             case 6:
                 freeContacts();
                 printf("Exiting...\n");
+                traceClose();
                 exit(0);
+            case 7:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
+            case 8:
+                displayCacheStats();
+                break;
+            case 9:
+                cacheOn = !cacheOn;
+                cacheClear();
+                printf("Front cache %s.\n", cacheOn ? "enabled" : "disabled");
+                break;
+            case 10:
+                displayFilterStats();
+                break;
+            case 11:
+                printf("Filter mode: ");
+                {
+                    int mode;
+                    if (scanf("%d", &mode) == 1 && mode >= FILTER_OFF && mode <= FILTER_XOR) {
+                        filterSetMode(mode);
+                        printf("Membership filter %s.\n", filterModeNames[mode]);
+                    } else {
+                        printf("Invalid mode!\n");
+                    }
+                    getchar();
+                }
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "perfcount.h"
+#define FILTER_DEFAULT_MODE FILTER_OFF
+#include "filter.h"
 
 #define NAME_LEN 50
 #define PHONE_LEN 20
@@ -14,11 +17,46 @@ typedef struct Contact {
     struct Contact* next;
 } Contact;
 
+#define CACHE_DEFAULT_ON 0   // off for the standard benchmark, toggled by the cache benchmark
+#include "cache.h"
+
 Contact* head = NULL;
 
+// ---------------- Membership Filter ----------------
+// The filter itself is in filter.h; these hooks rebuild it from the list.
+
+// Hash of every name in the list, in a new array; *n gets the count
+unsigned long long* collectNameHashes(long* n) {
+    long count = 0;
+    for (Contact* c = head; c != NULL; c = c->next) count++;
+    unsigned long long* keys = (unsigned long long*)malloc((count + 1) * sizeof(unsigned long long));
+    count = 0;
+    for (Contact* c = head; c != NULL; c = c->next) keys[count++] = filterHash(c->name);
+    *n = count;
+    return keys;
+}
+
+void filterRebuild() {
+    long n;
+    unsigned long long* keys = collectNameHashes(&n);
+    filterBuild(keys, n);
+}
+
+// Called once an insert or delete has finished
+void filterMaintain() {
+    if (filterStale()) filterRebuild();
+}
+
+// Switch mode; the new filter is built from the list
+void filterSetMode(int mode) {
+    filterFree();
+    filterMode = mode;
+    if (mode != FILTER_OFF) filterRebuild();
+}
+
 // ---------------- Core Functions ----------------
 Contact* createContact(char* name, char* phone, char* email) {
-    Contact* newContact = (Contact*)malloc(sizeof(Contact));
+    Contact* newContact = (Contact*)countedMalloc(sizeof(Contact));
     strcpy(newContact->name, name);
     strcpy(newContact->phone, phone);
     strcpy(newContact->email, email);
@@ -34,14 +72,26 @@ void insertContact(char* name, char* phone, char* email) {
         while (temp->next != NULL) temp = temp->next;
         temp->next = newContact;
     }
+    filterAdd(name);
+    filterMaintain();
 }
 
 Contact* searchContact(char* name) {
+    unsigned int h = 0;
+    if (!filterMayContain(name)) return NULL;
+    if (cacheOn) {
+        Contact* cached = cacheLookup(name, &h);
+        if (cached != NULL) return cached;
+    }
     Contact* temp = head;
     while (temp != NULL) {
-        if (strcmp(temp->name, name) == 0) return temp;
+        if (strcmp(temp->name, name) == 0) {
+            if (cacheOn) cacheAdmit(temp, h);
+            return temp;
+        }
         temp = temp->next;
     }
+    filterFalsePositive();
     return NULL;
 }
 
@@ -52,21 +102,51 @@ void updateContact(char* name, char* newPhone, char* newEmail) {
     if (newEmail != NULL) strcpy(contact->email, newEmail);
 }
 
+Contact* insertIfAbsent(char* name, char* phone, char* email) {
+    Contact* temp = head;
+    Contact* last = NULL;
+    while (temp != NULL) {
+        if (strcmp(temp->name, name) == 0) return temp;
+        last = temp;
+        temp = temp->next;
+    }
+    Contact* newContact = createContact(name, phone, email);
+    if (last == NULL) head = newContact;
+    else last->next = newContact;
+    filterAdd(name);
+    filterMaintain();
+    return newContact;
+}
+
+Contact* upsertContact(char* name, char* phone, char* email) {
+    Contact* contact = insertIfAbsent(name, phone, email);
+    strcpy(contact->phone, phone);
+    strcpy(contact->email, email);
+    return contact;
+}
+
 void deleteContact(char* name) {
     Contact* temp = head;
     Contact* prev = NULL;
 
+    if (!filterMayContain(name)) return;
     while (temp != NULL && strcmp(temp->name, name) != 0) {
         prev = temp;
         temp = temp->next;
     }
 
-    if (temp == NULL) return;
+    if (temp == NULL) {
+        filterFalsePositive();
+        return;
+    }
 
     if (prev == NULL) head = temp->next;
     else prev->next = temp->next;
 
-    free(temp);
+    cacheInvalidate(name);
+    countedFree(temp, sizeof(Contact));
+    filterDelete();
+    filterMaintain();
 }
 
 void displayContacts() {
@@ -85,7 +165,7 @@ void freeContacts() {
     Contact* temp = head;
     while (temp != NULL) {
         Contact* next = temp->next;
-        free(temp);
+        countedFree(temp, sizeof(Contact));
         temp = next;
     }
     head = NULL;
@@ -113,7 +193,7 @@ Contact generateContact() {
 //     int num_tests = sizeof(test_sizes) / sizeof(test_sizes[0]);
 //     srand(time(NULL));
 
-//     printf("DataStructure,Operation,Contacts,Time_ms\n");
+//     printf("DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes\n");
 
 //     for (int t = 0; t < num_tests; t++) {
 //         int n = test_sizes[t];
@@ -173,50 +253,74 @@ void benchmarkLinkedListToCSV(const char* filename) {
         return;
     }
 
-    fprintf(fp, "DataStructure,Operation,Contacts,Time_ms\n");
+    fputs(RESULT_CSV_HEADER, fp);
 
     for (int t = 0; t < num_tests; t++) {
         int n = test_sizes[t];
+        resetPeakRSS();
         freeContacts();  // start fresh
 
-        Contact temp;
+        Contact data[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        // ---------- Search + Insert (duplicate check, two passes) ----------
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++) {
+            if (searchContact(data[i].name) == NULL)
+                insertContact(data[i].name, data[i].phone, data[i].email);
+        }
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+        writeResult(fp, "LinkedList,InsertSearch", n, twoPass);
+        freeContacts();
 
-        // ---------- Insert ----------
-        clock_t start = clock();
+        // ---------- Insert (insertIfAbsent, one pass) ----------
+        start = startPhase();
         for (int i = 0; i < n; i++) {
-            temp = generateContact();
-            insertContact(temp.name, temp.phone, temp.email);
+            insertIfAbsent(data[i].name, data[i].phone, data[i].email);
         }
-        clock_t end = clock();
-        fprintf(fp, "LinkedList,Insert,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        double onePass = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+        writeResult(fp, "LinkedList,Insert", n, onePass);
+        printf("LinkedList %d: insertIfAbsent saved %.3f ms over search + insert\n", n, twoPass - onePass);
 
         // ---------- Search ----------
         Contact* curr = head;
-        start = clock();
+        start = startPhase();
         while (curr != NULL) {
             searchContact(curr->name);
             curr = curr->next;
         }
-        end = clock();
-        fprintf(fp, "LinkedList,Search,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "LinkedList,Search", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
 
         // ---------- Update ----------
         curr = head;
-        start = clock();
+        start = startPhase();
         while (curr != NULL) {
             updateContact(curr->name, "1234567890", "newemail@test.com");
             curr = curr->next;
         }
-        end = clock();
-        fprintf(fp, "LinkedList,Update,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "LinkedList,Update", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+
+        // ---------- Upsert ----------
+        curr = head;
+        start = startPhase();
+        while (curr != NULL) {
+            upsertContact(curr->name, "0987654321", "upsert@test.com");
+            curr = curr->next;
+        }
+        end = stopPhase();
+        writeResult(fp, "LinkedList,Upsert", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
 
         // ---------- Delete ----------
-        start = clock();
+        start = startPhase();
         while (head != NULL) {
             deleteContact(head->name);  // always delete head
         }
-        end = clock();
-        fprintf(fp, "LinkedList,Delete,%d,%.3f\n", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
+        end = stopPhase();
+        writeResult(fp, "LinkedList,Delete", n, ((double)(end - start)) / CLOCKS_PER_SEC * 1000);
     }
 
     fclose(fp);
@@ -225,9 +329,218 @@ void benchmarkLinkedListToCSV(const char* filename) {
 
 
 // ---------------- Main Menu ----------------
-int main() {
+// ---------------- Front Cache Benchmark ----------------
+// Lookups follow a Zipf distribution (s = 1) over the contacts. Ranks are
+// shuffled so the hot names are spread through the structure rather than
+// sitting in insertion order. Each lookup sequence runs with the cache off
+// and then on; the uniform pair shows what the cache costs without skew.
+#define CACHE_LOOKUPS 100000
+volatile long cacheSink;
+
+// Fill out[] with count indexes in [0, n): Zipf ranks through a random permutation
+void zipfIndexes(int n, int count, int* out) {
+    double* cdf = (double*)malloc(n * sizeof(double));
+    int* perm = (int*)malloc(n * sizeof(int));
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int k = 0; k < count; k++) {
+        double u = (double)rand() / ((double)RAND_MAX + 1) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        out[k] = perm[lo];
+    }
+    free(cdf);
+    free(perm);
+}
+
+void benchmarkFrontCacheToCSV(const char* filename) {
+    int sizes[] = {1000, 5000, 20000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Lookups,Time_ms,Hit_rate," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        freeContacts();
+        cacheOn = 0;
+
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            insertContact(data[i].name, data[i].phone, data[i].email);
+        }
+        int* zipf = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        int* uniform = (int*)malloc(CACHE_LOOKUPS * sizeof(int));
+        zipfIndexes(n, CACHE_LOOKUPS, zipf);
+        for (int k = 0; k < CACHE_LOOKUPS; k++) uniform[k] = rand() % n;
+
+        const char* labels[] = {"LinkedList" ",ZipfSearch", "LinkedList" ",CachedZipfSearch",
+                                "LinkedList" ",UniformSearch", "LinkedList" ",CachedUniformSearch"};
+        int* order[] = {zipf, zipf, uniform, uniform};
+        for (int r = 0; r < 4; r++) {
+            cacheOn = r % 2;
+            cacheClear();
+            cacheHits = cacheMisses = 0;
+            clock_t start = startPhase();
+            for (int k = 0; k < CACHE_LOOKUPS; k++)
+                cacheSink += searchContact(data[order[r][k]].name) != NULL;
+            clock_t end = stopPhase();
+            double ms = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+            double hitRate = (double)cacheHits / CACHE_LOOKUPS;
+            fprintf(fp, "%s,%d,%d,%.3f,%.4f", labels[r], n, CACHE_LOOKUPS, ms, hitRate);
+            writeCounters(fp, CACHE_LOOKUPS);
+            fputc('\n', fp);
+            printf("%s %d: %.3f ms, hit rate %.1f%%\n", labels[r], n, ms, 100 * hitRate);
+        }
+
+        cacheOn = 0;
+        cacheClear();
+        free(data);
+        free(zipf);
+        free(uniform);
+    }
+
+    fclose(fp);
+    printf("Front cache benchmark written to %s\n", filename);
+}
+
+// ---------------- Membership Filter Benchmark ----------------
+// Each filter mode (off, Bloom, xor) builds the list from the same contacts,
+// then looks up present names and names that were never inserted. A churn
+// phase deletes half the contacts and inserts as many new ones, which forces
+// rebuilds, before the absent names are looked up again. FP_rate_pct is the
+// share of absent names the filter let through to the list.
+#define FILTER_LOOKUPS 20000
+volatile long filterSink;
+long phaseRejects, phaseFalsePositives, phaseRebuilds;
+
+clock_t startFilterPhase() {
+    phaseRejects = filterRejects;
+    phaseFalsePositives = filterFalsePositives;
+    phaseRebuilds = filterRebuilds;
+    return startPhase();
+}
+
+// One CSV row, from the filter counters' change over the phase
+void stopFilterPhase(FILE* fp, const char* op, int n, int ops, clock_t start) {
+    clock_t end = stopPhase();
+    double ms = ((double)(end - start)) / CLOCKS_PER_SEC * 1000;
+    long r = filterRejects - phaseRejects, f = filterFalsePositives - phaseFalsePositives;
+    char rate[16] = "", bits[16] = "";
+    if (filterMode != FILTER_OFF && r + f > 0) snprintf(rate, sizeof(rate), "%.3f", 100.0 * f / (r + f));
+    if (filterMode != FILTER_OFF && filterNames > filterDeletes)
+        snprintf(bits, sizeof(bits), "%.2f", filterBitsPerName());
+    fprintf(fp, "LinkedList,%s,%d,%s,%d,%.3f,%.1f,%s,%s,%ld", op, n, filterModeNames[filterMode], ops, ms,
+            ms * 1e6 / ops, rate, bits, filterRebuilds - phaseRebuilds);
+    writeCounters(fp, ops);
+    fputc('\n', fp);
+    printf("LinkedList %-15s %7d %-5s %10.3f ms %10.1f ns/op  fp %s%%\n", op, n, filterModeNames[filterMode], ms,
+           ms * 1e6 / ops, rate);
+}
+
+void benchmarkFilterToCSV(const char* filename) {
+    int sizes[] = {1000, 5000, 20000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Filter,Ops,Time_ms,Ns_per_op,FP_rate_pct,Filter_bits_per_contact,Rebuilds," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        Contact* data = (Contact*)malloc(n * sizeof(Contact));
+        Contact* fresh = (Contact*)malloc((n / 2) * sizeof(Contact));
+        Contact* absent = (Contact*)malloc(FILTER_LOOKUPS * sizeof(Contact));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+        for (int i = 0; i < n / 2; i++) fresh[i] = generateContact();
+        for (int k = 0; k < FILTER_LOOKUPS; k++) absent[k] = generateContact();
+
+        for (int mode = FILTER_OFF; mode <= FILTER_XOR; mode++) {
+            freeContacts();
+            filterSetMode(mode);
+            filterRejects = filterPasses = filterFalsePositives = filterRebuilds = 0;
+
+            // ---------- Insert (filter kept up to date, with its rebuilds) ----------
+            clock_t start = startFilterPhase();
+            for (int i = 0; i < n; i++) insertContact(data[i].name, data[i].phone, data[i].email);
+            stopFilterPhase(fp, "Insert", n, n, start);
+
+            // ---------- Lookups of present names (the filter's cost) ----------
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(data[k % n].name) != NULL;
+            stopFilterPhase(fp, "SearchHit", n, FILTER_LOOKUPS, start);
+
+            // ---------- Lookups of absent names (dedupe checks) ----------
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(absent[k].name) != NULL;
+            stopFilterPhase(fp, "SearchMiss", n, FILTER_LOOKUPS, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) updateContact(absent[k].name, "1234567890", "miss@test.com");
+            stopFilterPhase(fp, "UpdateMiss", n, FILTER_LOOKUPS, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) deleteContact(absent[k].name);
+            stopFilterPhase(fp, "DeleteMiss", n, FILTER_LOOKUPS, start);
+
+            // ---------- Churn: half the names replaced ----------
+            start = startFilterPhase();
+            for (int i = 0; i < n / 2; i++) {
+                deleteContact(data[2 * i].name);
+                insertContact(fresh[i].name, fresh[i].phone, fresh[i].email);
+            }
+            stopFilterPhase(fp, "Churn", n, n / 2 * 2, start);
+
+            start = startFilterPhase();
+            for (int k = 0; k < FILTER_LOOKUPS; k++) filterSink += searchContact(absent[k].name) != NULL;
+            stopFilterPhase(fp, "ChurnSearchMiss", n, FILTER_LOOKUPS, start);
+        }
+
+        freeContacts();
+        filterSetMode(FILTER_OFF);
+        free(data);
+        free(fresh);
+        free(absent);
+    }
+
+    fclose(fp);
+    printf("Membership filter benchmark written to %s\n", filename);
+}
+
+int main(int argc, char** argv) {
     int choice;
     char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    cacheClear();
+
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        benchmarkLinkedListToCSV(argc > 2 ? argv[2] : "performance_ll.csv");
+        return 0;
+    }
 
     while (1) {
         printf("\nContact Management System (Linked List)\n");
@@ -238,6 +551,8 @@ int main() {
         printf("5. Display All Contacts\n");
         printf("6. Benchmark Performance\n");
         printf("7. Exit\n");
+        printf("8. Front Cache Benchmark\n");
+        printf("9. Membership Filter Benchmark\n");
         printf("Enter your choice: ");
         scanf("%d", &choice);
         getchar(); // consume newline
@@ -280,6 +595,12 @@ int main() {
                 freeContacts();
                 printf("Exiting...\n");
                 exit(0);
+            case 8:
+                benchmarkFrontCacheToCSV("performance_cache_ll.csv");
+                break;
+            case 9:
+                benchmarkFilterToCSV("performance_filter_ll.csv");
+                break;
             default:
                 printf("Invalid choice! Try again.\n");
         }
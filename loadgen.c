@@ -0,0 +1,417 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "protocol.h"
+
+// Load generator for server.c. It first loads -n records over one pipelined
+// connection. Then, for every combination of connection count (-c) and
+// pipeline depth (-d), it opens that many connections and keeps depth
+// requests in flight on each, until -o requests have been answered.
+// One thread drives all connections through epoll, so a single core can hold
+// thousands of them open.
+//
+// A request's latency runs from the loop pass that wrote it to the pass that
+// read its response. Responses arrive in request order, so each connection
+// keeps its send times in a ring. Linux only (epoll).
+
+#define NAME_LEN 50
+#define IN_BUF 65536
+
+enum { MIX_READ, MIX_UPDATE, MIX_INSERT, MIX_DELETE, NUM_MIX };
+
+typedef struct {
+    int fd;
+    int inFlight;
+    int ringHead;           // oldest outstanding request
+    long long* sentNs;      // ring of depth send times
+    char* out;
+    size_t outLen, outSent;
+    size_t inLen;
+    char in[IN_BUF];
+} Client;
+
+static const char* unixPath = NULL;
+static int port = 0;
+static int mix[NUM_MIX] = {90, 5, 3, 2};
+static long long records = 100000, nextRecord;
+
+// ---------------- Random Numbers and Keys ----------------
+static unsigned long long rngState = 88172645463325252ULL;
+
+static unsigned long long nextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+static unsigned long long fnv64(unsigned long long v) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i = 0; i < 8; i++) {
+        h ^= v & 0xff;
+        h *= 1099511628211ULL;
+        v >>= 8;
+    }
+    return h;
+}
+
+// Key for record i, as in workload.c
+static void buildKey(long long i, char* out) {
+    snprintf(out, NAME_LEN, "user%llu", fnv64((unsigned long long)i));
+}
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compareUInt(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(unsigned int* sorted, long count, double p) {
+    long i = (long)ceil(p * count) - 1;
+    if (i < 0) i = 0;
+    return sorted[i] / 1000.0;
+}
+
+// ---------------- Connections ----------------
+static int connectServer(void) {
+    int fd;
+    if (unixPath) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, unixPath, sizeof(addr.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            perror(unixPath);
+            exit(1);
+        }
+    } else {
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            perror("connect");
+            exit(1);
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+static void writeAll(int fd, const char* buf, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, buf, len);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            perror("write");
+            exit(1);
+        }
+        buf += w;
+        len -= w;
+    }
+}
+
+// Blocking read of count responses into buf; the status of the last one is returned
+static int readResponses(int fd, char* buf, int count, char* lastPhone) {
+    size_t have = 0;
+    int status = STATUS_BAD;
+    while (count > 0) {
+        int len;
+        while ((len = protoResponseLength(buf, have)) > 0) {
+            const unsigned char* h = (const unsigned char*)buf;
+            status = h[0];
+            if (lastPhone) {
+                memcpy(lastPhone, buf + PROTO_RESPONSE_HEADER, h[1]);
+                lastPhone[h[1]] = '\0';
+            }
+            memmove(buf, buf + len, have - len);
+            have -= len;
+            if (--count == 0) return status;
+        }
+        ssize_t r = read(fd, buf + have, IN_BUF - have);
+        if (r <= 0) {
+            if (r < 0 && errno == EINTR) continue;
+            printf("Server closed the connection\n");
+            exit(1);
+        }
+        have += r;
+    }
+    return status;
+}
+
+// Load records 0..n-1 in pipelined batches; returns the backend's name
+static void loadRecords(char* backendName) {
+    int fd = connectServer();
+    char* out = (char*)malloc(1000 * PROTO_MAX_REQUEST);
+    char* in = (char*)malloc(IN_BUF);
+    char key[NAME_LEN];
+    size_t len = protoPutRequest(out, PROTO_HELLO, "", NULL, NULL);
+    writeAll(fd, out, len);
+    readResponses(fd, in, 1, backendName);
+
+    long long start = nowNs();
+    for (long long i = 0; i < records; i += 1000) {
+        int batch = records - i < 1000 ? (int)(records - i) : 1000;
+        len = 0;
+        for (int k = 0; k < batch; k++) {
+            buildKey(i + k, key);
+            len += protoPutRequest(out + len, TRACE_INSERT, key, "5550000000", "load@test.com");
+        }
+        writeAll(fd, out, len);
+        if (readResponses(fd, in, batch, NULL) == STATUS_FULL) {
+            printf("%s is full after %lld records\n", backendName, i + batch);
+            exit(1);
+        }
+    }
+    printf("Loaded %lld records into %s in %.1f ms\n", records, backendName, (nowNs() - start) / 1e6);
+    close(fd);
+    free(out);
+    free(in);
+}
+
+// ---------------- Run ----------------
+static long long issued, completed, total, misses;
+static unsigned int* latencies;
+
+// Queue requests on c until depth are in flight or the run has issued them all
+static void issue(Client* c, int depth, long long now) {
+    char key[NAME_LEN];
+    while (c->inFlight < depth && issued < total) {
+        int roll = (int)(nextRandom() % 100), op;
+        if (roll < mix[MIX_READ]) op = TRACE_SEARCH;
+        else if (roll < mix[MIX_READ] + mix[MIX_UPDATE]) op = TRACE_UPDATE;
+        else if (roll < mix[MIX_READ] + mix[MIX_UPDATE] + mix[MIX_INSERT]) op = TRACE_INSERT;
+        else op = TRACE_DELETE;
+        if (op == TRACE_INSERT) buildKey(nextRecord++, key);
+        else buildKey((long long)(nextRandom() % nextRecord), key);
+        c->outLen += protoPutRequest(c->out + c->outLen, op, key,
+                                     op == TRACE_UPDATE || op == TRACE_INSERT ? "5551234567" : NULL,
+                                     op == TRACE_UPDATE || op == TRACE_INSERT ? "run@test.com" : NULL);
+        c->sentNs[(c->ringHead + c->inFlight) % depth] = now;
+        c->inFlight++;
+        issued++;
+    }
+}
+
+// Write what the socket takes; EPOLLOUT is requested while some is unsent
+static void flushClient(int epfd, Client* c) {
+    int wasBlocked = c->outSent > 0;
+    while (c->outSent < c->outLen) {
+        ssize_t w = write(c->fd, c->out + c->outSent, c->outLen - c->outSent);
+        if (w < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            perror("write");
+            exit(1);
+        }
+        c->outSent += w;
+    }
+    int blocked = c->outSent < c->outLen;
+    if (!blocked) c->outSent = c->outLen = 0;
+    if (blocked != wasBlocked) {
+        struct epoll_event ev = {.events = EPOLLIN | (blocked ? EPOLLOUT : 0), .data.ptr = c};
+        epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+    }
+}
+
+// Read responses: each completes the oldest request in flight
+static void onReadable(int epfd, Client* c, int depth) {
+    ssize_t r = read(c->fd, c->in + c->inLen, IN_BUF - c->inLen);
+    if (r <= 0) {
+        if (r < 0 && (errno == EAGAIN || errno == EINTR)) return;
+        printf("Server closed the connection\n");
+        exit(1);
+    }
+    c->inLen += r;
+    long long now = nowNs();
+    size_t off = 0;
+    int len;
+    while ((len = protoResponseLength(c->in + off, c->inLen - off)) > 0) {
+        if (c->in[off] != STATUS_OK) misses++;
+        latencies[completed++] = (unsigned int)(now - c->sentNs[c->ringHead]);
+        c->ringHead = (c->ringHead + 1) % depth;
+        c->inFlight--;
+        off += len;
+    }
+    memmove(c->in, c->in + off, c->inLen - off);
+    c->inLen -= off;
+    if (c->outLen == 0) {   // a blocked write finishes before more is queued
+        issue(c, depth, now);
+        flushClient(epfd, c);
+    }
+}
+
+static void runLoad(FILE* fp, const char* backendName, const char* transport, int conns, int depth) {
+    Client* clients = (Client*)calloc(conns, sizeof(Client));
+    int epfd = epoll_create1(0);
+    issued = completed = misses = 0;
+
+    for (int i = 0; i < conns; i++) {
+        Client* c = &clients[i];
+        c->fd = connectServer();
+        fcntl(c->fd, F_SETFL, fcntl(c->fd, F_GETFL) | O_NONBLOCK);
+        c->sentNs = (long long*)malloc(depth * sizeof(long long));
+        c->out = (char*)malloc((size_t)depth * PROTO_MAX_REQUEST);
+        struct epoll_event ev = {.events = EPOLLIN, .data.ptr = c};
+        epoll_ctl(epfd, EPOLL_CTL_ADD, c->fd, &ev);
+    }
+
+    long long start = nowNs();
+    for (int i = 0; i < conns; i++) {
+        issue(&clients[i], depth, nowNs());
+        flushClient(epfd, &clients[i]);
+    }
+    struct epoll_event events[256];
+    while (completed < total) {
+        int n = epoll_wait(epfd, events, 256, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            exit(1);
+        }
+        for (int i = 0; i < n; i++) {
+            Client* c = (Client*)events[i].data.ptr;
+            if (events[i].events & EPOLLOUT) {
+                flushClient(epfd, c);
+                if (c->outLen == 0) {
+                    issue(c, depth, nowNs());
+                    flushClient(epfd, c);
+                }
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) onReadable(epfd, c, depth);
+        }
+    }
+    double ms = (nowNs() - start) / 1e6;
+
+    qsort(latencies, completed, sizeof(unsigned int), compareUInt);
+    double sum = 0;
+    for (long long i = 0; i < completed; i++) sum += latencies[i];
+    fprintf(fp, "%s,%s,%d,%d,%lld,%.3f,%.0f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld\n", backendName, transport, conns, depth,
+            completed, ms, completed / (ms / 1000.0), sum / completed / 1000.0, percentileUs(latencies, completed, 0.50),
+            percentileUs(latencies, completed, 0.99), percentileUs(latencies, completed, 0.999),
+            latencies[completed - 1] / 1000.0, misses);
+    printf("  %5d conns x %3d deep %10.0f req/s  p50 %8.1f us  p99 %8.1f us  p99.9 %8.1f us  max %8.1f us\n",
+           conns, depth, completed / (ms / 1000.0), percentileUs(latencies, completed, 0.50),
+           percentileUs(latencies, completed, 0.99), percentileUs(latencies, completed, 0.999),
+           latencies[completed - 1] / 1000.0);
+    fflush(fp);
+
+    for (int i = 0; i < conns; i++) {
+        close(clients[i].fd);
+        free(clients[i].sentNs);
+        free(clients[i].out);
+    }
+    free(clients);
+    close(epfd);
+}
+
+// Comma-separated positive integers into out; returns how many
+static int parseList(const char* s, int* out, int max) {
+    int n = 0;
+    while (*s && n < max) {
+        out[n] = atoi(s);
+        if (out[n] < 1) return 0;
+        n++;
+        s = strchr(s, ',');
+        if (!s) break;
+        s++;
+    }
+    return n;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [-u path | -p port] [options]\n", prog);
+    printf("  -u PATH     server's Unix domain socket (default contacts.sock)\n");
+    printf("  -p PORT     server's port on 127.0.0.1\n");
+    printf("  -c LIST     connection counts to run, e.g. 1,16,256 (default 1,8,64,256,1024)\n");
+    printf("  -d LIST     requests in flight per connection (default 1,16)\n");
+    printf("  -n N        records loaded before the runs (default 100000)\n");
+    printf("  -o N        requests per run (default 200000)\n");
+    printf("  -m R,U,I,D  mix in percent: read,update,insert,delete (default 90,5,3,2)\n");
+    printf("  -f FILE     output CSV (default performance_server.csv)\n");
+    printf("  -a          append to the CSV, to collect several servers in one file\n");
+}
+
+int main(int argc, char** argv) {
+    int connList[32] = {1, 8, 64, 256, 1024}, numConns = 5;
+    int depthList[32] = {1, 16}, numDepths = 2;
+    const char* csvFile = "performance_server.csv";
+    int append = 0;
+    int opt;
+    total = 200000;
+
+    while ((opt = getopt(argc, argv, "u:p:c:d:n:o:m:f:ah")) != -1) {
+        switch (opt) {
+            case 'u': unixPath = optarg; break;
+            case 'p': port = atoi(optarg); break;
+            case 'c': numConns = parseList(optarg, connList, 32); break;
+            case 'd': numDepths = parseList(optarg, depthList, 32); break;
+            case 'n': records = atoll(optarg); break;
+            case 'o': total = atoll(optarg); break;
+            case 'm':
+                if (sscanf(optarg, "%d,%d,%d,%d", &mix[0], &mix[1], &mix[2], &mix[3]) != 4 ||
+                    mix[0] + mix[1] + mix[2] + mix[3] != 100) {
+                    printf("The mix needs four percentages summing to 100\n");
+                    return 1;
+                }
+                break;
+            case 'f': csvFile = optarg; break;
+            case 'a': append = 1; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc || numConns < 1 || numDepths < 1 || records < 1 || total < 1) { usage(argv[0]); return 1; }
+    if (!unixPath && !port) unixPath = "contacts.sock";
+
+    struct rlimit rl;
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    signal(SIGPIPE, SIG_IGN);
+
+    FILE* fp = fopen(csvFile, append ? "a" : "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", csvFile);
+        return 1;
+    }
+    if (ftell(fp) == 0) {
+        fprintf(fp, "DataStructure,Transport,Connections,Depth,Ops,Time_ms,Throughput_ops_s,"
+                    "Avg_us,P50_us,P99_us,P999_us,Max_us,Misses\n");
+    }
+
+    char backendName[256];
+    loadRecords(backendName);
+    nextRecord = records;
+    latencies = (unsigned int*)malloc(total * sizeof(unsigned int));
+    const char* transport = unixPath ? "unix" : "tcp";
+    for (int i = 0; i < numConns; i++) {
+        for (int j = 0; j < numDepths; j++) runLoad(fp, backendName, transport, connList[i], depthList[j]);
+    }
+
+    fclose(fp);
+    free(latencies);
+    printf("Load results written to %s\n", csvFile);
+    return 0;
+}
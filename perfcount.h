@@ -0,0 +1,234 @@
+// Measurement shared by the *_performance.c benchmarks: memory accounting,
+// hardware counters and the CSV columns built from them.
+//
+// A benchmark times each phase between startPhase and stopPhase and then
+// writes its row with writeResult (RESULT_CSV_HEADER). Benchmarks with their
+// own columns end each row with writeCounters and their header with
+// COUNTER_CSV_COLUMNS, so every CSV has the same counter columns.
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#define malloc_usable_size malloc_size
+#else
+#include <malloc.h>
+#endif
+
+#define COUNTER_CSV_COLUMNS "Cycles_per_op,IPC,L1D_misses_per_op,LLC_misses_per_op,Branch_misses_per_op"
+#define RESULT_CSV_HEADER \
+    "DataStructure,Operation,Contacts,Time_ms,Bytes_per_contact,Allocs,Peak_RSS_KB,Overhead_bytes," \
+    COUNTER_CSV_COLUMNS "\n"
+
+// ---------------- Memory Accounting ----------------
+// Node allocations go through the counted* functions so each CSV row can
+// report live bytes per contact, live allocations and allocator overhead
+// (usable size handed out by malloc minus the bytes requested), next to the
+// process peak RSS read from /proc/self/status.
+//
+// A structure that never calls malloc defines PERF_STATIC_BYTES (its fixed
+// block) and PERF_USED_BYTES (the part of it in use) before the include. Its
+// rows then report the block per contact, one allocation, and the unused
+// part as overhead.
+#ifdef PERF_STATIC_BYTES
+static size_t liveBytes = PERF_STATIC_BYTES;
+static size_t liveUsable = PERF_STATIC_BYTES;
+static long liveAllocs = 1;
+#else
+static size_t liveBytes = 0;
+static size_t liveUsable = 0;
+static long liveAllocs = 0;
+#endif
+
+static inline void countAlloc(void* p, size_t size) {
+    liveBytes += size;
+    liveUsable += malloc_usable_size(p);
+    liveAllocs++;
+}
+
+static inline void* countedMalloc(size_t size) {
+    void* p = malloc(size);
+    countAlloc(p, size);
+    return p;
+}
+
+// Zeroed allocation; large blocks come from fresh pages that are zeroed as
+// they are first touched, not up front
+static inline void* countedCalloc(size_t count, size_t size) {
+    void* p = calloc(count, size);
+    countAlloc(p, count * size);
+    return p;
+}
+
+// 64-byte aligned, so a block can be exactly one cache line
+static inline void* countedAlignedAlloc(size_t size) {
+    void* p = aligned_alloc(64, size);
+    countAlloc(p, size);
+    return p;
+}
+
+static inline void countedFree(void* p, size_t size) {
+    if (p == NULL) return;
+    liveBytes -= size;
+    liveUsable -= malloc_usable_size(p);
+    liveAllocs--;
+    free(p);
+}
+
+static inline size_t overheadBytes(void) {
+#ifdef PERF_STATIC_BYTES
+    return liveBytes - (PERF_USED_BYTES);
+#else
+    return liveUsable - liveBytes;
+#endif
+}
+
+// Peak resident set size in KB (VmHWM), or getrusage where /proc is missing
+static inline long peakRSSKB(void) {
+    FILE* f = fopen("/proc/self/status", "r");
+    if (f) {
+        char line[256];
+        long kb = -1;
+        while (fgets(line, sizeof(line), f))
+            if (sscanf(line, "VmHWM: %ld kB", &kb) == 1) break;
+        fclose(f);
+        if (kb >= 0) return kb;
+    }
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024;
+#else
+    return ru.ru_maxrss;
+#endif
+}
+
+// Reset the peak so every size is measured on its own (Linux only)
+static inline void resetPeakRSS(void) {
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+}
+
+// ---------------- Hardware Counters ----------------
+// Every timed phase runs inside one perf_event_open group (cycles,
+// instructions, L1D read misses, LLC misses, branch misses) so each CSV row
+// can add per-op IPC and miss rates. Events the CPU refuses are left out of
+// the group; without a group leader (non-Linux, containers, virtual machines
+// without a PMU, a strict perf_event_paranoid) the counter columns stay
+// empty and only timing is kept. The group counts the calling thread only.
+#define NUM_COUNTERS 5
+enum { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, BRANCH_MISSES };
+static int counterFd[NUM_COUNTERS];
+static int counterSlot[NUM_COUNTERS];          // index of each event in the group read
+static long long counterValue[NUM_COUNTERS];   // last phase, -1 when not counted
+static int countersOpen = 0;                   // 0 untried, 1 open, -1 unavailable
+
+#ifdef __linux__
+static inline int openCounter(unsigned int type, unsigned long long config, int leader) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = (leader == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+#endif
+
+static inline void openCounters(void) {
+    countersOpen = -1;
+    for (int i = 0; i < NUM_COUNTERS; i++) counterFd[i] = counterSlot[i] = -1;
+#ifdef __linux__
+    const unsigned int type[NUM_COUNTERS] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE };
+    const unsigned long long config[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    int slots = 0;
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        counterFd[i] = openCounter(type[i], config[i], i == 0 ? -1 : counterFd[0]);
+        if (counterFd[0] < 0) break;
+        if (counterFd[i] >= 0) counterSlot[i] = slots++;
+    }
+    if (counterFd[0] >= 0) countersOpen = 1;
+#endif
+    if (countersOpen != 1) printf("Hardware counters unavailable, reporting timing only\n");
+}
+
+// Reset and enable the counter group, then start the clock
+static inline clock_t startPhase(void) {
+    if (countersOpen == 0) openCounters();
+#ifdef __linux__
+    if (countersOpen == 1) {
+        ioctl(counterFd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(counterFd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    return clock();
+}
+
+// Stop the clock, then disable the group and keep its counts for writeResult
+static inline clock_t stopPhase(void) {
+    clock_t end = clock();
+    for (int i = 0; i < NUM_COUNTERS; i++) counterValue[i] = -1;
+#ifdef __linux__
+    if (countersOpen == 1) {
+        unsigned long long buf[2 + NUM_COUNTERS];   // nr, time_running, values
+        ioctl(counterFd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // time_running == 0 means the group was never scheduled on the PMU
+        if (read(counterFd[0], buf, sizeof(buf)) > 0 && buf[1] > 0)
+            for (int i = 0; i < NUM_COUNTERS; i++)
+                if (counterSlot[i] >= 0) counterValue[i] = (long long)buf[2 + counterSlot[i]];
+    }
+#endif
+    return end;
+}
+
+// Leave the last phase's counter columns empty: its work ran on threads the
+// group does not count
+static inline void discardCounters(void) {
+    for (int i = 0; i < NUM_COUNTERS; i++) counterValue[i] = -1;
+}
+
+// Counter columns of a CSV row: cycles/op, IPC, then misses per op
+static inline void writeCounters(FILE* fp, int n) {
+    if (counterValue[CYCLES] >= 0) fprintf(fp, ",%.1f", (double)counterValue[CYCLES] / n);
+    else fprintf(fp, ",");
+    if (counterValue[CYCLES] > 0 && counterValue[INSTRUCTIONS] >= 0)
+        fprintf(fp, ",%.2f", (double)counterValue[INSTRUCTIONS] / counterValue[CYCLES]);
+    else fprintf(fp, ",");
+    for (int i = L1D_MISSES; i <= BRANCH_MISSES; i++) {
+        if (counterValue[i] >= 0) fprintf(fp, ",%.2f", (double)counterValue[i] / n);
+        else fprintf(fp, ",");
+    }
+}
+
+// One CSV row: timing, the memory state after the phase and its counters
+static inline void writeResult(FILE* fp, const char* label, int n, double ms) {
+    fprintf(fp, "%s,%d,%.3f,%.1f,%ld,%ld,%zu", label, n, ms,
+            n > 0 ? (double)liveBytes / n : 0.0, liveAllocs, peakRSSKB(), overheadBytes());
+    writeCounters(fp, n);
+    fputc('\n', fp);
+}
+
+#endif
@@ -1,3 +1,4 @@
+import os
 import pandas as pd
 import matplotlib.pyplot as plt
 
@@ -7,23 +8,32 @@ csv_files = {
     "LinkedList": "performance_ll.csv",
     "HashMap": "performance_hashmap.csv",
     "BST": "performance_bst.csv",
-    "AVL": "performance_avl.csv"
+    "AVL": "performance_avl.csv",
+    "SkipList": "performance_skiplist.csv",
+    "Splay": "performance_splay.csv",
+    "Cuckoo": "performance_cuckoo.csv"
 }
 
-# Read all CSVs into a single DataFrame
-df_list = []
-for ds, file in csv_files.items():
-    df = pd.read_csv(file)
-    df['DataStructure'] = ds
-    df_list.append(df)
-
-all_data = pd.concat(df_list, ignore_index=True)
+# Prefer the runner's merged file (median over repetitions); otherwise read
+# the per-structure CSVs written from the interactive menus
+if os.path.exists("performance_all.csv"):
+    runs = pd.read_csv("performance_all.csv", comment='#')
+    all_data = (runs.drop(columns=['Rep', 'Core', 'Start_MHz', 'End_MHz', 'Wall_s'])
+                    .groupby(['DataStructure', 'Operation', 'Contacts'], as_index=False, sort=False)
+                    .median())
+else:
+    df_list = []
+    for ds, file in csv_files.items():
+        df = pd.read_csv(file)
+        df['DataStructure'] = ds
+        df_list.append(df)
+    all_data = pd.concat(df_list, ignore_index=True)
 
 # Operations
 operations = ["Insert", "Search", "Update", "Delete"]
 
-# Create figure with 4 subplots
-fig, axs = plt.subplots(2, 2, figsize=(14,10))
+# Create figure with 4 timing subplots and 2 memory subplots
+fig, axs = plt.subplots(2, 3, figsize=(20,10))
 axs = axs.flatten()
 
 # Color and line style map for clarity
@@ -32,7 +42,10 @@ styles = {
     "LinkedList": ("green", "s--"),
     "HashMap": ("red", "^-"),
     "BST": ("purple", "d-."),
-    "AVL": ("orange", "x:")
+    "AVL": ("orange", "x:"),
+    "SkipList": ("brown", "v--"),
+    "Splay": ("teal", "p-."),
+    "Cuckoo": ("magenta", "h:")
 }
 
 for i, op in enumerate(operations):
@@ -50,6 +63,27 @@ for i, op in enumerate(operations):
     ax.grid(True)
     ax.legend()
 
+# Memory panels, sampled right after the Insert phase (older CSVs without
+# the memory columns are skipped)
+memory_panels = [
+    ("Bytes_per_contact", "Memory per Contact", "Bytes / contact"),
+    ("Overhead_bytes", "Allocator Overhead", "Bytes"),
+]
+insert_data = all_data[all_data['Operation'] == "Insert"]
+for ax, (column, title, ylabel) in zip(axs[4:], memory_panels):
+    for ds in csv_files.keys():
+        ds_data = insert_data[insert_data['DataStructure'] == ds]
+        if column not in ds_data or ds_data[column].isna().all():
+            continue
+        color, style = styles[ds]
+        ax.plot(ds_data['Contacts'], ds_data[column], style, color=color, label=ds)
+
+    ax.set_title(title)
+    ax.set_xlabel('Number of Contacts')
+    ax.set_ylabel(ylabel)
+    ax.grid(True)
+    ax.legend()
+
 plt.suptitle('Benchmark Comparison of Data Structures', fontsize=16)
 plt.tight_layout(rect=[0, 0.03, 1, 0.95])
 
@@ -0,0 +1,73 @@
+// Binary request protocol spoken by server.c and loadgen.c.
+//
+// Request:  u8 op, u8 name length, u8 phone length, u8 email length, then the
+//           name, phone and email bytes without NULs (unused fields empty).
+// Response: u8 status, u8 phone length, u8 email length, then the phone and
+//           email bytes (the contact on a found search, otherwise empty).
+//
+// Operation codes are those of trace.h, so a server session can be recorded
+// as a trace and replayed. A client may send any number of requests without
+// waiting for answers. The server answers each connection's requests in the
+// order they arrived, so responses carry no request id.
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <string.h>
+#include "trace.h"
+
+#define PROTO_HELLO 15          // answered with the backend name in the phone field
+#define PROTO_REQUEST_HEADER 4
+#define PROTO_RESPONSE_HEADER 3
+#define PROTO_MAX_REQUEST (PROTO_REQUEST_HEADER + 3 * 255)
+#define PROTO_MAX_RESPONSE (PROTO_RESPONSE_HEADER + 2 * 255)
+
+enum {
+    STATUS_OK,     // inserted, found, updated or deleted
+    STATUS_MISS,   // insert of an existing name, or name not found
+    STATUS_FULL,   // the backend has no room (fixed-size array)
+    STATUS_BAD     // unknown operation or field too long; the server then closes
+};
+
+// Write a request to buf; returns its length
+static inline int protoPutRequest(char* buf, int op, const char* name, const char* phone, const char* email) {
+    size_t n = strlen(name), p = phone ? strlen(phone) : 0, e = email ? strlen(email) : 0;
+    unsigned char* b = (unsigned char*)buf;
+    b[0] = (unsigned char)op;
+    b[1] = (unsigned char)n;
+    b[2] = (unsigned char)p;
+    b[3] = (unsigned char)e;
+    memcpy(buf + PROTO_REQUEST_HEADER, name, n);
+    if (p) memcpy(buf + PROTO_REQUEST_HEADER + n, phone, p);
+    if (e) memcpy(buf + PROTO_REQUEST_HEADER + n + p, email, e);
+    return (int)(PROTO_REQUEST_HEADER + n + p + e);
+}
+
+// Length of the complete request at buf, or 0 if more bytes are needed
+static inline int protoRequestLength(const char* buf, size_t avail) {
+    const unsigned char* b = (const unsigned char*)buf;
+    if (avail < PROTO_REQUEST_HEADER) return 0;
+    int len = PROTO_REQUEST_HEADER + b[1] + b[2] + b[3];
+    return (size_t)len <= avail ? len : 0;
+}
+
+// Write a response to buf; returns its length
+static inline int protoPutResponse(char* buf, int status, const char* phone, const char* email) {
+    size_t p = phone ? strlen(phone) : 0, e = email ? strlen(email) : 0;
+    unsigned char* b = (unsigned char*)buf;
+    b[0] = (unsigned char)status;
+    b[1] = (unsigned char)p;
+    b[2] = (unsigned char)e;
+    if (p) memcpy(buf + PROTO_RESPONSE_HEADER, phone, p);
+    if (e) memcpy(buf + PROTO_RESPONSE_HEADER + p, email, e);
+    return (int)(PROTO_RESPONSE_HEADER + p + e);
+}
+
+// Length of the complete response at buf, or 0 if more bytes are needed
+static inline int protoResponseLength(const char* buf, size_t avail) {
+    const unsigned char* b = (const unsigned char*)buf;
+    if (avail < PROTO_RESPONSE_HEADER) return 0;
+    int len = PROTO_RESPONSE_HEADER + b[1] + b[2];
+    return (size_t)len <= avail ? len : 0;
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "backends.h"
+#include "trace.h"
+
+// Replays a recorded operation trace (see trace.h) against every backend as
+// fast as possible. The whole trace is read into memory first so the timed
+// loop does no I/O; each operation is timed on its own for the percentiles.
+// After the replay a checksum of the final contents (independent of storage
+// order) is compared across backends, so a backend that diverges on the same
+// operation stream stands out.
+
+static const char* traceOpNames[TRACE_NUM_OPS] = {"", "Insert", "Search", "Update", "Delete", "Upsert", "Scan"};
+
+typedef struct {
+    unsigned int* ns;
+    long count;
+    long misses;
+} Latencies;
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compareUInt(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(unsigned int* sorted, long count, double p) {
+    long i = (long)ceil(p * count) - 1;
+    if (i < 0) i = 0;
+    return sorted[i] / 1000.0;
+}
+
+// ---------------- Final State Checksum ----------------
+// Sum of per-contact FNV-1a hashes: the same contents give the same value
+// whatever order visit walks them in
+static void checksumContact(void* ctx, const char* name, const char* phone, const char* email) {
+    const char* fields[3] = {name, phone, email};
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i = 0; i < 3; i++) {
+        for (const char* s = fields[i]; *s; s++) {
+            h ^= (unsigned char)*s;
+            h *= 1099511628211ULL;
+        }
+        h ^= '|';
+        h *= 1099511628211ULL;
+    }
+    *(unsigned long long*)ctx += h;
+}
+
+// ---------------- Replay ----------------
+static void writeRow(FILE* fp, const char* backend, const char* op, unsigned int* samples, long count,
+                     long misses, double elapsedMs) {
+    qsort(samples, count, sizeof(unsigned int), compareUInt);
+    double sum = 0;
+    for (long i = 0; i < count; i++) sum += samples[i];
+    char throughput[32] = "";
+    if (elapsedMs > 0) snprintf(throughput, sizeof(throughput), "%.0f", count / (elapsedMs / 1000.0));
+    else elapsedMs = sum / 1e6;
+    fprintf(fp, "%s,%s,%ld,%.3f,%s,%.3f,%.3f,%.3f,%.3f,%.3f,%ld\n", backend, op, count, elapsedMs, throughput,
+            sum / count / 1000.0, percentileUs(samples, count, 0.50), percentileUs(samples, count, 0.99),
+            percentileUs(samples, count, 0.999), samples[count - 1] / 1000.0, misses);
+    printf("  %-8s %9ld ops %12s ops/s  p50 %8.3f us  p99 %8.3f us  p99.9 %9.3f us  max %9.3f us\n",
+           op, count, throughput, percentileUs(samples, count, 0.50), percentileUs(samples, count, 0.99),
+           percentileUs(samples, count, 0.999), samples[count - 1] / 1000.0);
+}
+
+// Run every operation of the trace against b; returns the final-state checksum
+static unsigned long long replayBackend(FILE* fp, const Backend* b, TraceOp* ops, long count, long inserts,
+                                        long* contacts) {
+    static Latencies lat[TRACE_NUM_OPS];
+    volatile long sink = 0;
+    for (int op = 0; op < TRACE_NUM_OPS; op++) {
+        lat[op].ns = (unsigned int*)realloc(lat[op].ns, count * sizeof(unsigned int));
+        lat[op].count = lat[op].misses = 0;
+    }
+    printf("%s\n", b->name);
+    b->init((int)(inserts > 0 ? inserts : 1));
+
+    long long start = nowNs();
+    for (long i = 0; i < count; i++) {
+        TraceOp* t = &ops[i];
+        long long t0 = nowNs();
+        int hit = 1;
+        switch (t->op) {
+            case TRACE_INSERT: hit = b->insert(t->name, t->phone, t->email) == 1; break;
+            case TRACE_SEARCH: hit = b->search(t->name); break;
+            case TRACE_UPDATE: hit = b->update(t->name, t->phone, t->email); break;
+            case TRACE_DELETE: hit = b->remove(t->name); break;
+            case TRACE_UPSERT: {
+                int r = b->insert(t->name, t->phone, t->email);
+                hit = r == 1 || (r == 0 && b->update(t->name, t->phone, t->email));
+                break;
+            }
+            case TRACE_SCAN:
+                if (b->scan) sink += b->scan(t->name, t->arg);
+                break;
+        }
+        lat[t->op].ns[lat[t->op].count++] = (unsigned int)(nowNs() - t0);
+        if (!hit) lat[t->op].misses++;
+    }
+    double runMs = (nowNs() - start) / 1e6;
+
+    long total = 0, misses = 0;
+    unsigned int* all = (unsigned int*)malloc(count * sizeof(unsigned int));
+    for (int op = 1; op < TRACE_NUM_OPS; op++) {
+        if (lat[op].count == 0) continue;
+        memcpy(all + total, lat[op].ns, lat[op].count * sizeof(unsigned int));
+        total += lat[op].count;
+        misses += lat[op].misses;
+        writeRow(fp, b->name, traceOpNames[op], lat[op].ns, lat[op].count, lat[op].misses, 0);
+    }
+    writeRow(fp, b->name, "All", all, total, misses, runMs);
+    free(all);
+
+    unsigned long long sum = 0;
+    *contacts = b->visit(checksumContact, &sum);
+    b->destroy();
+    return sum;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [-b backend|all] [-f results.csv] trace\n", prog);
+    printf("  -b NAME   Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo, Adaptive or all (default all)\n");
+    printf("  -f FILE   output CSV (default performance_replay.csv)\n");
+    printf("Traces come from workload -r FILE or from any interactive program run with\n");
+    printf("CONTACT_TRACE=FILE in the environment.\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "all";
+    const char* csvFile = "performance_replay.csv";
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:f:h")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 'f': csvFile = optarg; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1) { usage(argv[0]); return 1; }
+
+    const Backend* only = NULL;
+    if (strcmp(backendName, "all") != 0 && (only = findBackend(backendName)) == NULL) {
+        printf("Unknown backend %s\n", backendName);
+        return 1;
+    }
+
+    TraceOp* ops;
+    long count = traceLoad(argv[optind], &ops);
+    if (count < 0) {
+        printf("%s is not an operation trace\n", argv[optind]);
+        return 1;
+    }
+    if (count == 0) {
+        printf("%s holds no operations\n", argv[optind]);
+        free(ops);
+        return 1;
+    }
+    long perOp[TRACE_NUM_OPS] = {0};
+    for (long i = 0; i < count; i++) perOp[ops[i].op]++;
+    printf("%s: %ld operations (", argv[optind], count);
+    for (int op = 1; op < TRACE_NUM_OPS; op++) printf("%s%s %ld", op > 1 ? ", " : "", traceOpNames[op], perOp[op]);
+    printf(")\n");
+    if (perOp[TRACE_SCAN] > 0) printf("Scans are skipped on the unordered backends\n");
+
+    FILE* fp = fopen(csvFile, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", csvFile);
+        return 1;
+    }
+    fprintf(fp, "DataStructure,Operation,Ops,Time_ms,Throughput_ops_s,Avg_us,P50_us,P99_us,P999_us,Max_us,Misses\n");
+
+    unsigned long long sums[NUM_BACKENDS];
+    long contacts[NUM_BACKENDS];
+    int ran[NUM_BACKENDS] = {0};
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        if (only && only != &backends[i]) continue;
+        sums[i] = replayBackend(fp, &backends[i], ops, count, perOp[TRACE_INSERT] + perOp[TRACE_UPSERT], &contacts[i]);
+        ran[i] = 1;
+    }
+    fclose(fp);
+
+    // Every backend should end with the same contents
+    int first = -1, diverged = 0;
+    printf("Final state:\n");
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        if (!ran[i]) continue;
+        if (first < 0) first = i;
+        int same = sums[i] == sums[first] && contacts[i] == contacts[first];
+        diverged |= !same;
+        printf("  %-10s %8ld contacts  checksum %016llx%s\n", backends[i].name, contacts[i], sums[i],
+               same ? "" : "  DIFFERS");
+    }
+    free(ops);
+    printf("Replay results written to %s\n", csvFile);
+    return diverged;
+}
@@ -0,0 +1,274 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+
+// Non-interactive benchmark runner.
+// Every *_performance program is started with --bench in its own process,
+// pinned to its own core. Repetitions are interleaved (rep 1 of every
+// backend, then rep 2, ...) with the launch order rotated each time, so
+// thermal or frequency drift over the session is spread across backends
+// instead of landing on whichever ran last. The per-run CSVs are merged into
+// one file whose leading "#" lines record the machine and CPU frequency setup.
+
+#define MAX_CORES 256
+#define PATH_LEN 256
+#define MAX_REPS 64
+
+typedef struct {
+    const char* name;   // short name used for per-run files
+    const char* exe;
+} Bench;
+
+static Bench benches[] = {
+    {"array",    "./array_performance"},
+    {"ll",       "./ll_performance"},
+    {"hashmap",  "./hashmap_performance"},
+    {"bst",      "./bst_performance"},
+    {"avl",      "./avl_performance"},
+    {"skiplist", "./skiplist_performance"},
+    {"splay",    "./splay_performance"},
+    {"cuckoo",   "./cuckoo_performance"},
+};
+#define NUM_BENCHES ((int)(sizeof(benches) / sizeof(benches[0])))
+
+typedef struct {
+    pid_t pid;
+    int core;
+    long startKHz, endKHz;
+    struct timespec start;
+    double wallS;
+    int ok;
+} Run;
+
+// ---------------- System Information ----------------
+// First line of a sysfs/procfs file, or "unknown"
+static void readLine(const char* path, char* out, int len) {
+    FILE* f = fopen(path, "r");
+    if (!f || !fgets(out, len, f)) snprintf(out, len, "unknown");
+    else out[strcspn(out, "\n")] = 0;
+    if (f) fclose(f);
+}
+
+// Current frequency of a core in kHz, -1 if cpufreq is not exposed
+static long coreKHz(int core) {
+    char path[PATH_LEN], line[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", core);
+    readLine(path, line, sizeof(line));
+    return strcmp(line, "unknown") == 0 ? -1 : atol(line);
+}
+
+static void cpuModel(char* out, int len) {
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    char line[256];
+    snprintf(out, len, "unknown");
+    if (!f) return;
+    while (fgets(line, sizeof(line), f)) {
+        char* colon = strchr(line, ':');
+        if (colon && strncmp(line, "model name", 10) == 0) {
+            line[strcspn(line, "\n")] = 0;
+            snprintf(out, len, "%s", colon + 2);
+            break;
+        }
+    }
+    fclose(f);
+}
+
+// Turbo state from intel_pstate (no_turbo) or the generic cpufreq boost knob
+static const char* turboState(void) {
+    char line[64];
+    readLine("/sys/devices/system/cpu/intel_pstate/no_turbo", line, sizeof(line));
+    if (strcmp(line, "unknown") != 0) return atoi(line) ? "off" : "on";
+    readLine("/sys/devices/system/cpu/cpufreq/boost", line, sizeof(line));
+    if (strcmp(line, "unknown") != 0) return atoi(line) ? "on" : "off";
+    return "unknown";
+}
+
+// Cores this process may run on; core 0 is left to the OS and the runner
+// when there are enough others for every backend
+static int usableCores(int* cores) {
+    cpu_set_t set;
+    int count = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        cores[0] = 0;
+        return 1;
+    }
+    for (int c = 0; c < CPU_SETSIZE && count < MAX_CORES; c++)
+        if (CPU_ISSET(c, &set)) cores[count++] = c;
+    if (count > NUM_BENCHES && cores[0] == 0) {
+        memmove(cores, cores + 1, (count - 1) * sizeof(int));
+        count--;
+    }
+    return count;
+}
+
+// ---------------- Launching ----------------
+static double secondsSince(struct timespec* t0) {
+    struct timespec t1;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (t1.tv_sec - t0->tv_sec) + (t1.tv_nsec - t0->tv_nsec) / 1e9;
+}
+
+// Fork, pin the child to core, send its output to logFile and exec the benchmark
+static pid_t launch(Bench* b, int core, const char* csvFile, const char* logFile) {
+    pid_t pid = fork();
+    if (pid != 0) return pid;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) perror("sched_setaffinity");
+    int fd = open(logFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    execl(b->exe, b->exe, "--bench", csvFile, (char*)NULL);
+    perror(b->exe);
+    _exit(127);
+}
+
+static void runFile(char* out, const char* dir, int rep, Bench* b, const char* ext) {
+    snprintf(out, PATH_LEN, "%s/rep%d_%s.%s", dir, rep, b->name, ext);
+}
+
+// ---------------- Merging ----------------
+// Append the data rows of one run's CSV, prefixed with the run columns.
+// The first file's header (after the run columns) becomes the merged header.
+static int mergeRun(FILE* out, const char* csvFile, int rep, Run* r, int* headerDone) {
+    FILE* in = fopen(csvFile, "r");
+    char line[1024];
+    if (!in) return 0;
+    if (fgets(line, sizeof(line), in) && !*headerDone) {
+        fprintf(out, "Rep,Core,Start_MHz,End_MHz,Wall_s,%s", line);
+        *headerDone = 1;
+    }
+    while (fgets(line, sizeof(line), in))
+        fprintf(out, "%d,%d,%ld,%ld,%.3f,%s", rep, r->core,
+                r->startKHz > 0 ? r->startKHz / 1000 : -1,
+                r->endKHz > 0 ? r->endKHz / 1000 : -1, r->wallS, line);
+    fclose(in);
+    return 1;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [-r reps] [-o merged.csv] [-d rundir] [-s]\n", prog);
+    printf("  -r N     repetitions per backend, 1 to %d (default 3)\n", MAX_REPS);
+    printf("  -o FILE  merged results (default performance_all.csv)\n");
+    printf("  -d DIR   per-run CSVs and logs (default runs)\n");
+    printf("  -s       one backend at a time, still pinned (no neighbours sharing caches)\n");
+}
+
+int main(int argc, char** argv) {
+    int reps = 3, sequential = 0, opt;
+    const char* outFile = "performance_all.csv";
+    const char* runDir = "runs";
+
+    while ((opt = getopt(argc, argv, "r:o:d:sh")) != -1) {
+        switch (opt) {
+            case 'r': reps = atoi(optarg); break;
+            case 'o': outFile = optarg; break;
+            case 'd': runDir = optarg; break;
+            case 's': sequential = 1; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (reps < 1 || reps > MAX_REPS) { usage(argv[0]); return 1; }
+
+    for (int i = 0; i < NUM_BENCHES; i++) {
+        if (access(benches[i].exe, X_OK) != 0) {
+            printf("Missing %s: compile the benchmark programs first\n", benches[i].exe);
+            return 1;
+        }
+    }
+    mkdir(runDir, 0755);
+
+    int cores[MAX_CORES];
+    int ncores = usableCores(cores);
+    int wave = sequential ? 1 : (ncores < NUM_BENCHES ? ncores : NUM_BENCHES);
+    if (wave < NUM_BENCHES && !sequential)
+        printf("Only %d usable cores: running backends in waves of %d\n", ncores, wave);
+
+    Run runs[MAX_REPS][NUM_BENCHES];
+    time_t started = time(NULL);
+    char model[256], governor[64], path[PATH_LEN];
+    cpuModel(model, sizeof(model));
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cores[0]);
+    readLine(path, governor, sizeof(governor));
+    const char* turbo = turboState();
+
+    for (int rep = 0; rep < reps; rep++) {
+        printf("Repetition %d/%d\n", rep + 1, reps);
+        // Rotate the launch order each repetition
+        int order[NUM_BENCHES];
+        for (int i = 0; i < NUM_BENCHES; i++) order[i] = (i + rep) % NUM_BENCHES;
+
+        for (int first = 0; first < NUM_BENCHES; first += wave) {
+            int last = first + wave < NUM_BENCHES ? first + wave : NUM_BENCHES;
+            for (int k = first; k < last; k++) {
+                int i = order[k];
+                Run* r = &runs[rep][i];
+                char csv[PATH_LEN], log[PATH_LEN];
+                runFile(csv, runDir, rep + 1, &benches[i], "csv");
+                runFile(log, runDir, rep + 1, &benches[i], "log");
+                // A backend keeps its core across repetitions unless the
+                // machine is too small and backends share cores in waves
+                r->core = (sequential || wave == NUM_BENCHES) ? cores[i % ncores] : cores[k - first];
+                r->startKHz = coreKHz(r->core);
+                clock_gettime(CLOCK_MONOTONIC, &r->start);
+                r->pid = launch(&benches[i], r->core, csv, log);
+            }
+            for (int done = first; done < last; done++) {
+                int status;
+                pid_t pid = wait(&status);
+                for (int k = first; k < last; k++) {
+                    Run* r = &runs[rep][order[k]];
+                    if (r->pid != pid) continue;
+                    r->wallS = secondsSince(&r->start);
+                    r->endKHz = coreKHz(r->core);
+                    r->ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+                    printf("  %-9s core %-3d %7.2f s%s\n", benches[order[k]].name, r->core, r->wallS,
+                           r->ok ? "" : "  FAILED (see log)");
+                }
+            }
+        }
+    }
+
+    // Merge every successful run into one file
+    FILE* out = fopen(outFile, "w");
+    if (!out) {
+        printf("Cannot open file %s\n", outFile);
+        return 1;
+    }
+    struct utsname uts;
+    uname(&uts);
+    char date[64];
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&started));
+    fprintf(out, "# started: %s\n", date);
+    fprintf(out, "# host: %s, %s %s %s\n", uts.nodename, uts.sysname, uts.release, uts.machine);
+    fprintf(out, "# cpu: %s\n", model);
+    fprintf(out, "# governor: %s, turbo: %s\n", governor, turbo);
+    fprintf(out, "# mode: %s, repetitions: %d, cores:", sequential ? "sequential" : "parallel", reps);
+    for (int i = 0; i < ncores && i < NUM_BENCHES; i++) fprintf(out, " %d", cores[i]);
+    fprintf(out, "\n");
+
+    int headerDone = 0, merged = 0;
+    for (int rep = 0; rep < reps; rep++) {
+        for (int i = 0; i < NUM_BENCHES; i++) {
+            char csv[PATH_LEN];
+            runFile(csv, runDir, rep + 1, &benches[i], "csv");
+            if (runs[rep][i].ok) merged += mergeRun(out, csv, rep + 1, &runs[rep][i], &headerDone);
+        }
+    }
+    fclose(out);
+    printf("Merged %d of %d runs into %s\n", merged, reps * NUM_BENCHES, outFile);
+    return merged == reps * NUM_BENCHES ? 0 : 1;
+}
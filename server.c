@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "backends.h"
+#include "protocol.h"
+
+// Serves one backend from backends.h to many clients, over a Unix domain
+// socket, localhost TCP or both. The wire format is in protocol.h.
+//
+// A single thread runs an epoll loop over the listening sockets and every
+// connection. The backends are single-threaded, and so is the loop, so the
+// contacts need no locking: each request runs to completion between reads.
+// A read is parsed in place. Every complete request in the buffer is
+// dispatched and its response appended to the connection's output buffer,
+// which is then written in one call. A client that pipelines N requests
+// therefore costs one read and one write per batch rather than N of each.
+// Once a connection has OUT_HIGH bytes of unsent responses, its input is no
+// longer read until the client catches up. A client that never reads
+// cannot make the server grow without bound.
+//
+// Linux only (epoll).
+
+#define IN_BUF 16384
+#define OUT_HIGH (1 << 20)
+#define MAX_EVENTS 256
+
+typedef struct {
+    int fd;
+    unsigned int events;   // epoll interest currently registered
+    int closing;           // bad request: close once the output is written
+    size_t inLen;
+    char* out;
+    size_t outLen, outSent, outCap;
+    char in[IN_BUF];
+} Conn;
+
+static const Backend* backend;
+static int epfd;
+static int listenFds[2], numListen = 0;
+static Conn** conns;            // by file descriptor
+static long maxConns;
+static volatile sig_atomic_t stopping = 0;
+static long long served[TRACE_NUM_OPS + 1], missed[TRACE_NUM_OPS + 1];
+static long accepted = 0, openConns = 0, badRequests = 0;
+
+static const char* opNames[TRACE_NUM_OPS + 1] = {"", "Insert", "Search", "Update", "Delete", "Upsert", "Scan", "Hello"};
+
+static void countContact(void* ctx, const char* name, const char* phone, const char* email) {
+    (void)name; (void)phone; (void)email;
+    (*(long*)ctx)++;
+}
+
+static void onSignal(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+static void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+// ---------------- Connections ----------------
+static void closeConn(Conn* c) {
+    epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    conns[c->fd] = NULL;
+    free(c->out);
+    free(c);
+    openConns--;
+}
+
+static void acceptAll(int listenFd) {
+    while (1) {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) perror("accept");
+            return;
+        }
+        if (fd >= maxConns) {
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));   // fails harmlessly on Unix sockets
+        setNonBlocking(fd);
+        Conn* c = (Conn*)malloc(sizeof(Conn));
+        c->fd = fd;
+        c->events = EPOLLIN;
+        c->closing = 0;
+        c->inLen = 0;
+        c->outCap = 4096;
+        c->out = (char*)malloc(c->outCap);
+        c->outLen = c->outSent = 0;
+        conns[fd] = c;
+        struct epoll_event ev = {.events = EPOLLIN, .data.fd = fd};
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+        accepted++;
+        openConns++;
+    }
+}
+
+// ---------------- Requests ----------------
+// Run one request against the backend and append its response
+static void dispatch(Conn* c, const char* req) {
+    const unsigned char* h = (const unsigned char*)req;
+    int op = h[0], n = h[1], p = h[2], e = h[3];
+    char name[NAME_LEN], phone[PHONE_LEN] = "", email[EMAIL_LEN] = "";
+    int status = STATUS_BAD;
+    const char* replyPhone = NULL;
+    const char* replyEmail = NULL;
+
+    if (n < NAME_LEN && p < PHONE_LEN && e < EMAIL_LEN) {
+        memcpy(name, req + PROTO_REQUEST_HEADER, n);
+        name[n] = '\0';
+        memcpy(phone, req + PROTO_REQUEST_HEADER + n, p);
+        phone[p] = '\0';
+        memcpy(email, req + PROTO_REQUEST_HEADER + n + p, e);
+        email[e] = '\0';
+        if (op >= TRACE_INSERT && op <= TRACE_UPSERT) traceRecord(op, name, phone, email, 0);
+
+        int r;
+        switch (op) {
+            case TRACE_INSERT:
+                r = backend->insert(name, phone, email);
+                status = r == 1 ? STATUS_OK : r == 0 ? STATUS_MISS : STATUS_FULL;
+                break;
+            case TRACE_SEARCH:
+                status = backend->get(name, phone, email) ? STATUS_OK : STATUS_MISS;
+                replyPhone = phone;
+                replyEmail = email;
+                if (status != STATUS_OK) replyPhone = replyEmail = NULL;
+                break;
+            case TRACE_UPDATE:
+                status = backend->update(name, phone, email) ? STATUS_OK : STATUS_MISS;
+                break;
+            case TRACE_DELETE:
+                status = backend->remove(name) ? STATUS_OK : STATUS_MISS;
+                break;
+            case TRACE_UPSERT:
+                r = backend->insert(name, phone, email);
+                status = r == 1 || (r == 0 && backend->update(name, phone, email)) ? STATUS_OK : STATUS_FULL;
+                break;
+            case PROTO_HELLO:
+                status = STATUS_OK;
+                replyPhone = backend->name;
+                op = TRACE_NUM_OPS;
+                break;
+        }
+    }
+    if (status == STATUS_BAD) {
+        badRequests++;
+        c->closing = 1;
+    } else {
+        served[op]++;
+        if (status != STATUS_OK) missed[op]++;
+    }
+
+    if (c->outCap - c->outLen < PROTO_MAX_RESPONSE) {
+        c->outCap *= 2;
+        c->out = (char*)realloc(c->out, c->outCap);
+    }
+    c->outLen += protoPutResponse(c->out + c->outLen, status, replyPhone, replyEmail);
+}
+
+// Dispatch every complete request in the input buffer, unless the output has backed up
+static void processInput(Conn* c) {
+    size_t off = 0;
+    while (!c->closing && c->outLen - c->outSent < OUT_HIGH) {
+        int len = protoRequestLength(c->in + off, c->inLen - off);
+        if (len == 0) break;
+        dispatch(c, c->in + off);
+        off += len;
+    }
+    if (off > 0) {
+        memmove(c->in, c->in + off, c->inLen - off);
+        c->inLen -= off;
+    }
+}
+
+// Write what the socket takes; 0 if the connection was closed
+static int flushOutput(Conn* c) {
+    while (c->outSent < c->outLen) {
+        ssize_t w = write(c->fd, c->out + c->outSent, c->outLen - c->outSent);
+        if (w < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            if (errno == EINTR) continue;
+            closeConn(c);
+            return 0;
+        }
+        c->outSent += w;
+    }
+    if (c->outSent == c->outLen) {
+        c->outSent = c->outLen = 0;
+        if (c->closing) {
+            closeConn(c);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Process buffered input, write the responses, and ask epoll for input only
+// while the output is below OUT_HIGH and for output only while some is unsent
+static void service(Conn* c) {
+    do {   // input paused at OUT_HIGH can leave whole requests behind
+        processInput(c);
+        if (!flushOutput(c)) return;
+    } while (c->outLen == 0 && protoRequestLength(c->in, c->inLen) > 0);
+    size_t pending = c->outLen - c->outSent;
+    unsigned int want = (pending < OUT_HIGH && !c->closing ? EPOLLIN : 0) | (pending > 0 ? EPOLLOUT : 0);
+    if (want != c->events) {
+        struct epoll_event ev = {.events = want, .data.fd = c->fd};
+        epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+        c->events = want;
+    }
+}
+
+static void onReadable(Conn* c) {
+    ssize_t r = read(c->fd, c->in + c->inLen, IN_BUF - c->inLen);
+    if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+        closeConn(c);
+        return;
+    }
+    if (r > 0) c->inLen += r;
+    service(c);
+}
+
+// ---------------- Listening Sockets ----------------
+static int listenUnix(const char* path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        printf("Socket path too long: %s\n", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        perror(path);
+        return -1;
+    }
+    return fd;
+}
+
+static int listenTcp(int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        perror("tcp");
+        return -1;
+    }
+    return fd;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [-b backend] [-u path] [-p port] [-n capacity] [-r trace]\n", prog);
+    printf("  -b NAME   Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo or Adaptive (default HashMap)\n");
+    printf("  -u PATH   listen on a Unix domain socket (default contacts.sock when -p is not given)\n");
+    printf("  -p PORT   listen on 127.0.0.1:PORT\n");
+    printf("  -n N      initial capacity passed to the backend (default 100000)\n");
+    printf("  -r FILE   record every insert, search, update, delete and upsert as a trace\n");
+    printf("Stops on SIGINT or SIGTERM and prints the requests served.\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "HashMap";
+    const char* unixPath = NULL;
+    int port = 0, capacity = 100000;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:u:p:n:r:h")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 'u': unixPath = optarg; break;
+            case 'p': port = atoi(optarg); break;
+            case 'n': capacity = atoi(optarg); break;
+            case 'r': traceOpen(optarg); break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc || capacity < 1) { usage(argv[0]); return 1; }
+    if (!unixPath && !port) unixPath = "contacts.sock";
+    if ((backend = findBackend(backendName)) == NULL) {
+        printf("Unknown backend %s\n", backendName);
+        return 1;
+    }
+
+    // One descriptor per connection: raise the soft limit as far as allowed
+    struct rlimit rl;
+    getrlimit(RLIMIT_NOFILE, &rl);
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    getrlimit(RLIMIT_NOFILE, &rl);
+    maxConns = (long)rl.rlim_cur;
+    conns = (Conn**)calloc(maxConns, sizeof(Conn*));
+
+    if (unixPath && (listenFds[numListen++] = listenUnix(unixPath)) < 0) return 1;
+    if (port && (listenFds[numListen++] = listenTcp(port)) < 0) return 1;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    epfd = epoll_create1(0);
+    for (int i = 0; i < numListen; i++) {
+        setNonBlocking(listenFds[i]);
+        struct epoll_event ev = {.events = EPOLLIN, .data.fd = listenFds[i]};
+        epoll_ctl(epfd, EPOLL_CTL_ADD, listenFds[i], &ev);
+    }
+    backend->init(capacity);
+    printf("Serving %s on", backend->name);
+    if (unixPath) printf(" %s", unixPath);
+    if (port) printf(" 127.0.0.1:%d", port);
+    printf(" (up to %ld descriptors)\n", maxConns);
+    fflush(stdout);
+
+    struct epoll_event events[MAX_EVENTS];
+    while (!stopping) {
+        int n = epoll_wait(epfd, events, MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listenFds[0] || (numListen > 1 && fd == listenFds[1])) {
+                acceptAll(fd);
+                continue;
+            }
+            Conn* c = conns[fd];
+            if (c == NULL) continue;   // closed earlier in this batch
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) onReadable(c);
+            else if (events[i].events & EPOLLOUT) service(c);
+        }
+    }
+
+    printf("\nServed %ld connections (%ld bad requests)\n", accepted, badRequests);
+    for (int op = 1; op <= TRACE_NUM_OPS; op++) {
+        if (served[op] > 0) printf("  %-7s %12lld requests %12lld misses\n", opNames[op], served[op], missed[op]);
+    }
+    for (long fd = 0; fd < maxConns; fd++) {
+        if (conns[fd]) closeConn(conns[fd]);
+    }
+    for (int i = 0; i < numListen; i++) close(listenFds[i]);
+    if (unixPath) unlink(unixPath);
+    long contacts = 0;
+    backend->visit(countContact, &contacts);
+    printf("%ld contacts at exit\n", contacts);
+    backend->destroy();
+    traceClose();
+    free(conns);
+    return 0;
+}
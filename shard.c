@@ -0,0 +1,498 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#define BACKENDS_PER_THREAD
+#include "backends.h"
+
+// Shared-nothing sharding: the store is split into N shards. Each is a
+// private instance of one backend from backends.h, owned by one thread
+// pinned to its own core. No shard's contacts are touched by another thread,
+// so there are no locks. A contact lives on the shard picked by a hash of its
+// name.
+//
+// Every thread is also a client. It draws its share of the operations from a
+// read/update/insert/delete/scan mix. It runs the operations for its own shard
+// directly and sends the rest to the owner as messages. Every pair of threads
+// is linked by two single-producer single-consumer rings, one for requests
+// and one for replies. A thread keeps up to -d remote operations in flight
+// and serves its incoming rings between its own operations. A scan goes to
+// every shard. Each shard counts up to the limit from the start name in its
+// own order. The shards are disjoint, so the merged scan visits min(limit,
+// sum of the counts), as with the two halves of the adaptive backend.
+//
+// One run is made per shard count in -s, and each is compared with the first.
+// The run with one shard has no messages at all: it is the single store
+// running on a single core.
+
+#define MAX_SHARDS 64
+#define MAX_SCAN_DEFAULT 100
+#define ISSUE_BATCH 32      // own operations started between polls of the rings
+#define IDLE_SPINS 64       // empty polls before the thread yields its core
+
+enum { MIX_READ, MIX_UPDATE, MIX_INSERT, MIX_DELETE, MIX_SCAN, NUM_MIX };
+
+typedef struct {
+    int op;                 // MIX_*
+    int tag;                // sender's in-flight slot
+    int limit;              // scan length
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+} Request;
+
+typedef struct {
+    int tag;
+    int result;             // 1 found or changed, or the scan count
+} Reply;
+
+// Single producer, single consumer. The counters only grow. Each index is
+// written by one side and sits on its own cache line, so the two threads only
+// share a line when one of them reads the other's index.
+typedef struct {
+    _Atomic unsigned long head __attribute__((aligned(64)));   // next to read, written by the consumer
+    _Atomic unsigned long tail __attribute__((aligned(64)));   // next to write, written by the producer
+    unsigned long mask __attribute__((aligned(64)));
+    void* slots;
+} Ring;
+
+typedef struct {
+    long long startNs;
+    int parts;              // replies still to come
+    int limit;
+    long sum;
+} Pending;
+
+typedef struct {
+    int id;
+    pthread_t thread;
+    long long quota, issued, completed, misses, remote, nextInsert;
+    unsigned long long rng;
+    Pending* pending;
+    int* freeTags;
+    int freeCount;
+    unsigned int* latencies;
+    int done;
+} Shard;
+
+static const Backend* backend;
+static int numShards, depth = 32, maxScan = MAX_SCAN_DEFAULT, numCpus;
+static int mix[NUM_MIX] = {90, 5, 3, 2, 0};
+static long long records = 1000000, totalOps = 2000000;
+static Shard shards[MAX_SHARDS];
+static Ring requests[MAX_SHARDS][MAX_SHARDS];   // [from][to]
+static Ring replies[MAX_SHARDS][MAX_SHARDS];    // [from owner][to client]
+static pthread_barrier_t startLine;
+static _Atomic int finished;
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compareUInt(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(unsigned int* sorted, long count, double p) {
+    long i = (long)ceil(p * count) - 1;
+    if (i < 0) i = 0;
+    return sorted[i] / 1000.0;
+}
+
+// ---------------- Keys and Routing ----------------
+static unsigned long long nextRandom(Shard* s) {
+    s->rng ^= s->rng << 13;
+    s->rng ^= s->rng >> 7;
+    s->rng ^= s->rng << 17;
+    return s->rng;
+}
+
+static unsigned long long fnv64(unsigned long long v) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i = 0; i < 8; i++) {
+        h ^= v & 0xff;
+        h *= 1099511628211ULL;
+        v >>= 8;
+    }
+    return h;
+}
+
+// Key for record i, as in workload.c
+static void buildKey(long long i, char* out) {
+    snprintf(out, NAME_LEN, "user%llu", fnv64((unsigned long long)i));
+}
+
+// FNV-1a with a final mix, so the shard does not follow the low bits the
+// hash map uses for its own buckets
+static int shardOf(const char* name) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (; *name; name++) {
+        h ^= (unsigned char)*name;
+        h *= 1099511628211ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (int)(h % (unsigned long long)numShards);
+}
+
+// ---------------- Rings ----------------
+static void ringInit(Ring* r, int capacity, size_t slotSize) {
+    unsigned long n = 1;
+    while (n < (unsigned long)capacity) n <<= 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->mask = n - 1;
+    r->slots = malloc(n * slotSize);
+}
+
+// Rings are sized for every message that can be in flight, so a push
+// never finds one full
+static void* ringSlotToWrite(Ring* r, size_t slotSize) {
+    unsigned long t = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    if (t - atomic_load_explicit(&r->head, memory_order_acquire) > r->mask) {
+        printf("Ring overflow\n");
+        exit(1);
+    }
+    return (char*)r->slots + (t & r->mask) * slotSize;
+}
+
+static void ringPublish(Ring* r) {
+    atomic_store_explicit(&r->tail, atomic_load_explicit(&r->tail, memory_order_relaxed) + 1, memory_order_release);
+}
+
+// ---------------- Operations ----------------
+static int execute(const Request* q) {
+    switch (q->op) {
+        case MIX_READ:   return backend->search((char*)q->name);
+        case MIX_UPDATE: return backend->update((char*)q->name, (char*)q->phone, (char*)q->email);
+        case MIX_INSERT: return backend->insert((char*)q->name, (char*)q->phone, (char*)q->email) == 1;
+        case MIX_DELETE: return backend->remove((char*)q->name);
+        case MIX_SCAN:   return backend->scan((char*)q->name, q->limit);
+    }
+    return 0;
+}
+
+static void complete(Shard* s, int tag, long long now) {
+    Pending* p = &s->pending[tag];
+    int hit = p->limit > 0 ? p->sum > 0 : p->sum;
+    if (!hit) s->misses++;
+    s->latencies[s->completed++] = (unsigned int)(now - p->startNs);
+    s->freeTags[s->freeCount++] = tag;
+}
+
+// Answer every request waiting from the other shards
+static int serveRequests(Shard* s) {
+    int served = 0;
+    for (int from = 0; from < numShards; from++) {
+        if (from == s->id) continue;
+        Ring* in = &requests[from][s->id];
+        unsigned long h = atomic_load_explicit(&in->head, memory_order_relaxed);
+        unsigned long t = atomic_load_explicit(&in->tail, memory_order_acquire);
+        if (h == t) continue;
+        Ring* out = &replies[s->id][from];
+        // The request's slot is released before its reply is published: the
+        // reply frees a tag, and the client may reuse it for a new request at once
+        for (; h != t; h++) {
+            Request* q = (Request*)in->slots + (h & in->mask);
+            Reply* r = (Reply*)ringSlotToWrite(out, sizeof(Reply));
+            r->tag = q->tag;
+            r->result = execute(q);
+            atomic_store_explicit(&in->head, h + 1, memory_order_release);
+            ringPublish(out);
+            served++;
+        }
+    }
+    return served;
+}
+
+static int collectReplies(Shard* s) {
+    int collected = 0;
+    long long now = 0;
+    for (int from = 0; from < numShards; from++) {
+        if (from == s->id) continue;
+        Ring* in = &replies[from][s->id];
+        unsigned long h = atomic_load_explicit(&in->head, memory_order_relaxed);
+        unsigned long t = atomic_load_explicit(&in->tail, memory_order_acquire);
+        if (h == t) continue;
+        if (!now) now = nowNs();
+        for (; h != t; h++) {
+            Reply* r = (Reply*)in->slots + (h & in->mask);
+            Pending* p = &s->pending[r->tag];
+            p->sum += r->result;
+            if (--p->parts == 0) {
+                if (p->limit > 0 && p->sum > p->limit) p->sum = p->limit;
+                complete(s, r->tag, now);
+            }
+            collected++;
+        }
+        atomic_store_explicit(&in->head, h, memory_order_release);
+    }
+    return collected;
+}
+
+static void sendRequest(Shard* s, int to, const Request* q) {
+    Request* slot = (Request*)ringSlotToWrite(&requests[s->id][to], sizeof(Request));
+    *slot = *q;
+    ringPublish(&requests[s->id][to]);
+}
+
+// Start one of this thread's own operations; local ones finish at once
+static void issue(Shard* s) {
+    Request q;
+    int roll = (int)(nextRandom(s) % 100), op = 0;
+    for (int acc = mix[0]; roll >= acc; acc += mix[++op]) {}
+    q.op = op;
+    q.limit = op == MIX_SCAN ? 1 + (int)(nextRandom(s) % maxScan) : 0;
+    if (op == MIX_INSERT) buildKey(s->nextInsert++, q.name);
+    else buildKey((long long)(nextRandom(s) % records), q.name);
+    strcpy(q.phone, "5551234567");
+    strcpy(q.email, "shard@test.com");
+
+    q.tag = s->freeTags[--s->freeCount];
+    Pending* p = &s->pending[q.tag];
+    p->startNs = nowNs();
+    p->limit = q.limit;
+    p->sum = 0;
+    s->issued++;
+    if (op == MIX_SCAN) {
+        // Fan out to every other shard, then count the local part
+        p->parts = numShards - 1;
+        for (int to = 0; to < numShards; to++)
+            if (to != s->id) sendRequest(s, to, &q);
+        p->sum = execute(&q);
+        if (numShards > 1) {
+            s->remote++;
+            return;
+        }
+        if (p->sum > p->limit) p->sum = p->limit;
+        complete(s, q.tag, nowNs());
+        return;
+    }
+    int owner = shardOf(q.name);
+    if (owner == s->id) {
+        p->sum = execute(&q);
+        complete(s, q.tag, nowNs());
+        return;
+    }
+    p->parts = 1;
+    s->remote++;
+    sendRequest(s, owner, &q);
+}
+
+// ---------------- Shard Threads ----------------
+static void* shardMain(void* arg) {
+    Shard* s = (Shard*)arg;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(s->id % numCpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+    // The store is built by its own thread, so its memory is first touched there
+    long long share = records / numShards + 1;
+    backend->init((int)(share + s->quota * mix[MIX_INSERT] / 100 + 1));
+    char key[NAME_LEN];
+    for (long long i = 0; i < records; i++) {
+        buildKey(i, key);
+        if (shardOf(key) == s->id) backend->insert(key, "5550000000", "load@test.com");
+    }
+    pthread_barrier_wait(&startLine);
+    pthread_barrier_wait(&startLine);   // main thread starts the clock between the two
+
+    int idle = 0;
+    for (;;) {
+        int progress = serveRequests(s) + collectReplies(s);
+        for (int k = 0; k < ISSUE_BATCH && s->issued < s->quota && s->freeCount > 0; k++) {
+            issue(s);
+            progress++;
+        }
+        if (!s->done && s->completed == s->quota) {
+            s->done = 1;
+            atomic_fetch_add(&finished, 1);
+        }
+        // Keep serving until every shard has its own answers
+        if (s->done && atomic_load(&finished) == numShards) break;
+        if (progress) idle = 0;
+        else if (++idle == IDLE_SPINS) {
+            sched_yield();
+            idle = 0;
+        }
+    }
+    pthread_barrier_wait(&startLine);   // all shards stop before any store is freed
+    backend->destroy();
+    return NULL;
+}
+
+static void runShards(FILE* fp, int n, double* baseline) {
+    numShards = n;
+    atomic_store(&finished, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            ringInit(&requests[i][j], depth, sizeof(Request));
+            ringInit(&replies[i][j], depth, sizeof(Reply));
+        }
+    }
+    pthread_barrier_init(&startLine, NULL, n + 1);
+    for (int i = 0; i < n; i++) {
+        Shard* s = &shards[i];
+        memset(s, 0, sizeof(Shard));
+        s->id = i;
+        s->quota = totalOps / n + (i < totalOps % n);
+        s->rng = 88172645463325252ULL + 0x9E3779B97F4A7C15ULL * (i + 1);
+        s->nextInsert = records + (long long)i * totalOps;
+        s->pending = (Pending*)malloc(depth * sizeof(Pending));
+        s->freeTags = (int*)malloc(depth * sizeof(int));
+        for (int t = 0; t < depth; t++) s->freeTags[t] = t;
+        s->freeCount = depth;
+        s->latencies = (unsigned int*)malloc(s->quota * sizeof(unsigned int));
+        pthread_create(&s->thread, NULL, shardMain, s);
+    }
+    pthread_barrier_wait(&startLine);   // every shard loaded
+    long long start = nowNs();
+    pthread_barrier_wait(&startLine);
+    pthread_barrier_wait(&startLine);   // every shard finished
+    double ms = (nowNs() - start) / 1e6;
+    for (int i = 0; i < n; i++) pthread_join(shards[i].thread, NULL);
+    pthread_barrier_destroy(&startLine);
+
+    long long ops = 0, misses = 0, remote = 0;
+    unsigned int* all = (unsigned int*)malloc(totalOps * sizeof(unsigned int));
+    for (int i = 0; i < n; i++) {
+        Shard* s = &shards[i];
+        memcpy(all + ops, s->latencies, s->completed * sizeof(unsigned int));
+        ops += s->completed;
+        misses += s->misses;
+        remote += s->remote;
+        free(s->pending);
+        free(s->freeTags);
+        free(s->latencies);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (i == j) continue;
+            free(requests[i][j].slots);
+            free(replies[i][j].slots);
+        }
+    }
+    qsort(all, ops, sizeof(unsigned int), compareUInt);
+    double sum = 0;
+    for (long long i = 0; i < ops; i++) sum += all[i];
+    double throughput = ops / (ms / 1000.0);
+    if (*baseline == 0) *baseline = throughput;
+    int cores = n < numCpus ? n : numCpus;
+    fprintf(fp, "%s,%d,%d,%lld,%.3f,%.0f,%.2f,%.1f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld\n", backend->name, n, cores, ops, ms,
+            throughput, throughput / *baseline, 100.0 * remote / ops, sum / ops / 1000.0,
+            percentileUs(all, ops, 0.50), percentileUs(all, ops, 0.99), percentileUs(all, ops, 0.999),
+            all[ops - 1] / 1000.0, misses);
+    printf("  %2d shards on %2d cores %11.0f ops/s  x%5.2f  remote %5.1f%%  p50 %8.3f us  p99 %9.3f us  p99.9 %9.3f us\n",
+           n, cores, throughput, throughput / *baseline, 100.0 * remote / ops, percentileUs(all, ops, 0.50),
+           percentileUs(all, ops, 0.99), percentileUs(all, ops, 0.999));
+    fflush(fp);
+    free(all);
+}
+
+// Comma-separated positive integers into out; returns how many
+static int parseList(const char* s, int* out, int max) {
+    int n = 0;
+    while (*s && n < max) {
+        out[n] = atoi(s);
+        if (out[n] < 1) return 0;
+        n++;
+        s = strchr(s, ',');
+        if (!s) break;
+        s++;
+    }
+    return n;
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  -b NAME       Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo or Adaptive (default HashMap)\n");
+    printf("  -s LIST       shard counts to run, e.g. 1,2,4,8 (default 1, 2, 4... up to the online cores)\n");
+    printf("  -n N          records loaded before each run (default 1000000)\n");
+    printf("  -o N          operations per run, split over the shards (default 2000000)\n");
+    printf("  -m R,U,I,D,S  mix in percent: read,update,insert,delete,scan (default 90,5,3,2,0)\n");
+    printf("  -l N          maximum scan length (default %d)\n", MAX_SCAN_DEFAULT);
+    printf("  -d N          remote operations in flight per shard (default 32)\n");
+    printf("  -f FILE       output CSV (default performance_shard.csv)\n");
+    printf("  -a            append to the CSV, to collect several backends in one file\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "HashMap";
+    const char* csvFile = "performance_shard.csv";
+    int shardList[32], numRuns = 0, append = 0;
+    int opt;
+    numCpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (numCpus < 1) numCpus = 1;
+
+    while ((opt = getopt(argc, argv, "b:s:n:o:m:l:d:f:ah")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 's': numRuns = parseList(optarg, shardList, 32); if (numRuns == 0) numRuns = -1; break;
+            case 'n': records = atoll(optarg); break;
+            case 'o': totalOps = atoll(optarg); break;
+            case 'm':
+                if (sscanf(optarg, "%d,%d,%d,%d,%d", &mix[0], &mix[1], &mix[2], &mix[3], &mix[4]) != 5 ||
+                    mix[0] + mix[1] + mix[2] + mix[3] + mix[4] != 100) {
+                    printf("The mix needs five percentages summing to 100\n");
+                    return 1;
+                }
+                break;
+            case 'l': maxScan = atoi(optarg); break;
+            case 'd': depth = atoi(optarg); break;
+            case 'f': csvFile = optarg; break;
+            case 'a': append = 1; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc || numRuns < 0 || records < 1 || totalOps < 1 || maxScan < 1 || depth < 1) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (numRuns == 0) {
+        for (int n = 1; n < numCpus && n < MAX_SHARDS; n *= 2) shardList[numRuns++] = n;
+        shardList[numRuns++] = numCpus < MAX_SHARDS ? numCpus : MAX_SHARDS;
+    }
+    for (int i = 0; i < numRuns; i++) {
+        if (shardList[i] > MAX_SHARDS) {
+            printf("At most %d shards\n", MAX_SHARDS);
+            return 1;
+        }
+    }
+    if ((backend = findBackend(backendName)) == NULL) {
+        printf("Unknown backend %s\n", backendName);
+        return 1;
+    }
+    if (mix[MIX_SCAN] > 0 && backend->scan == NULL) {
+        printf("%s: scans need an ordered backend\n", backend->name);
+        return 1;
+    }
+
+    FILE* fp = fopen(csvFile, append ? "a" : "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", csvFile);
+        return 1;
+    }
+    if (ftell(fp) == 0) {
+        fprintf(fp, "DataStructure,Shards,Cores,Ops,Time_ms,Throughput_ops_s,Speedup,Remote_pct,"
+                    "Avg_us,P50_us,P99_us,P999_us,Max_us,Misses\n");
+    }
+
+    printf("%s, %lld records, %lld operations per run, %d online cores\n", backend->name, records, totalOps, numCpus);
+    double baseline = 0;
+    for (int i = 0; i < numRuns; i++) runShards(fp, shardList[i], &baseline);
+    fclose(fp);
+    printf("Shard results written to %s\n", csvFile);
+    return 0;
+}
@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "trace.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+#define MAX_LEVEL 24      // enough for ~16M contacts with p = 1/2
+#define POOL_CHUNK 256    // towers carved from one slab at a time
+
+// Contact node for Skip List. The tower of forward pointers is stored inline
+// after the contact fields, so a node of height h is a single allocation.
+// Towers are only ever linked bottom-up and unlinked top-down, and a node is
+// marked deleted before it is unlinked, which is the order a lock-free
+// version (CAS on next[i]) would need.
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    int level;               // number of forward pointers in the tower
+    int deleted;             // logical delete mark, set before unlinking
+    struct Contact* next[];  // next[0] is the full ordered list
+} Contact;
+
+// Slab of equally sized towers, kept so everything can be released at exit
+typedef struct Slab {
+    struct Slab* nextSlab;
+    char data[];
+} Slab;
+
+Contact* head = NULL;                 // sentinel with a full-height tower
+int listLevel = 1;                    // levels currently in use
+Contact* freeTowers[MAX_LEVEL + 1];   // one free list per tower height
+Slab* slabs = NULL;
+Contact* finger[MAX_LEVEL];           // predecessors from the last operation
+char fingerName[NAME_LEN];
+int fingerValid = 0;
+unsigned int levelSeed = 2463534242u;
+
+// Size in bytes of a node with a tower of the given height
+size_t towerSize(int level) {
+    return sizeof(Contact) + level * sizeof(Contact*);
+}
+
+// Take a tower of the given height from its pool, refilling with a new slab
+Contact* allocTower(int level) {
+    if (freeTowers[level] == NULL) {
+        size_t size = towerSize(level);
+        Slab* slab = (Slab*)malloc(sizeof(Slab) + size * POOL_CHUNK);
+        slab->nextSlab = slabs;
+        slabs = slab;
+        for (int i = POOL_CHUNK - 1; i >= 0; i--) {
+            Contact* c = (Contact*)(slab->data + i * size);
+            c->next[0] = freeTowers[level];
+            freeTowers[level] = c;
+        }
+    }
+    Contact* c = freeTowers[level];
+    freeTowers[level] = c->next[0];
+    return c;
+}
+
+// Return a tower to the pool of its height
+void freeTower(Contact* c) {
+    c->next[0] = freeTowers[c->level];
+    freeTowers[c->level] = c;
+}
+
+// Random tower height with p = 1/2 (xorshift32, no shared rand() state)
+int randomLevel() {
+    unsigned int x = levelSeed;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    levelSeed = x;
+    int level = 1;
+    while ((x & 1) && level < MAX_LEVEL) {
+        level++;
+        x >>= 1;
+    }
+    return level;
+}
+
+// Create the sentinel head node
+void initList() {
+    head = allocTower(MAX_LEVEL);
+    head->name[0] = '\0';
+    head->level = MAX_LEVEL;
+    head->deleted = 0;
+    for (int i = 0; i < MAX_LEVEL; i++) head->next[i] = NULL;
+    listLevel = 1;
+    fingerValid = 0;
+}
+
+// Create new contact node with a tower of the given height
+Contact* createContact(char* name, char* phone, char* email, int level) {
+    Contact* newContact = allocTower(level);
+    strcpy(newContact->name, name);
+    strcpy(newContact->phone, phone);
+    strcpy(newContact->email, email);
+    newContact->level = level;
+    newContact->deleted = 0;
+    for (int i = 0; i < level; i++) newContact->next[i] = NULL;
+    return newContact;
+}
+
+// Fill update[] with the last node before name on every level. When the key
+// is past the previous one, the search resumes from the saved finger instead
+// of the head, so sequential access costs O(log d) for a distance d.
+void findPredecessors(char* name, Contact** update) {
+    Contact* x = head;
+    int top = listLevel - 1;
+
+    if (fingerValid && strcmp(name, fingerName) > 0) {
+        int lvl = 0;
+        while (lvl + 1 < listLevel && finger[lvl + 1]->next[lvl + 1] != NULL &&
+               strcmp(finger[lvl + 1]->next[lvl + 1]->name, name) < 0)
+            lvl++;
+        for (int i = listLevel - 1; i > lvl; i--) update[i] = finger[i];
+        x = finger[lvl];
+        top = lvl;
+    }
+
+    for (int i = top; i >= 0; i--) {
+        while (x->next[i] != NULL && strcmp(x->next[i]->name, name) < 0)
+            x = x->next[i];
+        update[i] = x;
+    }
+
+    for (int i = 0; i < listLevel; i++) finger[i] = update[i];
+    strcpy(fingerName, name);
+    fingerValid = 1;
+}
+
+// Find a contact or insert it, in one search; *created tells which
+Contact* insertIfAbsent(char* name, char* phone, char* email, int* created) {
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name, update);
+
+    *created = 0;
+    Contact* x = update[0]->next[0];
+    if (x != NULL && strcmp(x->name, name) == 0) return x;
+
+    int level = randomLevel();
+    if (level > listLevel) {
+        for (int i = listLevel; i < level; i++) {
+            update[i] = head;
+            finger[i] = head;
+        }
+        listLevel = level;
+    }
+
+    // Link bottom-up: once next[0] is published the contact is reachable
+    Contact* newContact = createContact(name, phone, email, level);
+    for (int i = 0; i < level; i++) {
+        newContact->next[i] = update[i]->next[i];
+        update[i]->next[i] = newContact;
+    }
+    *created = 1;
+    return newContact;
+}
+
+// Insert contact
+void insertContact(char* name, char* phone, char* email) {
+    int created;
+    insertIfAbsent(name, phone, email, &created);
+    if (created)
+        printf("Contact added: %s\n", name);
+    else
+        printf("Contact already exists!\n");
+}
+
+// Insert a contact or overwrite an existing one, in one search
+Contact* upsertContact(char* name, char* phone, char* email) {
+    int created;
+    Contact* c = insertIfAbsent(name, phone, email, &created);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    printf("Contact saved: %s\n", name);
+    return c;
+}
+
+// Search by name
+Contact* searchContact(char* name) {
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name, update);
+    Contact* x = update[0]->next[0];
+    if (x != NULL && !x->deleted && strcmp(x->name, name) == 0) return x;
+    return NULL;
+}
+
+// Update contact
+void updateContact(char* name, char* newPhone, char* newEmail) {
+    Contact* c = searchContact(name);
+    if (c == NULL) {
+        printf("Contact not found.\n");
+        return;
+    }
+    if (newPhone != NULL) strcpy(c->phone, newPhone);
+    if (newEmail != NULL) strcpy(c->email, newEmail);
+    printf("Contact updated: %s\n", name);
+}
+
+// Delete contact
+void deleteContact(char* name) {
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name, update);
+
+    Contact* x = update[0]->next[0];
+    if (x == NULL || strcmp(x->name, name) != 0) {
+        printf("Contact not found.\n");
+        return;
+    }
+
+    // Mark first, then unlink top-down so lower levels stay a superset
+    x->deleted = 1;
+    for (int i = x->level - 1; i >= 0; i--)
+        if (update[i]->next[i] == x) update[i]->next[i] = x->next[i];
+    while (listLevel > 1 && head->next[listLevel - 1] == NULL) listLevel--;
+
+    fingerValid = 0;  // the finger may point at the freed tower
+    freeTower(x);
+    printf("Contact deleted: %s\n", name);
+}
+
+// Display contacts (level 0 is already sorted)
+void displayContacts() {
+    for (Contact* x = head->next[0]; x != NULL; x = x->next[0])
+        printf("Name: %s | Phone: %s | Email: %s\n", x->name, x->phone, x->email);
+}
+
+// Display contacts with from <= name <= to, in order
+void displayRange(char* from, char* to) {
+    Contact* update[MAX_LEVEL];
+    findPredecessors(from, update);
+    int count = 0;
+    for (Contact* x = update[0]->next[0]; x != NULL && strcmp(x->name, to) <= 0; x = x->next[0]) {
+        printf("Name: %s | Phone: %s | Email: %s\n", x->name, x->phone, x->email);
+        count++;
+    }
+    if (count == 0) printf("No contacts in range.\n");
+}
+
+// Free memory (towers live in slabs, so release the slabs)
+void freeContacts() {
+    while (slabs != NULL) {
+        Slab* next = slabs->nextSlab;
+        free(slabs);
+        slabs = next;
+    }
+    for (int i = 0; i <= MAX_LEVEL; i++) freeTowers[i] = NULL;
+    head = NULL;
+}
+
+// Menu-driven program
+int main() {
+    int choice;
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
+    levelSeed ^= (unsigned int)time(NULL);
+    initList();
+
+    while (1) {
+        printf("\nContact Management System (Skip List)\n");
+        printf("1. Insert Contact\n");
+        printf("2. Search Contact\n");
+        printf("3. Update Contact\n");
+        printf("4. Delete Contact\n");
+        printf("5. Display All Contacts (Sorted)\n");
+        printf("6. Exit\n");
+        printf("7. Display Contacts in Range\n");
+        printf("8. Insert or Update Contact\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        getchar(); // consume newline
+
+        switch (choice) {
+            case 1:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
+                insertContact(name, phone, email);
+                break;
+            case 2:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
+                    Contact* c = searchContact(name);
+                    if (c != NULL)
+                        printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
+            case 3:
+                printf("Enter Name to Update: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter New Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter New Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
+                updateContact(name, phone, email);
+                break;
+            case 4:
+                printf("Enter Name to Delete: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
+                deleteContact(name);
+                break;
+            case 5:
+                if (head->next[0] == NULL)
+                    printf("No contacts available.\n");
+                else
+                    displayContacts();
+                break;
+            case 6:
+                freeContacts();
+                printf("Exiting...\n");
+                traceClose();
+                exit(0);
+            case 7:
+                printf("Enter First Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Last Name: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                displayRange(name, email);
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
+            default:
+                printf("Invalid choice! Try again.\n");
+        }
+    }
+    return 0;
+}
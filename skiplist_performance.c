@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "perfcount.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+#define MAX_LEVEL 24
+#define POOL_CHUNK 256
+#define RANGE_QUERIES 1000
+#define RANGE_LEN 100
+
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    int level;
+    int deleted;
+    struct Contact* next[];
+} Contact;
+
+typedef struct Slab {
+    struct Slab* nextSlab;
+    size_t bytes;
+    char data[];
+} Slab;
+
+Contact* head = NULL;
+int listLevel = 1;
+Contact* freeTowers[MAX_LEVEL + 1];
+Slab* slabs = NULL;
+Contact* finger[MAX_LEVEL];
+char fingerName[NAME_LEN];
+int fingerValid = 0;
+unsigned int levelSeed = 2463534242u;
+
+// ----------------- Tower Pool -----------------
+size_t towerSize(int level){ return sizeof(Contact) + level*sizeof(Contact*); }
+Contact* allocTower(int level){
+    if(!freeTowers[level]){
+        size_t size=towerSize(level);
+        Slab* slab=(Slab*)countedMalloc(sizeof(Slab)+size*POOL_CHUNK);
+        slab->bytes=sizeof(Slab)+size*POOL_CHUNK;
+        slab->nextSlab=slabs; slabs=slab;
+        for(int i=POOL_CHUNK-1;i>=0;i--){
+            Contact* c=(Contact*)(slab->data+i*size);
+            c->next[0]=freeTowers[level]; freeTowers[level]=c;
+        }
+    }
+    Contact* c=freeTowers[level];
+    freeTowers[level]=c->next[0];
+    return c;
+}
+void freeTower(Contact* c){ c->next[0]=freeTowers[c->level]; freeTowers[c->level]=c; }
+int randomLevel(){
+    unsigned int x=levelSeed;
+    x^=x<<13; x^=x>>17; x^=x<<5;
+    levelSeed=x;
+    int level=1;
+    while((x&1) && level<MAX_LEVEL){ level++; x>>=1; }
+    return level;
+}
+
+// ----------------- Skip List Operations -----------------
+void initList(){
+    head=allocTower(MAX_LEVEL);
+    head->name[0]='\0'; head->level=MAX_LEVEL; head->deleted=0;
+    for(int i=0;i<MAX_LEVEL;i++) head->next[i]=NULL;
+    listLevel=1; fingerValid=0;
+}
+Contact* createContact(char* name,char* phone,char* email,int level){
+    Contact* c=allocTower(level);
+    strcpy(c->name,name);
+    strcpy(c->phone,phone);
+    strcpy(c->email,email);
+    c->level=level; c->deleted=0;
+    for(int i=0;i<level;i++) c->next[i]=NULL;
+    return c;
+}
+void findPredecessors(char* name,Contact** update){
+    Contact* x=head;
+    int top=listLevel-1;
+    if(fingerValid && strcmp(name,fingerName)>0){
+        int lvl=0;
+        while(lvl+1<listLevel && finger[lvl+1]->next[lvl+1] && strcmp(finger[lvl+1]->next[lvl+1]->name,name)<0) lvl++;
+        for(int i=listLevel-1;i>lvl;i--) update[i]=finger[i];
+        x=finger[lvl]; top=lvl;
+    }
+    for(int i=top;i>=0;i--){
+        while(x->next[i] && strcmp(x->next[i]->name,name)<0) x=x->next[i];
+        update[i]=x;
+    }
+    for(int i=0;i<listLevel;i++) finger[i]=update[i];
+    strcpy(fingerName,name); fingerValid=1;
+}
+Contact* insertIfAbsent(char* name,char* phone,char* email){
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name,update);
+    Contact* x=update[0]->next[0];
+    if(x && strcmp(x->name,name)==0) return x;
+    int level=randomLevel();
+    if(level>listLevel){
+        for(int i=listLevel;i<level;i++){ update[i]=head; finger[i]=head; }
+        listLevel=level;
+    }
+    Contact* c=createContact(name,phone,email,level);
+    for(int i=0;i<level;i++){ c->next[i]=update[i]->next[i]; update[i]->next[i]=c; }
+    return c;
+}
+void insertContact(char* name,char* phone,char* email){ insertIfAbsent(name,phone,email); }
+Contact* upsertContact(char* name,char* phone,char* email){
+    Contact* c=insertIfAbsent(name,phone,email);
+    strcpy(c->phone,phone);
+    strcpy(c->email,email);
+    return c;
+}
+Contact* searchContact(char* name){
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name,update);
+    Contact* x=update[0]->next[0];
+    if(x && !x->deleted && strcmp(x->name,name)==0) return x;
+    return NULL;
+}
+void updateContact(char* name,char* phone,char* email){
+    Contact* c=searchContact(name);
+    if(!c) return;
+    if(phone) strcpy(c->phone,phone);
+    if(email) strcpy(c->email,email);
+}
+void deleteContact(char* name){
+    Contact* update[MAX_LEVEL];
+    findPredecessors(name,update);
+    Contact* x=update[0]->next[0];
+    if(!x || strcmp(x->name,name)!=0) return;
+    x->deleted=1;
+    for(int i=x->level-1;i>=0;i--) if(update[i]->next[i]==x) update[i]->next[i]=x->next[i];
+    while(listLevel>1 && !head->next[listLevel-1]) listLevel--;
+    fingerValid=0;
+    freeTower(x);
+}
+// Visit up to limit contacts with name >= from; returns how many were visited
+int rangeContacts(char* from,int limit){
+    Contact* update[MAX_LEVEL];
+    findPredecessors(from,update);
+    int count=0;
+    for(Contact* x=update[0]->next[0]; x && count<limit; x=x->next[0]) count++;
+    return count;
+}
+void freeContacts(){
+    while(slabs){ Slab* next=slabs->nextSlab; countedFree(slabs,slabs->bytes); slabs=next; }
+    for(int i=0;i<=MAX_LEVEL;i++) freeTowers[i]=NULL;
+    head=NULL;
+}
+void displayContacts(){ for(Contact* x=head->next[0];x;x=x->next[0]) printf("Name:%s|Phone:%s|Email:%s\n",x->name,x->phone,x->email); }
+
+// ----------------- Random Data -----------------
+void randomString(char* str,int len){
+    static const char charset[]="abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for(int i=0;i<len-1;i++) str[i]=charset[rand()%(sizeof(charset)-1)];
+    str[len-1]='\0';
+}
+typedef struct { char name[NAME_LEN]; char phone[PHONE_LEN]; char email[EMAIL_LEN]; } ContactData;
+ContactData generateContact(){
+    ContactData c; randomString(c.name,10); randomString(c.phone,10); randomString(c.email,15); return c;
+}
+int compareNames(const void* a,const void* b){ return strcmp(((ContactData*)a)->name,((ContactData*)b)->name); }
+
+// ---------------- Benchmark (Skip List to CSV) ----------------
+void benchmarkSkipListToCSV(const char* filename) {
+    int sizes[] = {100, 500, 1000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        resetPeakRSS();
+        freeContacts();
+        initList();
+
+        ContactData data[n];
+        Contact* stored[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        // ---------- Insert + Search (two descents) ----------
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++) {
+            insertContact(data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(data[i].name);
+        }
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "SkipList,InsertSearch", n, twoPass);
+        freeContacts();
+        initList();
+
+        // ---------- Insert (insertIfAbsent, one descent) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            stored[i] = insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "SkipList,Insert", n, onePass);
+        printf("SkipList %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
+
+        // ---------- Search ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            searchContact(stored[i]->name);
+        end = stopPhase();
+        writeResult(fp, "SkipList,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Update ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            updateContact(stored[i]->name, "1234567890", "newemail@test.com");
+        end = stopPhase();
+        writeResult(fp, "SkipList,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            upsertContact(stored[i]->name, "0987654321", "upsert@test.com");
+        end = stopPhase();
+        writeResult(fp, "SkipList,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Delete ----------
+        // Towers are recycled through the pool, so copy the name out first
+        start = startPhase();
+        for (int i = 0; i < n; i++) {
+            char name[NAME_LEN];
+            strcpy(name, stored[i]->name);
+            deleteContact(name);
+        }
+        end = stopPhase();
+        writeResult(fp, "SkipList,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+    }
+
+    fclose(fp);
+    printf("Skip List benchmark written to %s\n", filename);
+}
+
+// ---------------- Large Benchmark (ordered operations) ----------------
+// Same phases as avl_performance's large benchmark so the two CSVs line up:
+// random-order Insert/Search/Delete, SeqSearch in sorted order (finger hits),
+// and Range = RANGE_QUERIES scans of RANGE_LEN contacts from random names.
+// Results go to a volatile sink so optimised builds keep the lookups.
+volatile long sink;
+
+void benchmarkSkipListLargeToCSV(const char* filename) {
+    int sizes[] = {100000, 1000000, 10000000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        resetPeakRSS();
+        freeContacts();
+        initList();
+
+        ContactData* data = (ContactData*)malloc(n * sizeof(ContactData));
+        ContactData* sorted = (ContactData*)malloc(n * sizeof(ContactData));
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+        memcpy(sorted, data, n * sizeof(ContactData));
+        qsort(sorted, n, sizeof(ContactData), compareNames);
+
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++)
+            insertContact(data[i].name, data[i].phone, data[i].email);
+        clock_t end = stopPhase();
+        writeResult(fp, "SkipList,Insert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            sink += searchContact(data[i].name) != NULL;
+        end = stopPhase();
+        writeResult(fp, "SkipList,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            sink += searchContact(sorted[i].name) != NULL;
+        end = stopPhase();
+        writeResult(fp, "SkipList,SeqSearch", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < RANGE_QUERIES; i++)
+            sink += rangeContacts(data[rand() % n].name, RANGE_LEN);
+        end = stopPhase();
+        writeResult(fp, "SkipList,Range", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            deleteContact(data[i].name);
+        end = stopPhase();
+        writeResult(fp, "SkipList,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        free(data);
+        free(sorted);
+    }
+
+    fclose(fp);
+    printf("Skip List large benchmark written to %s\n", filename);
+}
+
+
+// ----------------- Main Menu -----------------
+int main(int argc,char** argv){
+    int choice; char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN]; srand(time(NULL));
+    levelSeed^=(unsigned int)time(NULL);
+    initList();
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if(argc>1 && strcmp(argv[1],"--bench")==0){ benchmarkSkipListToCSV(argc>2?argv[2]:"performance_skiplist.csv"); return 0; }
+    while(1){
+        printf("\nContact Management System (Skip List)\n1.Insert\n2.Search\n3.Update\n4.Delete\n5.Display\n6.Benchmark\n7.Exit\n8.Large Benchmark\nEnter choice:");
+        scanf("%d",&choice); getchar();
+        switch(choice){
+            case 1: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    printf("Phone: "); fgets(phone,PHONE_LEN,stdin); phone[strcspn(phone,"\n")]=0;
+                    printf("Email: "); fgets(email,EMAIL_LEN,stdin); email[strcspn(email,"\n")]=0;
+                    insertContact(name,phone,email); break;
+            case 2: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    { Contact* c=searchContact(name); if(c) printf("Found:%s|%s|%s\n",c->name,c->phone,c->email); else printf("Not found\n");} break;
+            case 3: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    printf("Phone: "); fgets(phone,PHONE_LEN,stdin); phone[strcspn(phone,"\n")]=0;
+                    printf("Email: "); fgets(email,EMAIL_LEN,stdin); email[strcspn(email,"\n")]=0;
+                    updateContact(name,phone,email); break;
+            case 4: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    deleteContact(name); break;
+            case 5: if(!head->next[0]) printf("No contacts.\n"); else displayContacts(); break;
+            case 6: benchmarkSkipListToCSV("performance_skiplist.csv"); freeContacts(); initList(); break;
+            case 7: freeContacts(); exit(0);
+            case 8: benchmarkSkipListLargeToCSV("performance_skiplist_large.csv"); freeContacts(); initList(); break;
+            default: printf("Invalid choice\n");
+        }
+    }
+}
@@ -0,0 +1,305 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+
+// Contact node for Splay Tree. Every access splays the contact (or the last
+// node on its search path) to the root, so recently used contacts are found
+// near the top without a separate cache. Splaying is top-down (Sleator and
+// Tarjan's simple version): one pass, no recursion and no parent pointers.
+// A splay tree can be arbitrarily deep in between, e.g. after inserting
+// names in sorted order, so nothing here recurses on the tree.
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct Contact* left;
+    struct Contact* right;
+} Contact;
+
+Contact* root = NULL;
+
+// Create new contact node
+Contact* createContact(char* name, char* phone, char* email) {
+    Contact* newContact = (Contact*)malloc(sizeof(Contact));
+    strcpy(newContact->name, name);
+    strcpy(newContact->phone, phone);
+    strcpy(newContact->email, email);
+    newContact->left = newContact->right = NULL;
+    return newContact;
+}
+
+// Top-down splay: returns the new root, which is name's contact if present,
+// else the last contact on its search path. Nodes left of the path are
+// hung off a left tree, those right of it off a right tree, and the two are
+// reassembled under the final node.
+Contact* splay(Contact* t, const char* name) {
+    Contact header;
+    Contact* leftMax = &header;    // largest node of the left tree
+    Contact* rightMin = &header;   // smallest node of the right tree
+    if (t == NULL) return NULL;
+    header.left = header.right = NULL;
+
+    while (1) {
+        int cmp = strcmp(name, t->name);
+        if (cmp < 0) {
+            if (t->left == NULL) break;
+            if (strcmp(name, t->left->name) < 0) {   // zig-zig: rotate right
+                Contact* y = t->left;
+                t->left = y->right;
+                y->right = t;
+                t = y;
+                if (t->left == NULL) break;
+            }
+            rightMin->left = t;   // link right
+            rightMin = t;
+            t = t->left;
+        } else if (cmp > 0) {
+            if (t->right == NULL) break;
+            if (strcmp(name, t->right->name) > 0) {  // zag-zag: rotate left
+                Contact* y = t->right;
+                t->right = y->left;
+                y->left = t;
+                t = y;
+                if (t->right == NULL) break;
+            }
+            leftMax->right = t;   // link left
+            leftMax = t;
+            t = t->right;
+        } else {
+            break;
+        }
+    }
+    leftMax->right = t->left;
+    rightMin->left = t->right;
+    t->left = header.right;
+    t->right = header.left;
+    return t;
+}
+
+// Find a contact or insert it; *created tells which
+Contact* insertIfAbsent(char* name, char* phone, char* email, int* created) {
+    *created = 0;
+    root = splay(root, name);
+    if (root != NULL) {
+        int cmp = strcmp(name, root->name);
+        if (cmp == 0) return root;
+        // The new contact becomes the root, splitting the old one's subtrees
+        Contact* c = createContact(name, phone, email);
+        if (cmp < 0) {
+            c->left = root->left;
+            c->right = root;
+            root->left = NULL;
+        } else {
+            c->right = root->right;
+            c->left = root;
+            root->right = NULL;
+        }
+        root = c;
+    } else {
+        root = createContact(name, phone, email);
+    }
+    *created = 1;
+    return root;
+}
+
+// Insert contact
+void insertContact(char* name, char* phone, char* email) {
+    int created;
+    insertIfAbsent(name, phone, email, &created);
+    if (created)
+        printf("Contact added: %s\n", name);
+    else
+        printf("Contact already exists!\n");
+}
+
+// Insert a contact or overwrite an existing one, in one splay
+Contact* upsertContact(char* name, char* phone, char* email) {
+    int created;
+    Contact* c = insertIfAbsent(name, phone, email, &created);
+    strcpy(c->phone, phone);
+    strcpy(c->email, email);
+    printf("Contact saved: %s\n", name);
+    return c;
+}
+
+// Search by name; a hit is left at the root
+Contact* searchContact(char* name) {
+    root = splay(root, name);
+    if (root != NULL && strcmp(root->name, name) == 0) return root;
+    return NULL;
+}
+
+// Update contact
+void updateContact(char* name, char* newPhone, char* newEmail) {
+    Contact* c = searchContact(name);
+    if (c == NULL) {
+        printf("Contact not found.\n");
+        return;
+    }
+    if (newPhone != NULL) strcpy(c->phone, newPhone);
+    if (newEmail != NULL) strcpy(c->email, newEmail);
+    printf("Contact updated: %s\n", name);
+}
+
+// Delete contact: splay it to the root, then join its subtrees by splaying
+// the largest contact of the left one up (it has no right child)
+void deleteContact(char* name) {
+    Contact* c = searchContact(name);
+    if (c == NULL) {
+        printf("Contact not found.\n");
+        return;
+    }
+    if (c->left == NULL) {
+        root = c->right;
+    } else {
+        root = splay(c->left, name);
+        root->right = c->right;
+    }
+    free(c);
+    printf("Contact deleted: %s\n", name);
+}
+
+// Display contacts in order (Morris traversal: threads through empty right
+// pointers instead of a stack, and removes them again on the way)
+void displayContacts() {
+    Contact* node = root;
+    while (node != NULL) {
+        if (node->left == NULL) {
+            printf("Name: %s | Phone: %s | Email: %s\n", node->name, node->phone, node->email);
+            node = node->right;
+            continue;
+        }
+        Contact* pred = node->left;
+        while (pred->right != NULL && pred->right != node) pred = pred->right;
+        if (pred->right == NULL) {
+            pred->right = node;
+            node = node->left;
+        } else {
+            pred->right = NULL;
+            printf("Name: %s | Phone: %s | Email: %s\n", node->name, node->phone, node->email);
+            node = node->right;
+        }
+    }
+}
+
+// Depth of the contact at the root's left and right extremes, for the menu
+void displayShape() {
+    int leftDepth = 0, rightDepth = 0;
+    for (Contact* c = root; c != NULL; c = c->left) leftDepth++;
+    for (Contact* c = root; c != NULL; c = c->right) rightDepth++;
+    if (root == NULL) printf("No contacts available.\n");
+    else printf("Root: %s | leftmost depth %d | rightmost depth %d\n", root->name, leftDepth, rightDepth);
+}
+
+// Free memory: rotate left children up until the tree is a list, no stack
+void freeContacts() {
+    Contact* node = root;
+    while (node != NULL) {
+        if (node->left != NULL) {
+            Contact* l = node->left;
+            node->left = l->right;
+            l->right = node;
+            node = l;
+        } else {
+            Contact* next = node->right;
+            free(node);
+            node = next;
+        }
+    }
+    root = NULL;
+}
+
+// Menu-driven program
+int main() {
+    int choice;
+    char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN];
+    traceOpenFromEnv();
+
+    while (1) {
+        printf("\nContact Management System (Splay Tree)\n");
+        printf("1. Insert Contact\n");
+        printf("2. Search Contact\n");
+        printf("3. Update Contact\n");
+        printf("4. Delete Contact\n");
+        printf("5. Display All Contacts (Sorted)\n");
+        printf("6. Exit\n");
+        printf("7. Show Root and Depth\n");
+        printf("8. Insert or Update Contact\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        getchar(); // consume newline
+
+        switch (choice) {
+            case 1:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_INSERT, name, phone, email, 0);
+                insertContact(name, phone, email);
+                break;
+            case 2:
+                printf("Enter Name to Search: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                {
+                    traceRecord(TRACE_SEARCH, name, NULL, NULL, 0);
+                    Contact* c = searchContact(name);
+                    if (c != NULL)
+                        printf("Found: %s | Phone: %s | Email: %s\n", c->name, c->phone, c->email);
+                    else
+                        printf("Contact not found.\n");
+                }
+                break;
+            case 3:
+                printf("Enter Name to Update: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter New Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter New Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPDATE, name, phone, email, 0);
+                updateContact(name, phone, email);
+                break;
+            case 4:
+                printf("Enter Name to Delete: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                traceRecord(TRACE_DELETE, name, NULL, NULL, 0);
+                deleteContact(name);
+                break;
+            case 5:
+                if (root == NULL)
+                    printf("No contacts available.\n");
+                else
+                    displayContacts();
+                break;
+            case 6:
+                freeContacts();
+                printf("Exiting...\n");
+                traceClose();
+                exit(0);
+            case 7:
+                displayShape();
+                break;
+            case 8:
+                printf("Enter Name: ");
+                fgets(name, NAME_LEN, stdin); name[strcspn(name, "\n")] = 0;
+                printf("Enter Phone: ");
+                fgets(phone, PHONE_LEN, stdin); phone[strcspn(phone, "\n")] = 0;
+                printf("Enter Email: ");
+                fgets(email, EMAIL_LEN, stdin); email[strcspn(email, "\n")] = 0;
+                traceRecord(TRACE_UPSERT, name, phone, email, 0);
+                upsertContact(name, phone, email);
+                break;
+            default:
+                printf("Invalid choice! Try again.\n");
+        }
+    }
+    return 0;
+}
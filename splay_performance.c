@@ -0,0 +1,349 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "perfcount.h"
+
+#define NAME_LEN 50
+#define PHONE_LEN 20
+#define EMAIL_LEN 50
+#define LOCALITY_LOOKUPS 100000
+#define BURST_WINDOW 16     // bursty lookups repeat one of the last 16 names...
+#define BURST_REPEAT 75     // ...this percentage of the time
+
+typedef struct Contact {
+    char name[NAME_LEN];
+    char phone[PHONE_LEN];
+    char email[EMAIL_LEN];
+    struct Contact* left;
+    struct Contact* right;
+} Contact;
+
+Contact* root = NULL;
+long splayNodes = 0;   // nodes passed on the way down, for the locality benchmark
+
+
+// ----------------- Splay Tree Operations -----------------
+Contact* createContact(char* name,char* phone,char* email){
+    Contact* c=(Contact*)countedMalloc(sizeof(Contact));
+    strcpy(c->name,name);
+    strcpy(c->phone,phone);
+    strcpy(c->email,email);
+    c->left=c->right=NULL;
+    return c;
+}
+// Top-down splay (see splay.c): name's contact, or the last one on its path,
+// becomes the root in one pass without recursion
+Contact* splay(Contact* t,const char* name){
+    Contact header; Contact* leftMax=&header; Contact* rightMin=&header;
+    if(!t) return NULL;
+    header.left=header.right=NULL;
+    while(1){
+        int cmp=strcmp(name,t->name);
+        splayNodes++;
+        if(cmp<0){
+            if(!t->left) break;
+            if(strcmp(name,t->left->name)<0){
+                Contact* y=t->left; t->left=y->right; y->right=t; t=y; splayNodes++;
+                if(!t->left) break;
+            }
+            rightMin->left=t; rightMin=t; t=t->left;
+        }else if(cmp>0){
+            if(!t->right) break;
+            if(strcmp(name,t->right->name)>0){
+                Contact* y=t->right; t->right=y->left; y->left=t; t=y; splayNodes++;
+                if(!t->right) break;
+            }
+            leftMax->right=t; leftMax=t; t=t->right;
+        }else break;
+    }
+    leftMax->right=t->left; rightMin->left=t->right;
+    t->left=header.right; t->right=header.left;
+    return t;
+}
+Contact* insertIfAbsent(char* name,char* phone,char* email){
+    root=splay(root,name);
+    if(!root) return root=createContact(name,phone,email);
+    int cmp=strcmp(name,root->name);
+    if(cmp==0) return root;
+    Contact* c=createContact(name,phone,email);
+    if(cmp<0){ c->left=root->left; c->right=root; root->left=NULL; }
+    else{ c->right=root->right; c->left=root; root->right=NULL; }
+    return root=c;
+}
+void insertContact(char* name,char* phone,char* email){ insertIfAbsent(name,phone,email); }
+Contact* upsertContact(char* name,char* phone,char* email){
+    Contact* c=insertIfAbsent(name,phone,email);
+    strcpy(c->phone,phone);
+    strcpy(c->email,email);
+    return c;
+}
+Contact* searchContact(char* name){
+    root=splay(root,name);
+    if(root && strcmp(root->name,name)==0) return root;
+    return NULL;
+}
+void updateContact(char* name,char* phone,char* email){
+    Contact* c=searchContact(name);
+    if(!c) return;
+    if(phone) strcpy(c->phone,phone);
+    if(email) strcpy(c->email,email);
+}
+void deleteContact(char* name){
+    Contact* c=searchContact(name);
+    if(!c) return;
+    if(!c->left) root=c->right;
+    else{ root=splay(c->left,name); root->right=c->right; }
+    countedFree(c,sizeof(Contact));
+}
+// Rotate left children up until the tree is a list, then free along it
+void freeContacts(){
+    Contact* x=root;
+    while(x){
+        if(x->left){ Contact* l=x->left; x->left=l->right; l->right=x; x=l; }
+        else{ Contact* next=x->right; countedFree(x,sizeof(Contact)); x=next; }
+    }
+    root=NULL;
+}
+// In order without a stack (Morris traversal)
+void displayContacts(){
+    Contact* x=root;
+    while(x){
+        if(!x->left){ printf("Name:%s|Phone:%s|Email:%s\n",x->name,x->phone,x->email); x=x->right; continue; }
+        Contact* p=x->left;
+        while(p->right && p->right!=x) p=p->right;
+        if(!p->right){ p->right=x; x=x->left; }
+        else{ p->right=NULL; printf("Name:%s|Phone:%s|Email:%s\n",x->name,x->phone,x->email); x=x->right; }
+    }
+}
+
+// ----------------- Random Data -----------------
+void randomString(char* str,int len){
+    static const char charset[]="abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    for(int i=0;i<len-1;i++) str[i]=charset[rand()%(sizeof(charset)-1)];
+    str[len-1]='\0';
+}
+typedef struct { char name[NAME_LEN]; char phone[PHONE_LEN]; char email[EMAIL_LEN]; } ContactData;
+ContactData generateContact(){
+    ContactData c; randomString(c.name,10); randomString(c.phone,10); randomString(c.email,15); return c;
+}
+int compareNames(const void* a,const void* b){ return strcmp(((ContactData*)a)->name,((ContactData*)b)->name); }
+
+// ---------------- Benchmark (Splay Tree to CSV) ----------------
+void benchmarkSplayToCSV(const char* filename) {
+    int sizes[] = {100, 500, 1000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fputs(RESULT_CSV_HEADER, fp);
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        resetPeakRSS();
+        freeContacts();
+
+        ContactData data[n];
+        Contact* stored[n];
+        for (int i = 0; i < n; i++) data[i] = generateContact();
+
+        // ---------- Insert + Search (two splays) ----------
+        clock_t start = startPhase();
+        for (int i = 0; i < n; i++) {
+            insertContact(data[i].name, data[i].phone, data[i].email);
+            stored[i] = searchContact(data[i].name);
+        }
+        clock_t end = stopPhase();
+        double twoPass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "Splay,InsertSearch", n, twoPass);
+        freeContacts();
+
+        // ---------- Insert (insertIfAbsent, one splay) ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            stored[i] = insertIfAbsent(data[i].name, data[i].phone, data[i].email);
+        end = stopPhase();
+        double onePass = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+        writeResult(fp, "Splay,Insert", n, onePass);
+        printf("Splay %d: insertIfAbsent saved %.3f ms over insert + search\n", n, twoPass - onePass);
+
+        // ---------- Search ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            searchContact(stored[i]->name);
+        end = stopPhase();
+        writeResult(fp, "Splay,Search", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Update ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            updateContact(stored[i]->name, "1234567890", "newemail@test.com");
+        end = stopPhase();
+        writeResult(fp, "Splay,Update", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Upsert ----------
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            upsertContact(stored[i]->name, "0987654321", "upsert@test.com");
+        end = stopPhase();
+        writeResult(fp, "Splay,Upsert", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+
+        // ---------- Delete ----------
+        // Nodes are freed as they go, so delete by the generated names
+        start = startPhase();
+        for (int i = 0; i < n; i++)
+            deleteContact(data[i].name);
+        end = stopPhase();
+        writeResult(fp, "Splay,Delete", n, ((double)(end-start))/CLOCKS_PER_SEC*1000);
+    }
+
+    fclose(fp);
+    printf("Splay tree benchmark written to %s\n", filename);
+}
+
+// ---------------- Locality Benchmark ----------------
+// LOCALITY_LOOKUPS searches over the same tree under four access patterns:
+// uniform (no locality, the splay tree's worst realistic case), Zipf (s = 1,
+// hot names shuffled through the tree as in the front cache benchmark),
+// bursty (BURST_REPEAT% of lookups repeat one of the last BURST_WINDOW names)
+// and sequential (sorted order, which splaying turns into O(1) amortized
+// steps). Nodes_per_op is how far down each lookup had to go before the
+// splay, next to log2(n) for a perfectly balanced tree.
+volatile long sink;
+
+// Fill out[] with count indexes in [0, n): Zipf ranks through a random permutation
+void zipfIndexes(int n, int count, int* out) {
+    double* cdf = (double*)malloc(n * sizeof(double));
+    int* perm = (int*)malloc(n * sizeof(int));
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1.0 / (i + 1);
+        cdf[i] = sum;
+        perm[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = perm[i]; perm[i] = perm[j]; perm[j] = t;
+    }
+    for (int k = 0; k < count; k++) {
+        double u = (double)rand() / ((double)RAND_MAX + 1) * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) lo = mid + 1;
+            else hi = mid;
+        }
+        out[k] = perm[lo];
+    }
+    free(cdf);
+    free(perm);
+}
+
+// Fill out[] with count indexes in [0, n): mostly repeats of a recent index
+void burstyIndexes(int n, int count, int* out) {
+    for (int k = 0; k < count; k++) {
+        if (k > 0 && rand() % 100 < BURST_REPEAT) {
+            int back = k < BURST_WINDOW ? k : BURST_WINDOW;
+            out[k] = out[k - 1 - rand() % back];
+        } else {
+            out[k] = rand() % n;
+        }
+    }
+}
+
+void benchmarkSplayLocalityToCSV(const char* filename) {
+    int sizes[] = {1000, 10000, 100000, 1000000};
+    int ntests = sizeof(sizes)/sizeof(sizes[0]);
+    srand(time(NULL));
+
+    FILE* fp = fopen(filename, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", filename);
+        return;
+    }
+
+    fprintf(fp, "DataStructure,Operation,Contacts,Lookups,Time_ms,Nodes_per_op,Balanced_depth," COUNTER_CSV_COLUMNS "\n");
+
+    for (int t = 0; t < ntests; t++) {
+        int n = sizes[t];
+        freeContacts();
+
+        ContactData* data = (ContactData*)malloc(n * sizeof(ContactData));
+        for (int i = 0; i < n; i++) {
+            data[i] = generateContact();
+            insertContact(data[i].name, data[i].phone, data[i].email);
+        }
+        ContactData* sorted = (ContactData*)malloc(n * sizeof(ContactData));
+        memcpy(sorted, data, n * sizeof(ContactData));
+        qsort(sorted, n, sizeof(ContactData), compareNames);
+
+        int* order[3];
+        for (int r = 0; r < 3; r++) order[r] = (int*)malloc(LOCALITY_LOOKUPS * sizeof(int));
+        for (int k = 0; k < LOCALITY_LOOKUPS; k++) order[0][k] = rand() % n;
+        zipfIndexes(n, LOCALITY_LOOKUPS, order[1]);
+        burstyIndexes(n, LOCALITY_LOOKUPS, order[2]);
+
+        const char* labels[] = {"Splay,UniformSearch", "Splay,ZipfSearch", "Splay,BurstySearch", "Splay,SeqSearch"};
+        for (int r = 0; r < 4; r++) {
+            // The first pass of each pattern reshapes the tree for it; time the second
+            for (int pass = 0; pass < 2; pass++) {
+                splayNodes = 0;
+                clock_t start = startPhase();
+                for (int k = 0; k < LOCALITY_LOOKUPS; k++)
+                    sink += searchContact(r < 3 ? data[order[r][k]].name : sorted[k % n].name) != NULL;
+                clock_t end = stopPhase();
+                if (pass == 0) continue;
+                double ms = ((double)(end-start))/CLOCKS_PER_SEC*1000;
+                double nodes = (double)splayNodes / LOCALITY_LOOKUPS;
+                fprintf(fp, "%s,%d,%d,%.3f,%.2f,%.2f", labels[r], n, LOCALITY_LOOKUPS, ms, nodes, log2(n));
+                writeCounters(fp, LOCALITY_LOOKUPS);
+                fputc('\n', fp);
+                printf("%s %d: %.3f ms, %.2f nodes per lookup (balanced %.1f)\n", labels[r], n, ms, nodes, log2(n));
+            }
+        }
+
+        for (int r = 0; r < 3; r++) free(order[r]);
+        free(data);
+        free(sorted);
+    }
+
+    fclose(fp);
+    printf("Splay locality benchmark written to %s\n", filename);
+}
+
+
+// ----------------- Main Menu -----------------
+int main(int argc,char** argv){
+    int choice; char name[NAME_LEN], phone[PHONE_LEN], email[EMAIL_LEN]; srand(time(NULL));
+    // Non-interactive mode for the benchmark runner: standard benchmark, then exit
+    if(argc>1 && strcmp(argv[1],"--bench")==0){ benchmarkSplayToCSV(argc>2?argv[2]:"performance_splay.csv"); return 0; }
+    while(1){
+        printf("\nContact Management System (Splay Tree)\n1.Insert\n2.Search\n3.Update\n4.Delete\n5.Display\n6.Benchmark\n7.Exit\n8.Locality Benchmark\nEnter choice:");
+        scanf("%d",&choice); getchar();
+        switch(choice){
+            case 1: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    printf("Phone: "); fgets(phone,PHONE_LEN,stdin); phone[strcspn(phone,"\n")]=0;
+                    printf("Email: "); fgets(email,EMAIL_LEN,stdin); email[strcspn(email,"\n")]=0;
+                    insertContact(name,phone,email); break;
+            case 2: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    { Contact* c=searchContact(name); if(c) printf("Found:%s|%s|%s\n",c->name,c->phone,c->email); else printf("Not found\n");} break;
+            case 3: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    printf("Phone: "); fgets(phone,PHONE_LEN,stdin); phone[strcspn(phone,"\n")]=0;
+                    printf("Email: "); fgets(email,EMAIL_LEN,stdin); email[strcspn(email,"\n")]=0;
+                    updateContact(name,phone,email); break;
+            case 4: printf("Name: "); fgets(name,NAME_LEN,stdin); name[strcspn(name,"\n")]=0;
+                    deleteContact(name); break;
+            case 5: if(!root) printf("No contacts.\n"); else displayContacts(); break;
+            case 6: benchmarkSplayToCSV("performance_splay.csv"); freeContacts(); break;
+            case 7: freeContacts(); exit(0);
+            case 8: benchmarkSplayLocalityToCSV("performance_splay_locality.csv"); freeContacts(); break;
+            default: printf("Invalid choice\n");
+        }
+    }
+}
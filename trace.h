@@ -0,0 +1,98 @@
+// Binary operation traces: recorded by the interactive programs (when
+// CONTACT_TRACE names a file) and by workload -r, replayed by replay.c.
+//
+// File: the 8-byte magic "CTRACE1\n", then one record per operation:
+//   u8 op, u8 name length, u8 phone length, u8 email length, u16 arg (little
+//   endian; the scan limit), then the name, phone and email bytes without NULs.
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_MAGIC "CTRACE1\n"
+#define TRACE_FIELD_LEN 64
+#define TRACE_MAX_ARG 65535   // the u16 arg field
+
+enum { TRACE_INSERT = 1, TRACE_SEARCH, TRACE_UPDATE, TRACE_DELETE, TRACE_UPSERT, TRACE_SCAN, TRACE_NUM_OPS };
+
+// ---------------- Recording ----------------
+static FILE* traceOut = NULL;
+static int traceFlushEach = 0;   // interactive sessions: nothing lost if the program is killed
+
+// Append to path, writing the magic if the file is new
+static inline void traceOpen(const char* path) {
+    traceOut = fopen(path, "ab");
+    if (!traceOut) {
+        perror(path);
+        return;
+    }
+    if (ftell(traceOut) == 0) fwrite(TRACE_MAGIC, 1, 8, traceOut);
+}
+
+// Record when the CONTACT_TRACE environment variable names a file
+static inline void traceOpenFromEnv(void) {
+    const char* path = getenv("CONTACT_TRACE");
+    if (path && *path) traceOpen(path);
+    traceFlushEach = 1;
+}
+
+static inline void traceRecord(int op, const char* name, const char* phone, const char* email, int arg) {
+    if (!traceOut) return;
+    size_t n = strlen(name), p = phone ? strlen(phone) : 0, e = email ? strlen(email) : 0;
+    unsigned char head[6] = {(unsigned char)op, (unsigned char)n, (unsigned char)p, (unsigned char)e,
+                             (unsigned char)(arg & 0xff), (unsigned char)(arg >> 8)};
+    fwrite(head, 1, sizeof(head), traceOut);
+    fwrite(name, 1, n, traceOut);
+    if (p) fwrite(phone, 1, p, traceOut);
+    if (e) fwrite(email, 1, e, traceOut);
+    if (traceFlushEach) fflush(traceOut);
+}
+
+static inline void traceClose(void) {
+    if (traceOut) fclose(traceOut);
+    traceOut = NULL;
+}
+
+// ---------------- Reading ----------------
+typedef struct {
+    unsigned char op;
+    unsigned short arg;
+    char name[TRACE_FIELD_LEN];
+    char phone[TRACE_FIELD_LEN];
+    char email[TRACE_FIELD_LEN];
+} TraceOp;
+
+// Whole trace into *ops (caller frees); -1 if the file is missing or not a trace
+static inline long traceLoad(const char* path, TraceOp** ops) {
+    FILE* f = fopen(path, "rb");
+    char magic[8];
+    if (!f) return -1;
+    if (fread(magic, 1, 8, f) != 8 || memcmp(magic, TRACE_MAGIC, 8) != 0) {
+        fclose(f);
+        return -1;
+    }
+    long count = 0, cap = 1024;
+    TraceOp* out = (TraceOp*)malloc(cap * sizeof(TraceOp));
+    unsigned char head[6];
+    while (fread(head, 1, sizeof(head), f) == sizeof(head)) {
+        if (count == cap) out = (TraceOp*)realloc(out, (cap *= 2) * sizeof(TraceOp));
+        TraceOp* t = &out[count];
+        t->op = head[0];
+        t->arg = (unsigned short)(head[4] | head[5] << 8);
+        char* fields[3] = {t->name, t->phone, t->email};
+        int ok = head[0] > 0 && head[0] < TRACE_NUM_OPS;
+        for (int i = 0; i < 3 && ok; i++) {
+            ok = head[1 + i] < TRACE_FIELD_LEN && fread(fields[i], 1, head[1 + i], f) == head[1 + i];
+            if (ok) fields[i][head[1 + i]] = '\0';
+        }
+        if (!ok) break;   // truncated or corrupt tail: keep what was read
+        count++;
+    }
+    fclose(f);
+    *ops = out;
+    return count;
+}
+
+#endif
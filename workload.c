@@ -0,0 +1,427 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "backends.h"
+#include "trace.h"
+
+// YCSB-style mixed workloads against every backend.
+// A load phase inserts the records, then a run phase draws operations from a
+// read/update/insert/delete/scan/read-modify-write mix, with keys chosen
+// uniformly, by a scrambled Zipfian (popular keys spread over the key space)
+// by "latest" (Zipfian over recency, so new inserts are the hot ones) or
+// "bursty" (mostly repeats of the last few keys, temporal locality without a
+// fixed hot set).
+// Every operation is timed on its own so the CSV can report percentiles.
+// With -r the first run (load and run phase) is also recorded as a trace
+// that replay can feed back to any backend.
+
+#define MAX_SCAN_DEFAULT 100
+#define ZIPF_THETA 0.99
+#define BURST_WINDOW 16   // bursty keys repeat one of the last 16 chosen...
+#define BURST_REPEAT 75   // ...this percentage of the time
+
+enum { OP_READ, OP_UPDATE, OP_INSERT, OP_DELETE, OP_SCAN, OP_RMW, NUM_OPS };
+static const char* opNames[NUM_OPS] = {"Read", "Update", "Insert", "Delete", "Scan", "ReadModifyWrite"};
+
+enum { DIST_UNIFORM, DIST_ZIPFIAN, DIST_LATEST, DIST_BURSTY, NUM_DISTS };
+static const char* distNames[NUM_DISTS] = {"uniform", "zipfian", "latest", "bursty"};
+
+typedef struct {
+    const char* name;
+    int mix[NUM_OPS];     // percentages, summing to 100
+    int dist;
+} Workload;
+
+// Standard YCSB core workloads
+static Workload workloads[] = {
+    {"A", {50, 50,  0, 0,  0,  0}, DIST_ZIPFIAN},   // update heavy
+    {"B", {95,  5,  0, 0,  0,  0}, DIST_ZIPFIAN},   // read mostly
+    {"C", {100, 0,  0, 0,  0,  0}, DIST_ZIPFIAN},   // read only
+    {"D", {95,  0,  5, 0,  0,  0}, DIST_LATEST},    // read latest
+    {"E", {0,   0,  5, 0, 95,  0}, DIST_ZIPFIAN},   // short ranges
+    {"F", {50,  0,  0, 0,  0, 50}, DIST_ZIPFIAN},   // read-modify-write
+};
+#define NUM_WORKLOADS ((int)(sizeof(workloads) / sizeof(workloads[0])))
+
+// ---------------- Random Numbers ----------------
+static unsigned long long rngState = 88172645463325252ULL;
+
+static unsigned long long nextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+static double nextDouble(void) { return (nextRandom() >> 11) * (1.0 / 9007199254740992.0); }
+
+static unsigned long long fnv64(unsigned long long v) {
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i = 0; i < 8; i++) {
+        h ^= v & 0xff;
+        h *= 1099511628211ULL;
+        v >>= 8;
+    }
+    return h;
+}
+
+// Key for record i: hashed so insertion order is not key order
+static void buildKey(long long i, char* out) {
+    snprintf(out, NAME_LEN, "user%llu", fnv64((unsigned long long)i));
+}
+
+// ---------------- Zipfian Generator ----------------
+// Gray et al., "Quickly Generating Billion-Record Synthetic Databases", as
+// used by YCSB. zeta(n) is extended incrementally as inserts grow n.
+typedef struct {
+    long long n;
+    double theta, alpha, zeta2, zetan, eta;
+} Zipfian;
+
+static void zipfGrow(Zipfian* z, long long n) {
+    for (long long i = z->n + 1; i <= n; i++) z->zetan += 1.0 / pow((double)i, z->theta);
+    z->n = n;
+    z->eta = (1 - pow(2.0 / n, 1 - z->theta)) / (1 - z->zeta2 / z->zetan);
+}
+
+static void zipfInit(Zipfian* z, long long n, double theta) {
+    z->n = 0;
+    z->theta = theta;
+    z->alpha = 1.0 / (1.0 - theta);
+    z->zeta2 = 1.0 + 1.0 / pow(2.0, theta);
+    z->zetan = 0;
+    zipfGrow(z, n);
+}
+
+// Rank in [0, n), 0 most popular
+static long long zipfNext(Zipfian* z) {
+    double u = nextDouble();
+    double uz = u * z->zetan;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + pow(0.5, z->theta)) return 1;
+    long long r = (long long)(z->n * pow(z->eta * u - z->eta + 1, z->alpha));
+    return r < z->n ? r : z->n - 1;
+}
+
+// ---------------- Key Chooser ----------------
+static long long keyCount;   // records 0..keyCount-1 have been inserted
+static Zipfian zipf;         // recency ranks for latest, grown with keyCount
+static Zipfian scrambled;    // ranks for zipfian, fixed at the records loaded
+static long long burstKeys[BURST_WINDOW];   // ring of the last keys chosen
+static int burstCount;
+
+static long long chooseBursty(void) {
+    long long k;
+    if (burstCount > 0 && (int)(nextRandom() % 100) < BURST_REPEAT) {
+        int window = burstCount < BURST_WINDOW ? burstCount : BURST_WINDOW;
+        return burstKeys[nextRandom() % window];
+    }
+    k = nextRandom() % keyCount;
+    burstKeys[burstCount++ % BURST_WINDOW] = k;
+    return k;
+}
+
+// Scrambled Zipfian as in YCSB: ranks over the item count fixed when the run
+// starts, hashed over that same count so the hot set stays put as inserts
+// raise keyCount. A pick outside the live records is folded back into them.
+static long long chooseScrambled(void) {
+    long long k = (long long)(fnv64(zipfNext(&scrambled)) % (unsigned long long)scrambled.n);
+    return k < keyCount ? k : k % keyCount;
+}
+
+static long long chooseKey(int dist) {
+    switch (dist) {
+        case DIST_ZIPFIAN: return chooseScrambled();
+        case DIST_LATEST:
+            if (keyCount > zipf.n) zipfGrow(&zipf, keyCount);
+            return keyCount - 1 - zipfNext(&zipf);
+        case DIST_BURSTY:  return chooseBursty();
+        default:           return nextRandom() % keyCount;
+    }
+}
+
+// ---------------- Latency Recording ----------------
+typedef struct {
+    unsigned int* ns;
+    long long count, capacity;
+    long long misses;
+} Latencies;
+
+static Latencies lat[NUM_OPS];
+
+static void recordLatency(int op, unsigned int ns) {
+    Latencies* l = &lat[op];
+    if (l->count == l->capacity) {
+        l->capacity = l->capacity ? l->capacity * 2 : 4096;
+        l->ns = (unsigned int*)realloc(l->ns, l->capacity * sizeof(unsigned int));
+    }
+    l->ns[l->count++] = ns;
+}
+
+static int compareUInt(const void* a, const void* b) {
+    unsigned int x = *(const unsigned int*)a, y = *(const unsigned int*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentileUs(unsigned int* sorted, long long count, double p) {
+    long long i = (long long)ceil(p * count) - 1;
+    if (i < 0) i = 0;
+    return sorted[i] / 1000.0;
+}
+
+static long long nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// One CSV row (and a console line) for the latencies in samples. Rows for a
+// single operation type pass elapsedMs = 0: their Time_ms is the summed
+// latency and throughput is left to the "All" row, which has the wall time.
+static void writeRow(FILE* fp, const char* backend, const char* workload, const char* dist,
+                     const char* op, long long records, unsigned int* samples, long long count,
+                     long long misses, double elapsedMs) {
+    if (count == 0) return;   // a -t deadline can pass before the first operation
+    qsort(samples, count, sizeof(unsigned int), compareUInt);
+    double sum = 0;
+    for (long long i = 0; i < count; i++) sum += samples[i];
+    char throughput[32] = "";
+    if (elapsedMs > 0) snprintf(throughput, sizeof(throughput), "%.0f", count / (elapsedMs / 1000.0));
+    else elapsedMs = sum / 1e6;
+    fprintf(fp, "%s,%s,%s,%s,%lld,%lld,%.3f,%s,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%lld\n",
+            backend, workload, dist, op, records, count, elapsedMs, throughput, sum / count / 1000.0,
+            percentileUs(samples, count, 0.50), percentileUs(samples, count, 0.95),
+            percentileUs(samples, count, 0.99), percentileUs(samples, count, 0.999),
+            samples[count - 1] / 1000.0, misses);
+    printf("  %-16s %9lld ops %12s ops/s  p50 %8.3f us  p99 %8.3f us  p99.9 %9.3f us\n",
+           op, count, throughput, percentileUs(samples, count, 0.50),
+           percentileUs(samples, count, 0.99), percentileUs(samples, count, 0.999));
+}
+
+// ---------------- Trace Recording ----------------
+static const char* recordFile = NULL;   // -r: trace of the next run, then cleared
+
+// The run phase only notes each operation here. The trace is written after
+// the run is timed, so recording does not slow the recorded run.
+typedef struct {
+    long long key;          // record index, rebuilt with buildKey
+    int op, scanLen;
+} NotedOp;
+
+static NotedOp* noted = NULL;
+static long long notedCount = 0, notedCap = 0;
+
+static void noteOp(int op, long long key, int scanLen) {
+    if (notedCount == notedCap) {
+        notedCap = notedCap ? notedCap * 2 : 1 << 16;
+        noted = (NotedOp*)realloc(noted, notedCap * sizeof(NotedOp));
+    }
+    noted[notedCount++] = (NotedOp){key, op, scanLen};
+}
+
+static void recordOp(int op, const char* key, int scanLen) {
+    switch (op) {
+        case OP_READ:   traceRecord(TRACE_SEARCH, key, NULL, NULL, 0); break;
+        case OP_UPDATE: traceRecord(TRACE_UPDATE, key, "1234567890", "newemail@test.com", 0); break;
+        case OP_INSERT: traceRecord(TRACE_INSERT, key, "0987654321", "insert@test.com", 0); break;
+        case OP_DELETE: traceRecord(TRACE_DELETE, key, NULL, NULL, 0); break;
+        case OP_SCAN:   traceRecord(TRACE_SCAN, key, NULL, NULL, scanLen); break;
+        case OP_RMW:
+            traceRecord(TRACE_SEARCH, key, NULL, NULL, 0);
+            traceRecord(TRACE_UPDATE, key, "1234567890", "rmw@test.com", 0);
+            break;
+    }
+}
+
+// ---------------- Workload Run ----------------
+// Load records, run ops operations (or seconds of them) and write the rows
+static void runWorkload(FILE* fp, const Backend* b, Workload* w, int dist, long long records,
+                        long long ops, double seconds, int maxScan) {
+    char key[NAME_LEN];
+    char phone[PHONE_LEN], email[EMAIL_LEN];
+    volatile long sink = 0;
+
+    if (w->mix[OP_SCAN] > 0 && b->scan == NULL) {
+        printf("%s, workload %s: skipped, scans need an ordered backend\n", b->name, w->name);
+        return;
+    }
+    printf("%s, workload %s (%s), %lld records\n", b->name, w->name, distNames[dist], records);
+    if (recordFile) {
+        remove(recordFile);   // traceOpen appends; a recording starts a new trace
+        traceOpen(recordFile);
+        recordFile = NULL;
+    }
+
+    // Load phase (timed as a whole)
+    b->init((int)records);
+    long long start = nowNs();
+    for (long long i = 0; i < records; i++) {
+        buildKey(i, key);
+        snprintf(phone, PHONE_LEN, "%010lld", i);
+        snprintf(email, EMAIL_LEN, "%.30s@test.com", key);
+        b->insert(key, phone, email);
+    }
+    double loadMs = (nowNs() - start) / 1e6;
+    for (long long i = 0; traceOut && i < records; i++) {
+        buildKey(i, key);
+        snprintf(phone, PHONE_LEN, "%010lld", i);
+        snprintf(email, EMAIL_LEN, "%.30s@test.com", key);
+        traceRecord(TRACE_INSERT, key, phone, email, 0);
+    }
+    fprintf(fp, "%s,%s,%s,Load,%lld,%lld,%.3f,%.0f,,,,,,,0\n", b->name, w->name, distNames[dist],
+            records, records, loadMs, records / (loadMs / 1000.0));
+    keyCount = records;
+    zipfInit(&zipf, records, ZIPF_THETA);
+    scrambled = zipf;
+    burstCount = 0;
+    for (int op = 0; op < NUM_OPS; op++) lat[op].count = lat[op].misses = 0;
+
+    // Run phase
+    long long deadline = seconds > 0 ? nowNs() + (long long)(seconds * 1e9) : 0;
+    long long done = 0;
+    start = nowNs();
+    while (deadline ? ((done & 1023) != 0 || nowNs() < deadline) : done < ops) {
+        int roll = (int)(nextRandom() % 100), op = 0;
+        while (roll >= w->mix[op]) roll -= w->mix[op++];
+
+        long long keyIndex = op == OP_INSERT ? keyCount : chooseKey(dist);
+        buildKey(keyIndex, key);
+        int scanLen = op == OP_SCAN ? 1 + (int)(nextRandom() % maxScan) : 0;
+
+        long long t0 = nowNs();
+        int hit = 1;
+        switch (op) {
+            case OP_READ:   hit = b->search(key); break;
+            case OP_UPDATE: hit = b->update(key, "1234567890", "newemail@test.com"); break;
+            case OP_INSERT: hit = b->insert(key, "0987654321", "insert@test.com") == 1; break;
+            case OP_DELETE: hit = b->remove(key); break;
+            case OP_SCAN:   sink += b->scan(key, scanLen); break;
+            case OP_RMW:    hit = b->search(key) && b->update(key, "1234567890", "rmw@test.com"); break;
+        }
+        recordLatency(op, (unsigned int)(nowNs() - t0));
+        if (!hit) lat[op].misses++;
+        if (traceOut) noteOp(op, keyIndex, scanLen);
+        if (op == OP_INSERT) keyCount++;
+        done++;
+    }
+    double runMs = (nowNs() - start) / 1e6;
+    for (long long i = 0; i < notedCount; i++) {
+        buildKey(noted[i].key, key);
+        recordOp(noted[i].op, key, noted[i].scanLen);
+    }
+    free(noted);
+    noted = NULL;
+    notedCount = notedCap = 0;
+    traceClose();
+
+    // Per-operation rows, then all operations together
+    long long total = 0, misses = 0;
+    for (int op = 0; op < NUM_OPS; op++) total += lat[op].count;
+    unsigned int* all = (unsigned int*)malloc(total * sizeof(unsigned int));
+    long long k = 0;
+    for (int op = 0; op < NUM_OPS; op++) {
+        if (lat[op].count == 0) continue;
+        memcpy(all + k, lat[op].ns, lat[op].count * sizeof(unsigned int));
+        k += lat[op].count;
+        misses += lat[op].misses;
+        writeRow(fp, b->name, w->name, distNames[dist], opNames[op], records, lat[op].ns,
+                 lat[op].count, lat[op].misses, 0);
+    }
+    writeRow(fp, b->name, w->name, distNames[dist], "All", records, all, total, misses, runMs);
+    free(all);
+    b->destroy();
+}
+
+static void usage(const char* prog) {
+    printf("Usage: %s [options]\n", prog);
+    printf("  -b NAME     backend: Array, LinkedList, HashMap, BST, AVL, SkipList, Splay, Cuckoo, Adaptive or all (default all)\n");
+    printf("  -w LIST     YCSB workloads to run, e.g. ABF (default ABCDEF)\n");
+    printf("  -m R,U,I,D,S,M  custom mix in percent: read,update,insert,delete,scan,read-modify-write\n");
+    printf("  -k DIST     key chooser: uniform, zipfian, latest or bursty (default: per workload)\n");
+    printf("  -n N        records loaded before the run (default 10000)\n");
+    printf("  -o N        operations per run (default 100000)\n");
+    printf("  -t SECONDS  run for a fixed duration instead of -o\n");
+    printf("  -l N        maximum scan length (default %d)\n", MAX_SCAN_DEFAULT);
+    printf("  -f FILE     output CSV (default performance_workload.csv)\n");
+    printf("  -r FILE     record the first run as an operation trace for replay\n");
+}
+
+int main(int argc, char** argv) {
+    const char* backendName = "all";
+    const char* workloadList = "ABCDEF";
+    const char* csvFile = "performance_workload.csv";
+    long long records = 10000, ops = 100000;
+    double seconds = 0;
+    int maxScan = MAX_SCAN_DEFAULT, dist = -1;
+    Workload custom = {"Custom", {0}, DIST_ZIPFIAN};
+    int useCustom = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:w:m:k:n:o:t:l:f:r:h")) != -1) {
+        switch (opt) {
+            case 'b': backendName = optarg; break;
+            case 'w': workloadList = optarg; break;
+            case 'm': {
+                int* m = custom.mix;
+                if (sscanf(optarg, "%d,%d,%d,%d,%d,%d", &m[0], &m[1], &m[2], &m[3], &m[4], &m[5]) != 6 ||
+                    m[0] + m[1] + m[2] + m[3] + m[4] + m[5] != 100) {
+                    printf("The mix needs six percentages summing to 100\n");
+                    return 1;
+                }
+                useCustom = 1;
+                break;
+            }
+            case 'k':
+                for (dist = NUM_DISTS - 1; dist >= 0 && strcmp(optarg, distNames[dist]) != 0; dist--);
+                if (dist < 0) { printf("Unknown key chooser %s\n", optarg); return 1; }
+                break;
+            case 'n': records = atoll(optarg); break;
+            case 'o': ops = atoll(optarg); break;
+            case 't': seconds = atof(optarg); break;
+            case 'l': maxScan = atoi(optarg); break;
+            case 'f': csvFile = optarg; break;
+            case 'r': recordFile = optarg; break;
+            default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (records < 1 || ops < 1 || seconds < 0 || maxScan < 1) { usage(argv[0]); return 1; }
+    if (recordFile && maxScan > TRACE_MAX_ARG) {
+        printf("-l above %d cannot be recorded: a trace stores the scan limit in 16 bits\n", TRACE_MAX_ARG);
+        return 1;
+    }
+
+    const Backend* only = NULL;
+    if (strcmp(backendName, "all") != 0 && (only = findBackend(backendName)) == NULL) {
+        printf("Unknown backend %s\n", backendName);
+        return 1;
+    }
+
+    FILE* fp = fopen(csvFile, "w");
+    if (!fp) {
+        printf("Cannot open file %s\n", csvFile);
+        return 1;
+    }
+    fprintf(fp, "DataStructure,Workload,Distribution,Operation,Records,Ops,Time_ms,Throughput_ops_s,"
+                "Avg_us,P50_us,P95_us,P99_us,P999_us,Max_us,Misses\n");
+
+    for (int i = 0; i < NUM_BACKENDS; i++) {
+        if (only && only != &backends[i]) continue;
+        if (useCustom) {
+            runWorkload(fp, &backends[i], &custom, dist >= 0 ? dist : custom.dist, records, ops, seconds, maxScan);
+            continue;
+        }
+        for (int w = 0; w < NUM_WORKLOADS; w++) {
+            if (strchr(workloadList, workloads[w].name[0]) == NULL) continue;
+            runWorkload(fp, &backends[i], &workloads[w], dist >= 0 ? dist : workloads[w].dist,
+                        records, ops, seconds, maxScan);
+        }
+    }
+
+    fclose(fp);
+    for (int op = 0; op < NUM_OPS; op++) free(lat[op].ns);
+    printf("Workload results written to %s\n", csvFile);
+    return 0;
+}